@@ -764,6 +764,223 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+// Tessellation kernels shared by AddPolyline() and AddConvexPolyFilled().
+// - With SSE (x86/x64) or NEON (ARM64), two points are processed at once: a 128-bit register holds two interleaved ImVec2 (x0,y0,x1,y1).
+// - The SIMD code performs the same operations in the same order as the scalar code: _mm_rsqrt_ps() matches ImRsqrt(), and the NEON
+//   path uses a full sqrt+div like the non-SSE ImRsqrt(), so the generated vertices don't depend on which path is taken.
+// - Indices of consecutive segments only differ by a constant: with SSE2/NEON and the default 16-bit ImDrawIdx they are written 8 at a time.
+// - The SIMD path is skipped when ImDrawListSharedData::TessellationNoSimd is set (to compare both paths) or when ImDrawVert has a custom layout.
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#define IMGUI_ENABLE_SIMD_TESSELLATION
+typedef __m128 ImTessVec;
+static inline ImTessVec ImTessLoad2(const ImVec2* p)                        { return _mm_loadu_ps(&p->x); }
+static inline void      ImTessStore2(ImVec2* p, ImTessVec v)                { _mm_storeu_ps(&p->x, v); }
+static inline ImTessVec ImTessSet1(float v)                                 { return _mm_set1_ps(v); }
+static inline ImTessVec ImTessSet2(const ImVec2& v)                         { return _mm_setr_ps(v.x, v.y, v.x, v.y); }
+static inline ImTessVec ImTessAdd(ImTessVec a, ImTessVec b)                 { return _mm_add_ps(a, b); }
+static inline ImTessVec ImTessSub(ImTessVec a, ImTessVec b)                 { return _mm_sub_ps(a, b); }
+static inline ImTessVec ImTessMul(ImTessVec a, ImTessVec b)                 { return _mm_mul_ps(a, b); }
+static inline ImTessVec ImTessDiv(ImTessVec a, ImTessVec b)                 { return _mm_div_ps(a, b); }
+static inline ImTessVec ImTessMin(ImTessVec a, ImTessVec b)                 { return _mm_min_ps(a, b); }
+static inline ImTessVec ImTessRsqrt(ImTessVec v)                            { return _mm_rsqrt_ps(v); }
+static inline ImTessVec ImTessSelectGt(ImTessVec a, ImTessVec b, ImTessVec if_true, ImTessVec if_false) { ImTessVec m = _mm_cmpgt_ps(a, b); return _mm_or_ps(_mm_and_ps(m, if_true), _mm_andnot_ps(m, if_false)); }
+static inline ImTessVec ImTessSwapXY(ImTessVec v)                           { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+static inline ImTessVec ImTessNegY(ImTessVec v)                             { return _mm_xor_ps(v, _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f)); }
+static inline void      ImTessWriteVtx0(ImDrawVert* vtx, ImTessVec pos, ImTessVec uv, ImU32 col) { _mm_storeu_ps(&vtx->pos.x, _mm_movelh_ps(pos, uv)); vtx->col = col; }
+static inline void      ImTessWriteVtx1(ImDrawVert* vtx, ImTessVec pos, ImTessVec uv, ImU32 col) { _mm_storeu_ps(&vtx->pos.x, _mm_movehl_ps(uv, pos)); vtx->col = col; }
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))) && !defined(ImDrawIdx)
+#define IMGUI_ENABLE_SIMD_TESSELLATION_INDICES
+typedef __m128i ImTessIdxVec;   // 8 x 16-bit indices
+static inline ImTessIdxVec ImTessIdxLoad8(const ImDrawIdx* p)               { return _mm_loadu_si128((const __m128i*)(const void*)p); }
+static inline ImTessIdxVec ImTessIdxSet1(ImDrawIdx v)                       { return _mm_set1_epi16((short)v); }
+static inline ImTessIdxVec ImTessIdxAdd(ImTessIdxVec a, ImTessIdxVec b)     { return _mm_add_epi16(a, b); }
+static inline void         ImTessIdxStore8(ImDrawIdx* p, ImTessIdxVec v)    { _mm_storeu_si128((__m128i*)(void*)p, v); }
+static inline void         ImTessIdxStore4(ImDrawIdx* p, ImTessIdxVec v)    { _mm_storel_epi64((__m128i*)(void*)p, v); }
+static inline void         ImTessIdxStore2(ImDrawIdx* p, ImTessIdxVec v, int high) { int bits = high ? _mm_cvtsi128_si32(_mm_srli_si128(v, 8)) : _mm_cvtsi128_si32(v); memcpy(p, &bits, 4); }
+#endif
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && !defined(IMGUI_DISABLE_NEON) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#define IMGUI_ENABLE_SIMD_TESSELLATION
+#include <arm_neon.h>
+typedef float32x4_t ImTessVec;
+static inline ImTessVec ImTessLoad2(const ImVec2* p)                        { return vld1q_f32(&p->x); }
+static inline void      ImTessStore2(ImVec2* p, ImTessVec v)                { vst1q_f32(&p->x, v); }
+static inline ImTessVec ImTessSet1(float v)                                 { return vdupq_n_f32(v); }
+static inline ImTessVec ImTessSet2(const ImVec2& v)                         { float32x2_t xy = vld1_f32(&v.x); return vcombine_f32(xy, xy); }
+static inline ImTessVec ImTessAdd(ImTessVec a, ImTessVec b)                 { return vaddq_f32(a, b); }
+static inline ImTessVec ImTessSub(ImTessVec a, ImTessVec b)                 { return vsubq_f32(a, b); }
+static inline ImTessVec ImTessMul(ImTessVec a, ImTessVec b)                 { return vmulq_f32(a, b); }
+static inline ImTessVec ImTessDiv(ImTessVec a, ImTessVec b)                 { return vdivq_f32(a, b); }
+static inline ImTessVec ImTessMin(ImTessVec a, ImTessVec b)                 { return vminq_f32(a, b); }
+static inline ImTessVec ImTessRsqrt(ImTessVec v)                            { return vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(v)); }
+static inline ImTessVec ImTessSelectGt(ImTessVec a, ImTessVec b, ImTessVec if_true, ImTessVec if_false) { return vbslq_f32(vcgtq_f32(a, b), if_true, if_false); }
+static inline ImTessVec ImTessSwapXY(ImTessVec v)                           { return vrev64q_f32(v); }
+static inline ImTessVec ImTessNegY(ImTessVec v)                             { static const uint32_t sign_y[4] = { 0, 0x80000000u, 0, 0x80000000u }; return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), vld1q_u32(sign_y))); }
+static inline void      ImTessWriteVtx0(ImDrawVert* vtx, ImTessVec pos, ImTessVec uv, ImU32 col) { vst1q_f32(&vtx->pos.x, vcombine_f32(vget_low_f32(pos), vget_low_f32(uv))); vtx->col = col; }
+static inline void      ImTessWriteVtx1(ImDrawVert* vtx, ImTessVec pos, ImTessVec uv, ImU32 col) { vst1q_f32(&vtx->pos.x, vcombine_f32(vget_high_f32(pos), vget_low_f32(uv))); vtx->col = col; }
+#ifndef ImDrawIdx
+#define IMGUI_ENABLE_SIMD_TESSELLATION_INDICES
+typedef uint16x8_t ImTessIdxVec;   // 8 x 16-bit indices
+static inline ImTessIdxVec ImTessIdxLoad8(const ImDrawIdx* p)               { return vld1q_u16(p); }
+static inline ImTessIdxVec ImTessIdxSet1(ImDrawIdx v)                       { return vdupq_n_u16(v); }
+static inline ImTessIdxVec ImTessIdxAdd(ImTessIdxVec a, ImTessIdxVec b)     { return vaddq_u16(a, b); }
+static inline void         ImTessIdxStore8(ImDrawIdx* p, ImTessIdxVec v)    { vst1q_u16(p, v); }
+static inline void         ImTessIdxStore4(ImDrawIdx* p, ImTessIdxVec v)    { vst1_u16(p, vget_low_u16(v)); }
+static inline void         ImTessIdxStore2(ImDrawIdx* p, ImTessIdxVec v, int high) { uint32_t bits = vget_lane_u32(vreinterpret_u32_u16(high ? vget_high_u16(v) : vget_low_u16(v)), 0); memcpy(p, &bits, 4); }
+#endif
+#endif
+
+// Normals of segments [i, i+1] for i in [0, count). The last segment wraps to point 0 when count == points_count (closed shape).
+static void ImDrawList_TessSegmentNormals(const ImVec2* points, const int points_count, const int count, ImVec2* out_normals, bool use_simd)
+{
+    int i1 = 0;
+#ifdef IMGUI_ENABLE_SIMD_TESSELLATION
+    if (use_simd)
+    {
+        const ImTessVec zero = ImTessSet1(0.0f);
+        for (; i1 + 2 <= count && i1 + 2 < points_count; i1 += 2)
+        {
+            ImTessVec d = ImTessSub(ImTessLoad2(&points[i1 + 1]), ImTessLoad2(&points[i1]));
+            ImTessVec sq = ImTessMul(d, d);
+            ImTessVec d2 = ImTessAdd(sq, ImTessSwapXY(sq));
+            d = ImTessSelectGt(d2, zero, ImTessMul(d, ImTessRsqrt(d2)), d); // IM_NORMALIZE2F_OVER_ZERO()
+            ImTessStore2(&out_normals[i1], ImTessNegY(ImTessSwapXY(d)));   // (dy, -dx)
+        }
+    }
+#else
+    IM_UNUSED(use_simd);
+#endif
+    for (; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        out_normals[i1].x = dy;
+        out_normals[i1].y = -dx;
+    }
+}
+
+// Write the indices of segments [i, i+1] for i in [0, count). 'offsets' holds IDX_PER_SEGMENT offsets relative to the first vertex of point i,
+// where values >= vtx_per_point refer to the vertices of point i+1. The last segment wraps to point 0 when count == points_count (closed shape).
+template<int IDX_PER_SEGMENT>
+static void ImDrawList_TessWriteSegmentIndices(ImDrawIdx* idx_write, unsigned int vtx_base, const int points_count, const int count, const int vtx_per_point, const unsigned int* offsets, bool use_simd)
+{
+    const int straight_count = (count == points_count) ? count - 1 : count;
+    unsigned int idx1 = vtx_base;
+    int i1 = 0;
+#ifdef IMGUI_ENABLE_SIMD_TESSELLATION_INDICES
+    if (use_simd)
+    {
+        // Indices of consecutive segments only differ by vtx_per_point: keep them in registers and add vtx_per_point for each segment
+        ImTessIdxVec v_idx[(IDX_PER_SEGMENT + 7) / 8];
+        ImDrawIdx tmp[((IDX_PER_SEGMENT + 7) / 8) * 8] = {};
+        for (int n = 0; n < IDX_PER_SEGMENT; n++)
+            tmp[n] = (ImDrawIdx)(idx1 + offsets[n]);
+        for (int v = 0; v < (IDX_PER_SEGMENT + 7) / 8; v++)
+            v_idx[v] = ImTessIdxLoad8(&tmp[v * 8]);
+        const ImTessIdxVec v_step = ImTessIdxSet1((ImDrawIdx)vtx_per_point);
+        for (; i1 < straight_count; i1++, idx1 += vtx_per_point, idx_write += IDX_PER_SEGMENT)
+        {
+            for (int v = 0; v < IDX_PER_SEGMENT / 8; v++)
+            {
+                ImTessIdxStore8(&idx_write[v * 8], v_idx[v]);
+                v_idx[v] = ImTessIdxAdd(v_idx[v], v_step);
+            }
+            if (IDX_PER_SEGMENT % 8 >= 4)
+                ImTessIdxStore4(&idx_write[(IDX_PER_SEGMENT / 8) * 8], v_idx[IDX_PER_SEGMENT / 8]);
+            if (IDX_PER_SEGMENT % 4 == 2)
+                ImTessIdxStore2(&idx_write[IDX_PER_SEGMENT - 2], v_idx[IDX_PER_SEGMENT / 8], (IDX_PER_SEGMENT % 8) / 4);
+            if (IDX_PER_SEGMENT % 8 != 0)
+                v_idx[IDX_PER_SEGMENT / 8] = ImTessIdxAdd(v_idx[IDX_PER_SEGMENT / 8], v_step);
+        }
+    }
+#else
+    IM_UNUSED(use_simd);
+#endif
+    for (; i1 < straight_count; i1++, idx1 += vtx_per_point, idx_write += IDX_PER_SEGMENT)
+        for (int n = 0; n < IDX_PER_SEGMENT; n++)
+            idx_write[n] = (ImDrawIdx)(idx1 + offsets[n]);
+    if (straight_count < count)
+        for (int n = 0; n < IDX_PER_SEGMENT; n++)
+            idx_write[n] = (ImDrawIdx)((int)offsets[n] < vtx_per_point ? idx1 + offsets[n] : vtx_base + offsets[n] - vtx_per_point);
+}
+
+// Write VTX_PER_POINT vertices for one point, each offset along (dm_x, dm_y) by its scale. A scale of 0.0f writes the point itself.
+template<int VTX_PER_POINT>
+static inline void ImDrawList_TessWritePoint(ImDrawVert* vtx, const ImVec2& p, float dm_x, float dm_y, const float* scales, const ImVec2* uvs, const ImU32* cols)
+{
+    for (int n = 0; n < VTX_PER_POINT; n++)
+    {
+        if (scales[n] == 0.0f)
+            vtx[n].pos = p;
+        else
+            { vtx[n].pos.x = p.x + dm_x * scales[n]; vtx[n].pos.y = p.y + dm_y * scales[n]; }
+        vtx[n].uv = uvs[n];
+        vtx[n].col = cols[n];
+    }
+}
+
+// Write the vertices of points [i_begin, i_end) (i_begin >= 1), each point being offset along the average of the normals of its two segments.
+template<int VTX_PER_POINT>
+static void ImDrawList_TessWritePoints(ImDrawVert* vtx, const ImVec2* points, const ImVec2* normals, int i_begin, const int i_end, const float* scales, const ImVec2* uvs, const ImU32* cols, bool use_simd)
+{
+    IM_ASSERT(i_begin >= 1);
+    int i = i_begin;
+#ifdef IMGUI_ENABLE_SIMD_TESSELLATION
+    if (use_simd)
+    {
+        const ImTessVec half = ImTessSet1(0.5f), one = ImTessSet1(1.0f), min_d2 = ImTessSet1(0.000001f), max_inv_len2 = ImTessSet1(IM_FIXNORMAL2F_MAX_INVLEN2);
+        ImTessVec v_scales[VTX_PER_POINT], v_uvs[VTX_PER_POINT];
+        for (int n = 0; n < VTX_PER_POINT; n++)
+        {
+            v_scales[n] = ImTessSet1(scales[n]);
+            v_uvs[n] = ImTessSet2(uvs[n]);
+        }
+        for (; i + 2 <= i_end; i += 2, vtx += VTX_PER_POINT * 2)
+        {
+            // Average normals, then IM_FIXNORMAL2F()
+            ImTessVec dm = ImTessMul(ImTessAdd(ImTessLoad2(&normals[i - 1]), ImTessLoad2(&normals[i])), half);
+            ImTessVec sq = ImTessMul(dm, dm);
+            ImTessVec d2 = ImTessAdd(sq, ImTessSwapXY(sq));
+            dm = ImTessSelectGt(d2, min_d2, ImTessMul(dm, ImTessMin(ImTessDiv(one, d2), max_inv_len2)), dm);
+
+            const ImTessVec p = ImTessLoad2(&points[i]);
+            for (int n = 0; n < VTX_PER_POINT; n++)
+            {
+                ImTessVec pos = (scales[n] == 0.0f) ? p : ImTessAdd(p, ImTessMul(dm, v_scales[n]));
+                ImTessWriteVtx0(&vtx[n], pos, v_uvs[n], cols[n]);
+                ImTessWriteVtx1(&vtx[VTX_PER_POINT + n], pos, v_uvs[n], cols[n]);
+            }
+        }
+    }
+#else
+    IM_UNUSED(use_simd);
+#endif
+    for (; i < i_end; i++, vtx += VTX_PER_POINT)
+    {
+        float dm_x = (normals[i - 1].x + normals[i].x) * 0.5f;
+        float dm_y = (normals[i - 1].y + normals[i].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        ImDrawList_TessWritePoint<VTX_PER_POINT>(vtx, points[i], dm_x, dm_y, scales, uvs, cols);
+    }
+}
+
+// Write the vertices of all points. Point 0 uses the average of the last and first normals when closed, or the first normal as-is otherwise.
+template<int VTX_PER_POINT>
+static void ImDrawList_TessWriteAllPoints(ImDrawVert* vtx, const ImVec2* points, const ImVec2* normals, const int points_count, bool closed, const float* scales, const ImVec2* uvs, const ImU32* cols, bool use_simd)
+{
+    float dm_x = normals[0].x;
+    float dm_y = normals[0].y;
+    if (closed)
+    {
+        dm_x = (normals[points_count - 1].x + normals[0].x) * 0.5f;
+        dm_y = (normals[points_count - 1].y + normals[0].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+    }
+    ImDrawList_TessWritePoint<VTX_PER_POINT>(vtx, points[0], dm_x, dm_y, scales, uvs, cols);
+    ImDrawList_TessWritePoints<VTX_PER_POINT>(vtx + VTX_PER_POINT, points, normals, 1, points_count, scales, uvs, cols, use_simd);
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
@@ -799,22 +1016,13 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         const int vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
         PrimReserve(idx_count, vtx_count);
 
-        // Temporary buffer
-        // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
-        _Data->TempBuffer.reserve_discard(points_count * ((use_texture || !thick_line) ? 3 : 5));
+        // Temporary buffer: normals at each line point
+        const bool use_simd = !_Data->TessellationNoSimd;
+        _Data->TempBuffer.reserve_discard(points_count);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        ImVec2* temp_points = temp_normals + points_count;
 
         // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
-        }
+        ImDrawList_TessSegmentNormals(points, points_count, count, temp_normals, use_simd);
         if (!closed)
             temp_normals[points_count - 1] = temp_normals[points_count - 2];
 
@@ -831,59 +1039,24 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             //   allow scaling geometry while preserving one-screen-pixel AA fringe).
             const float half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : AA_SIZE;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
+            // Generate the indices to form a number of triangles for each line segment
+            // This takes points n and n+1, with the first point in a closed line being used as the end of the final segment (as n+1 wraps)
+            if (use_texture)
             {
-                temp_points[0] = points[0] + temp_normals[0] * half_draw_size;
-                temp_points[1] = points[0] - temp_normals[0] * half_draw_size;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * half_draw_size;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
+                // Add indices for two triangles: vertices 0-1 are the edges of point n, 2-3 the edges of point n+1
+                static const unsigned int offsets[6] = { 2, 0, 1,  3, 1, 2 }; // Right tri, left tri
+                ImDrawList_TessWriteSegmentIndices<6>(_IdxWritePtr, _VtxCurrentIdx, points_count, count, 2, offsets, use_simd);
+                _IdxWritePtr += count * 6;
             }
-
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            else
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
-                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
-
-                // Add temporary vertexes for the outer edges
-                ImVec2* out_vtx = &temp_points[i2 * 2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
-
-                if (use_texture)
-                {
-                    // Add indices for two triangles
-                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 1); // Right tri
-                    _IdxWritePtr[3] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[4] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Left tri
-                    _IdxWritePtr += 6;
-                }
-                else
-                {
-                    // Add indexes for four triangles
-                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 2); // Right tri 1
-                    _IdxWritePtr[3] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Right tri 2
-                    _IdxWritePtr[6] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8] = (ImDrawIdx)(idx1 + 0); // Left tri 1
-                    _IdxWritePtr[9] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1); // Left tri 2
-                    _IdxWritePtr += 12;
-                }
-
-                idx1 = idx2;
+                // Add indexes for four triangles: vertices 0-2 are the center/left/right of point n, 3-5 those of point n+1
+                static const unsigned int offsets[12] = { 3, 0, 2,  2, 5, 3,  4, 1, 0,  0, 3, 4 }; // Right tri 1, right tri 2, left tri 1, left tri 2
+                ImDrawList_TessWriteSegmentIndices<12>(_IdxWritePtr, _VtxCurrentIdx, points_count, count, 3, offsets, use_simd);
+                _IdxWritePtr += count * 12;
             }
 
-            // Add vertexes for each point on the line
+            // Add vertexes for each point on the line, offset to the outer edges of the AA area
             if (use_texture)
             {
                 // If we're using textures we only need to emit the left/right edge vertices
@@ -896,25 +1069,20 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                     tex_uvs.z = tex_uvs.z + (tex_uvs_1.z - tex_uvs.z) * fractional_thickness;
                     tex_uvs.w = tex_uvs.w + (tex_uvs_1.w - tex_uvs.w) * fractional_thickness;
                 }*/
-                ImVec2 tex_uv0(tex_uvs.x, tex_uvs.y);
-                ImVec2 tex_uv1(tex_uvs.z, tex_uvs.w);
-                for (int i = 0; i < points_count; i++)
-                {
-                    _VtxWritePtr[0].pos = temp_points[i * 2 + 0]; _VtxWritePtr[0].uv = tex_uv0; _VtxWritePtr[0].col = col; // Left-side outer edge
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 1]; _VtxWritePtr[1].uv = tex_uv1; _VtxWritePtr[1].col = col; // Right-side outer edge
-                    _VtxWritePtr += 2;
-                }
+                const float scales[2] = { half_draw_size, -half_draw_size };                                // Left-side, right-side outer edge
+                const ImVec2 uvs[2] = { ImVec2(tex_uvs.x, tex_uvs.y), ImVec2(tex_uvs.z, tex_uvs.w) };
+                const ImU32 cols[2] = { col, col };
+                ImDrawList_TessWriteAllPoints<2>(_VtxWritePtr, points, temp_normals, points_count, closed, scales, uvs, cols, use_simd);
+                _VtxWritePtr += points_count * 2;
             }
             else
             {
                 // If we're not using a texture, we need the center vertex as well
-                for (int i = 0; i < points_count; i++)
-                {
-                    _VtxWritePtr[0].pos = points[i];              _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;       // Center of line
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 0]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col_trans; // Left-side outer edge
-                    _VtxWritePtr[2].pos = temp_points[i * 2 + 1]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col_trans; // Right-side outer edge
-                    _VtxWritePtr += 3;
-                }
+                const float scales[3] = { 0.0f, half_draw_size, -half_draw_size };                          // Center of line, left-side, right-side outer edge
+                const ImVec2 uvs[3] = { opaque_uv, opaque_uv, opaque_uv };
+                const ImU32 cols[3] = { col, col_trans, col_trans };
+                ImDrawList_TessWriteAllPoints<3>(_VtxWritePtr, points, temp_normals, points_count, closed, scales, uvs, cols, use_simd);
+                _VtxWritePtr += points_count * 3;
             }
         }
         else
@@ -922,70 +1090,18 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // [PATH 2] Non texture-based lines (thick): we need to draw the solid line core and thus require four vertices per point
             const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
-            {
-                const int points_last = points_count - 1;
-                temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
-                temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
-                temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 0] = points[points_last] + temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 1] = points[points_last] + temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 2] = points[points_last] - temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-            }
-
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
-            {
-                const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
-                const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertices
-                ImVec2* out_vtx = &temp_points[i2 * 4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
-
-                // Add indexes
-                _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
-                _IdxWritePtr[3]  = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2 + 1);
-                _IdxWritePtr[6]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1 + 0);
-                _IdxWritePtr[9]  = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1);
-                _IdxWritePtr[12] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[13] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[14] = (ImDrawIdx)(idx1 + 3);
-                _IdxWritePtr[15] = (ImDrawIdx)(idx1 + 3); _IdxWritePtr[16] = (ImDrawIdx)(idx2 + 3); _IdxWritePtr[17] = (ImDrawIdx)(idx2 + 2);
-                _IdxWritePtr += 18;
-
-                idx1 = idx2;
-            }
-
-            // Add vertices
-            for (int i = 0; i < points_count; i++)
-            {
-                _VtxWritePtr[0].pos = temp_points[i * 4 + 0]; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col_trans;
-                _VtxWritePtr[1].pos = temp_points[i * 4 + 1]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-                _VtxWritePtr[2].pos = temp_points[i * 4 + 2]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-                _VtxWritePtr[3].pos = temp_points[i * 4 + 3]; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col_trans;
-                _VtxWritePtr += 4;
-            }
+            // Generate the indices to form a number of triangles for each line segment: vertices 0-3 are the edges of point n, 4-7 those of point n+1
+            // This takes points n and n+1, with the first point in a closed line being used as the end of the final segment (as n+1 wraps)
+            static const unsigned int offsets[18] = { 5, 1, 2,  2, 6, 5,  5, 1, 0,  0, 4, 5,  6, 2, 3,  3, 7, 6 };
+            ImDrawList_TessWriteSegmentIndices<18>(_IdxWritePtr, _VtxCurrentIdx, points_count, count, 4, offsets, use_simd);
+            _IdxWritePtr += count * 18;
+
+            // Add vertices: outer and inner edges on both sides
+            const float scales[4] = { half_inner_thickness + AA_SIZE, half_inner_thickness, -half_inner_thickness, -(half_inner_thickness + AA_SIZE) };
+            const ImVec2 uvs[4] = { opaque_uv, opaque_uv, opaque_uv, opaque_uv };
+            const ImU32 cols[4] = { col_trans, col, col, col_trans };
+            ImDrawList_TessWriteAllPoints<4>(_VtxWritePtr, points, temp_normals, points_count, closed, scales, uvs, cols, use_simd);
+            _VtxWritePtr += points_count * 4;
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
@@ -1050,40 +1166,26 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         }
 
         // Compute normals
+        const bool use_simd = !_Data->TessellationNoSimd;
         _Data->TempBuffer.reserve_discard(points_count);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
-
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
-
-            // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
-            _VtxWritePtr += 2;
-
-            // Add indexes for fringes
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
-            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
-            _IdxWritePtr += 6;
-        }
+        ImDrawList_TessSegmentNormals(points, points_count, points_count, temp_normals, use_simd);
+
+        // Add vertices, offset inward and outward by half the AA size along the average of the normals
+        const float scales[2] = { -(AA_SIZE * 0.5f), AA_SIZE * 0.5f };  // Inner, outer
+        const ImVec2 uvs[2] = { uv, uv };
+        const ImU32 cols[2] = { col, col_trans };
+        ImDrawList_TessWriteAllPoints<2>(_VtxWritePtr, points, temp_normals, points_count, true, scales, uvs, cols, use_simd);
+        _VtxWritePtr += vtx_count;
+
+        // Add indexes for fringes, starting with the edge from the last point to the first one
+        const int i0 = points_count - 1;
+        _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
+        _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx);
+        _IdxWritePtr += 6;
+        static const unsigned int offsets[6] = { 2, 0, 1,  1, 3, 2 }; // Vertices 0-1 are the inner/outer vertices of point n, 2-3 those of point n+1
+        ImDrawList_TessWriteSegmentIndices<6>(_IdxWritePtr, vtx_inner_idx, points_count, points_count - 1, 2, offsets, use_simd);
+        _IdxWritePtr += (points_count - 1) * 6;
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
     else
@@ -0,0 +1,725 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer
+// This needs no GPU and no window: draw data is rasterized into an RGBA framebuffer in memory,
+// e.g. to render on headless servers, take screenshots, or measure frame times without a GPU.
+// It can be used with any Platform Backend, or with no Platform Backend at all (set io.DisplaySize and io.DeltaTime yourself).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftRaster_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
+//  [X] Renderer: Multi-threaded rasterization: triangles are binned into screen tiles, tiles are rasterized in parallel.
+// Missing features:
+//  [ ] Renderer: Multi-viewport support (multiple windows).
+//  [ ] Renderer: Bilinear filtering. Textures are point sampled, which is exact for the font atlas since glyphs are pixel aligned.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+// How it works:
+// - RenderDrawData() first sets up every triangle of every draw command (in submission order) on the calling thread:
+//   vertices are snapped to 1/256th of a pixel, edge functions are computed in 64-bit integers, attributes get a plane equation,
+//   and the triangle is clipped against its clip rectangle. Triangles with a single color and UV (which is what most widgets
+//   are made of) are shaded once here.
+// - Triangles are then binned into 64x64 pixel tiles, keeping submission order inside each bin.
+// - Tiles are independent, so they are handed out to the worker threads. Each tile is cleared and then rasterized row by row:
+//   the covered span of a row is solved from the three edge functions (top-left fill rule, so shared edges are drawn once),
+//   shaded, and blended with SIMD (SSE2 when available) using the same blend equation as the other backends:
+//   RGB = src.rgb * src.a + dst.rgb * (1 - src.a), A = src.a + dst.a * (1 - src.a).
+// - User callbacks are called during setup, in order, before anything is rasterized.
+
+// CHANGELOG
+//  2026-10-17: Initial version.
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_softraster.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMGUI_IMPL_SOFTRASTER_SSE2
+#include <emmintrin.h>
+#endif
+
+#define SOFTRASTER_TILE_SHIFT   6
+#define SOFTRASTER_TILE_SIZE    (1 << SOFTRASTER_TILE_SHIFT)
+
+enum ImGui_ImplSoftRaster_Shading
+{
+    ImGui_ImplSoftRaster_Shading_Flat,              // Single color (vertex color * texel), computed at setup
+    ImGui_ImplSoftRaster_Shading_Textured,          // Single vertex color, interpolated UV
+    ImGui_ImplSoftRaster_Shading_Gouraud,           // Interpolated vertex color, single texel
+    ImGui_ImplSoftRaster_Shading_GouraudTextured,   // Interpolated vertex color and UV
+};
+
+// A triangle ready to be rasterized. Edge function e is >= 0 inside the triangle, evaluated at the center of pixel (x,y) as E0 + StepX*x + StepY*y.
+// Attribute planes give the value at the center of pixel (x,y) as P[0] + P[1]*x + P[2]*y.
+struct ImGui_ImplSoftRaster_Triangle
+{
+    int                                     MinX, MinY, MaxX, MaxY;     // Pixels to visit, clipped (max exclusive)
+    ImS64                                   E0[3], StepX[3], StepY[3];
+    int                                     Shading;
+    ImU32                                   Color;                      // Flat: final color. Textured: vertex color. Gouraud: texel.
+    const ImGui_ImplSoftRaster_Texture*     Texture;
+    float                                   U[3], V[3];
+    float                                   R[3], G[3], B[3], A[3];
+};
+
+// Software rasterizer data
+struct ImGui_ImplSoftRaster_Data
+{
+    ImVector<ImU32>                         FontPixels;
+    ImGui_ImplSoftRaster_Texture            FontTexture;
+    ImVector<ImU32>                         Framebuffer;
+    int                                     FramebufferWidth;
+    int                                     FramebufferHeight;
+    ImU32                                   ClearColor;
+
+    ImVector<ImGui_ImplSoftRaster_Triangle> Triangles;
+    int                                     TilesX;
+    int                                     TilesY;
+    ImVector<int>                           BinStart;       // Tile t owns BinTriangles[BinStart[t]] .. BinTriangles[BinStart[t + 1] - 1]
+    ImVector<int>                           BinCursor;
+    ImVector<int>                           BinTriangles;
+
+    // Worker threads. The calling thread rasterizes tiles too, so there are (thread count - 1) of them.
+    std::vector<std::thread>                Workers;
+    std::mutex                              Mutex;
+    std::condition_variable                 WorkCond;
+    std::condition_variable                 DoneCond;
+    int                                     Generation;     // Bumped for every frame handed out to the workers
+    int                                     Busy;           // Workers still rasterizing the current frame
+    bool                                    Quit;
+    std::atomic<int>                        NextTile;
+
+    ImGui_ImplSoftRaster_Data() : FramebufferWidth(0), FramebufferHeight(0), ClearColor(IM_COL32(0, 0, 0, 255)), TilesX(0), TilesY(0), Generation(0), Busy(0), Quit(false), NextTile(0) { memset((void*)&FontTexture, 0, sizeof(FontTexture)); }
+};
+
+// Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
+// It is STRONGLY preferred that you use docking branch with multi-viewports (== single Dear ImGui context + multiple windows) instead of multiple Dear ImGui contexts.
+static ImGui_ImplSoftRaster_Data* ImGui_ImplSoftRaster_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplSoftRaster_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Pixel helpers
+//-----------------------------------------------------------------------------
+
+static inline int ImGui_ImplSoftRaster_Min(int a, int b) { return a < b ? a : b; }
+static inline int ImGui_ImplSoftRaster_Max(int a, int b) { return a > b ? a : b; }
+
+// x / 255 rounded, exact for x in [0, 255*255]
+static inline int ImGui_ImplSoftRaster_Div255(int x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Multiply two colors channel by channel
+static inline ImU32 ImGui_ImplSoftRaster_Modulate(ImU32 a, ImU32 b)
+{
+    if (b == 0xFFFFFFFF)
+        return a;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        out |= (ImU32)ImGui_ImplSoftRaster_Div255((int)((a >> shift) & 0xFF) * (int)((b >> shift) & 0xFF)) << shift;
+    return out;
+}
+
+// Alpha blend src over dst. Alpha is the top byte with both color layouts (see IM_COL32_A_SHIFT).
+static inline ImU32 ImGui_ImplSoftRaster_Blend(ImU32 dst, ImU32 src)
+{
+    const int a = (int)(src >> 24);
+    if (a == 255)
+        return src;
+    if (a == 0)
+        return dst;
+    const int inv_a = 255 - a;
+    ImU32 out = (ImU32)ImGui_ImplSoftRaster_Div255(255 * a + (int)(dst >> 24) * inv_a) << 24;
+    for (int shift = 0; shift < 24; shift += 8)
+        out |= (ImU32)ImGui_ImplSoftRaster_Div255((int)((src >> shift) & 0xFF) * a + (int)((dst >> shift) & 0xFF) * inv_a) << shift;
+    return out;
+}
+
+static inline ImU32 ImGui_ImplSoftRaster_Sample(const ImGui_ImplSoftRaster_Texture* tex, float u, float v)
+{
+    if (tex == nullptr)
+        return 0xFFFFFFFF;
+    // Clamp addressing, like the sampler of the other backends
+    const float fx = u * (float)tex->Width;
+    const float fy = v * (float)tex->Height;
+    int x = fx > 0.0f ? (int)fx : 0;
+    int y = fy > 0.0f ? (int)fy : 0;
+    if (x >= tex->Width) x = tex->Width - 1;
+    if (y >= tex->Height) y = tex->Height - 1;
+    return tex->Pixels[y * tex->Width + x];
+}
+
+static inline ImU32 ImGui_ImplSoftRaster_PackColor(float r, float g, float b, float a)
+{
+    // Interpolated values stay within [0,255] inside the triangle, up to rounding errors
+    int ri = (int)(r + 0.5f), gi = (int)(g + 0.5f), bi = (int)(b + 0.5f), ai = (int)(a + 0.5f);
+    ri = ri < 0 ? 0 : ri > 255 ? 255 : ri;
+    gi = gi < 0 ? 0 : gi > 255 ? 255 : gi;
+    bi = bi < 0 ? 0 : bi > 255 ? 255 : bi;
+    ai = ai < 0 ? 0 : ai > 255 ? 255 : ai;
+    return IM_COL32(ri, gi, bi, ai);
+}
+
+#ifdef IMGUI_IMPL_SOFTRASTER_SSE2
+// Same as ImGui_ImplSoftRaster_Div255() on 16-bit lanes
+static inline __m128i ImGui_ImplSoftRaster_Div255_SSE2(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+#endif
+
+// Store the same color n times, without blending
+static void ImGui_ImplSoftRaster_StoreSpan(ImU32* dst, ImU32 col, int n)
+{
+    int i = 0;
+#ifdef IMGUI_IMPL_SOFTRASTER_SSE2
+    const __m128i c = _mm_set1_epi32((int)col);
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_si128((__m128i*)(dst + i), c);
+#endif
+    for (; i < n; i++)
+        dst[i] = col;
+}
+
+// Blend the same color over n pixels
+static void ImGui_ImplSoftRaster_FillSpan(ImU32* dst, ImU32 col, int n)
+{
+    const int a = (int)(col >> 24);
+    if (a == 0)
+        return;
+    if (a == 255)
+    {
+        ImGui_ImplSoftRaster_StoreSpan(dst, col, n);
+        return;
+    }
+    int i = 0;
+#ifdef IMGUI_IMPL_SOFTRASTER_SSE2
+    // dst * (255 - a) + src_term, with src_term = (r*a, g*a, b*a, 255*a) for two pixels
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha_one = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i src = _mm_or_si128(_mm_unpacklo_epi8(_mm_set1_epi32((int)col), zero), alpha_one);
+    const __m128i src_term = _mm_mullo_epi16(src, _mm_set1_epi16((short)a));
+    const __m128i inv_a = _mm_set1_epi16((short)(255 - a));
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv_a), src_term);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv_a), src_term);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(ImGui_ImplSoftRaster_Div255_SSE2(lo), ImGui_ImplSoftRaster_Div255_SSE2(hi)));
+    }
+#endif
+    for (; i < n; i++)
+        dst[i] = ImGui_ImplSoftRaster_Blend(dst[i], col);
+}
+
+// Blend n shaded pixels over n pixels
+static void ImGui_ImplSoftRaster_BlendSpan(ImU32* dst, const ImU32* src, int n)
+{
+    int i = 0;
+#ifdef IMGUI_IMPL_SOFTRASTER_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha_one = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i full = _mm_set1_epi16(255);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i s_lo = _mm_unpacklo_epi8(s, zero);
+        __m128i s_hi = _mm_unpackhi_epi8(s, zero);
+        __m128i a_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i a_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_or_si128(s_lo, alpha_one), a_lo), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(full, a_lo)));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_or_si128(s_hi, alpha_one), a_hi), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(full, a_hi)));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(ImGui_ImplSoftRaster_Div255_SSE2(lo), ImGui_ImplSoftRaster_Div255_SSE2(hi)));
+    }
+#endif
+    for (; i < n; i++)
+        dst[i] = ImGui_ImplSoftRaster_Blend(dst[i], src[i]);
+}
+
+//-----------------------------------------------------------------------------
+// Setup and binning
+//-----------------------------------------------------------------------------
+
+static inline void ImGui_ImplSoftRaster_SetupPlane(float* plane, const float f[3], const double px[3], const double py[3], double area)
+{
+    const double dx1 = px[1] - px[0], dy1 = py[1] - py[0];
+    const double dx2 = px[2] - px[0], dy2 = py[2] - py[0];
+    const double df1 = f[1] - f[0], df2 = f[2] - f[0];
+    const double dfdx = (df1 * dy2 - df2 * dy1) / area;
+    const double dfdy = (df2 * dx1 - df1 * dx2) / area;
+    plane[0] = (float)(f[0] + dfdx * (0.5 - px[0]) + dfdy * (0.5 - py[0]));
+    plane[1] = (float)dfdx;
+    plane[2] = (float)dfdy;
+}
+
+static void ImGui_ImplSoftRaster_SetupTriangle(ImGui_ImplSoftRaster_Data* bd, const ImDrawVert* v0, const ImDrawVert* v1, const ImDrawVert* v2, const ImVec2& offset, const ImVec2& scale, const int clip[4], const ImGui_ImplSoftRaster_Texture* tex)
+{
+    const ImDrawVert* v[3] = { v0, v1, v2 };
+    if (((v0->col | v1->col | v2->col) >> 24) == 0)
+        return; // Fully transparent, e.g. the outer fringe of anti-aliased shapes
+
+    // Snap to 1/256th of a pixel. Vertices are kept within +/-2^20 pixels so that edge functions fit in 64 bits.
+    const float limit = (float)(1 << 20);
+    double px[3], py[3];
+    ImS64 fx[3], fy[3];
+    float min_x = limit, min_y = limit, max_x = -limit, max_y = -limit;
+    for (int i = 0; i < 3; i++)
+    {
+        float x = (v[i]->pos.x - offset.x) * scale.x;
+        float y = (v[i]->pos.y - offset.y) * scale.y;
+        x = x < -limit ? -limit : x > limit ? limit : x;
+        y = y < -limit ? -limit : y > limit ? limit : y;
+        fx[i] = (ImS64)floorf(x * 256.0f + 0.5f);
+        fy[i] = (ImS64)floorf(y * 256.0f + 0.5f);
+        px[i] = x;
+        py[i] = y;
+        min_x = x < min_x ? x : min_x; max_x = x > max_x ? x : max_x;
+        min_y = y < min_y ? y : min_y; max_y = y > max_y ? y : max_y;
+    }
+    const ImS64 area = (fx[1] - fx[0]) * (fy[2] - fy[0]) - (fx[2] - fx[0]) * (fy[1] - fy[0]);
+    if (area == 0)
+        return;
+
+    ImGui_ImplSoftRaster_Triangle t;
+    t.MinX = ImGui_ImplSoftRaster_Max(clip[0], (int)floorf(min_x));
+    t.MinY = ImGui_ImplSoftRaster_Max(clip[1], (int)floorf(min_y));
+    t.MaxX = ImGui_ImplSoftRaster_Min(clip[2], (int)ceilf(max_x));
+    t.MaxY = ImGui_ImplSoftRaster_Min(clip[3], (int)ceilf(max_y));
+    if (t.MinX >= t.MaxX || t.MinY >= t.MaxY)
+        return;
+
+    // Edge e goes from vertex e+1 to vertex e+2. Both windings are accepted (no culling, like the other backends).
+    for (int e = 0; e < 3; e++)
+    {
+        const int j = (e + 1) % 3, k = (e + 2) % 3;
+        ImS64 a = fy[j] - fy[k];
+        ImS64 b = fx[k] - fx[j];
+        ImS64 c = fx[j] * fy[k] - fx[k] * fy[j];
+        if (area < 0)
+        {
+            a = -a;
+            b = -b;
+            c = -c;
+        }
+        // Top-left rule: pixel centers exactly on an edge belong to the triangle on its right or below it
+        const ImS64 bias = (a > 0 || (a == 0 && b > 0)) ? 0 : -1;
+        t.StepX[e] = a * 256;
+        t.StepY[e] = b * 256;
+        t.E0[e] = a * 128 + b * 128 + c + bias;
+    }
+
+    const bool same_col = v0->col == v1->col && v1->col == v2->col;
+    const bool same_uv = v0->uv.x == v1->uv.x && v0->uv.x == v2->uv.x && v0->uv.y == v1->uv.y && v0->uv.y == v2->uv.y;
+    t.Texture = tex;
+    if (same_col && same_uv)
+    {
+        t.Shading = ImGui_ImplSoftRaster_Shading_Flat;
+        t.Color = ImGui_ImplSoftRaster_Modulate(v0->col, ImGui_ImplSoftRaster_Sample(tex, v0->uv.x, v0->uv.y));
+        if ((t.Color >> 24) == 0)
+            return;
+    }
+    else
+    {
+        const double farea = (px[1] - px[0]) * (py[2] - py[0]) - (px[2] - px[0]) * (py[1] - py[0]);
+        if (farea == 0.0)
+            return;
+        if (!same_uv)
+        {
+            const float u[3] = { v0->uv.x, v1->uv.x, v2->uv.x };
+            const float vv[3] = { v0->uv.y, v1->uv.y, v2->uv.y };
+            ImGui_ImplSoftRaster_SetupPlane(t.U, u, px, py, farea);
+            ImGui_ImplSoftRaster_SetupPlane(t.V, vv, px, py, farea);
+        }
+        if (same_col)
+        {
+            t.Shading = ImGui_ImplSoftRaster_Shading_Textured;
+            t.Color = v0->col;
+        }
+        else
+        {
+            t.Shading = same_uv ? ImGui_ImplSoftRaster_Shading_Gouraud : ImGui_ImplSoftRaster_Shading_GouraudTextured;
+            t.Color = same_uv ? ImGui_ImplSoftRaster_Sample(tex, v0->uv.x, v0->uv.y) : 0xFFFFFFFF;
+            float ch[3];
+            for (int i = 0; i < 3; i++) ch[i] = (float)((v[i]->col >> IM_COL32_R_SHIFT) & 0xFF);
+            ImGui_ImplSoftRaster_SetupPlane(t.R, ch, px, py, farea);
+            for (int i = 0; i < 3; i++) ch[i] = (float)((v[i]->col >> IM_COL32_G_SHIFT) & 0xFF);
+            ImGui_ImplSoftRaster_SetupPlane(t.G, ch, px, py, farea);
+            for (int i = 0; i < 3; i++) ch[i] = (float)((v[i]->col >> IM_COL32_B_SHIFT) & 0xFF);
+            ImGui_ImplSoftRaster_SetupPlane(t.B, ch, px, py, farea);
+            for (int i = 0; i < 3; i++) ch[i] = (float)((v[i]->col >> IM_COL32_A_SHIFT) & 0xFF);
+            ImGui_ImplSoftRaster_SetupPlane(t.A, ch, px, py, farea);
+        }
+    }
+    bd->Triangles.push_back(t);
+}
+
+// Counting sort of the triangles into tiles, keeping submission order in each tile
+static void ImGui_ImplSoftRaster_BinTriangles(ImGui_ImplSoftRaster_Data* bd)
+{
+    const int tile_count = bd->TilesX * bd->TilesY;
+    bd->BinStart.resize(tile_count + 1);
+    memset(bd->BinStart.Data, 0, (size_t)bd->BinStart.Size * sizeof(int));
+    for (const ImGui_ImplSoftRaster_Triangle& t : bd->Triangles)
+        for (int ty = t.MinY >> SOFTRASTER_TILE_SHIFT; ty <= (t.MaxY - 1) >> SOFTRASTER_TILE_SHIFT; ty++)
+            for (int tx = t.MinX >> SOFTRASTER_TILE_SHIFT; tx <= (t.MaxX - 1) >> SOFTRASTER_TILE_SHIFT; tx++)
+                bd->BinStart[ty * bd->TilesX + tx + 1]++;
+    for (int i = 0; i < tile_count; i++)
+        bd->BinStart[i + 1] += bd->BinStart[i];
+
+    bd->BinCursor.resize(tile_count);
+    memcpy(bd->BinCursor.Data, bd->BinStart.Data, (size_t)tile_count * sizeof(int));
+    bd->BinTriangles.resize(bd->BinStart[tile_count]);
+    for (int n = 0; n < bd->Triangles.Size; n++)
+    {
+        const ImGui_ImplSoftRaster_Triangle& t = bd->Triangles[n];
+        for (int ty = t.MinY >> SOFTRASTER_TILE_SHIFT; ty <= (t.MaxY - 1) >> SOFTRASTER_TILE_SHIFT; ty++)
+            for (int tx = t.MinX >> SOFTRASTER_TILE_SHIFT; tx <= (t.MaxX - 1) >> SOFTRASTER_TILE_SHIFT; tx++)
+                bd->BinTriangles[bd->BinCursor[ty * bd->TilesX + tx]++] = n;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Rasterization
+//-----------------------------------------------------------------------------
+
+// Floor and ceiling of a / b for b > 0
+static inline ImS64 ImGui_ImplSoftRaster_FloorDiv(ImS64 a, ImS64 b) { return a >= 0 ? a / b : -((-a + b - 1) / b); }
+static inline ImS64 ImGui_ImplSoftRaster_CeilDiv(ImS64 a, ImS64 b)  { return a >= 0 ? (a + b - 1) / b : -((-a) / b); }
+
+static void ImGui_ImplSoftRaster_RasterizeTile(ImGui_ImplSoftRaster_Data* bd, int tile)
+{
+    const int fb_width = bd->FramebufferWidth;
+    const int tile_x0 = (tile % bd->TilesX) << SOFTRASTER_TILE_SHIFT;
+    const int tile_y0 = (tile / bd->TilesX) << SOFTRASTER_TILE_SHIFT;
+    const int tile_x1 = ImGui_ImplSoftRaster_Min(tile_x0 + SOFTRASTER_TILE_SIZE, fb_width);
+    const int tile_y1 = ImGui_ImplSoftRaster_Min(tile_y0 + SOFTRASTER_TILE_SIZE, bd->FramebufferHeight);
+    ImU32* fb = bd->Framebuffer.Data;
+
+    for (int y = tile_y0; y < tile_y1; y++)
+        ImGui_ImplSoftRaster_StoreSpan(fb + (size_t)y * fb_width + tile_x0, bd->ClearColor, tile_x1 - tile_x0);
+
+    ImU32 shaded[SOFTRASTER_TILE_SIZE];
+    for (int bin_n = bd->BinStart[tile]; bin_n < bd->BinStart[tile + 1]; bin_n++)
+    {
+        const ImGui_ImplSoftRaster_Triangle& t = bd->Triangles[bd->BinTriangles[bin_n]];
+        const int x0 = ImGui_ImplSoftRaster_Max(t.MinX, tile_x0), x1 = ImGui_ImplSoftRaster_Min(t.MaxX, tile_x1);
+        const int y0 = ImGui_ImplSoftRaster_Max(t.MinY, tile_y0), y1 = ImGui_ImplSoftRaster_Min(t.MaxY, tile_y1);
+        for (int y = y0; y < y1; y++)
+        {
+            // Solve E0 + StepY*y + StepX*x >= 0 for x, for the three edges
+            int xs = x0, xe = x1;
+            for (int e = 0; e < 3 && xs < xe; e++)
+            {
+                const ImS64 row = t.E0[e] + t.StepY[e] * y;
+                const ImS64 step = t.StepX[e];
+                if (step > 0)
+                {
+                    const ImS64 first = ImGui_ImplSoftRaster_CeilDiv(-row, step);
+                    if (first > xs) xs = first > xe ? xe : (int)first;
+                }
+                else if (step < 0)
+                {
+                    const ImS64 end = ImGui_ImplSoftRaster_FloorDiv(row, -step) + 1;
+                    if (end < xe) xe = end < xs ? xs : (int)end;
+                }
+                else if (row < 0)
+                {
+                    xe = xs;
+                }
+            }
+            const int n = xe - xs;
+            if (n <= 0)
+                continue;
+
+            ImU32* dst = fb + (size_t)y * fb_width + xs;
+            switch (t.Shading)
+            {
+            case ImGui_ImplSoftRaster_Shading_Flat:
+                ImGui_ImplSoftRaster_FillSpan(dst, t.Color, n);
+                break;
+            case ImGui_ImplSoftRaster_Shading_Textured:
+            {
+                float u = t.U[0] + t.U[1] * xs + t.U[2] * y;
+                float v = t.V[0] + t.V[1] * xs + t.V[2] * y;
+                for (int i = 0; i < n; i++, u += t.U[1], v += t.V[1])
+                    shaded[i] = ImGui_ImplSoftRaster_Modulate(t.Color, ImGui_ImplSoftRaster_Sample(t.Texture, u, v));
+                ImGui_ImplSoftRaster_BlendSpan(dst, shaded, n);
+                break;
+            }
+            case ImGui_ImplSoftRaster_Shading_Gouraud:
+            case ImGui_ImplSoftRaster_Shading_GouraudTextured:
+            {
+                const bool textured = t.Shading == ImGui_ImplSoftRaster_Shading_GouraudTextured;
+                float r = t.R[0] + t.R[1] * xs + t.R[2] * y;
+                float g = t.G[0] + t.G[1] * xs + t.G[2] * y;
+                float b = t.B[0] + t.B[1] * xs + t.B[2] * y;
+                float a = t.A[0] + t.A[1] * xs + t.A[2] * y;
+                float u = textured ? t.U[0] + t.U[1] * xs + t.U[2] * y : 0.0f;
+                float v = textured ? t.V[0] + t.V[1] * xs + t.V[2] * y : 0.0f;
+                for (int i = 0; i < n; i++)
+                {
+                    const ImU32 texel = textured ? ImGui_ImplSoftRaster_Sample(t.Texture, u, v) : t.Color;
+                    shaded[i] = ImGui_ImplSoftRaster_Modulate(ImGui_ImplSoftRaster_PackColor(r, g, b, a), texel);
+                    r += t.R[1]; g += t.G[1]; b += t.B[1]; a += t.A[1];
+                    if (textured) { u += t.U[1]; v += t.V[1]; }
+                }
+                ImGui_ImplSoftRaster_BlendSpan(dst, shaded, n);
+                break;
+            }
+            }
+        }
+    }
+}
+
+static void ImGui_ImplSoftRaster_RasterizeTiles(ImGui_ImplSoftRaster_Data* bd)
+{
+    const int tile_count = bd->TilesX * bd->TilesY;
+    for (int tile = bd->NextTile.fetch_add(1); tile < tile_count; tile = bd->NextTile.fetch_add(1))
+        ImGui_ImplSoftRaster_RasterizeTile(bd, tile);
+}
+
+static void ImGui_ImplSoftRaster_WorkerMain(ImGui_ImplSoftRaster_Data* bd)
+{
+    int generation = 0;
+    std::unique_lock<std::mutex> lock(bd->Mutex);
+    for (;;)
+    {
+        bd->WorkCond.wait(lock, [&] { return bd->Quit || bd->Generation != generation; });
+        if (bd->Quit)
+            return;
+        generation = bd->Generation;
+        lock.unlock();
+        ImGui_ImplSoftRaster_RasterizeTiles(bd);
+        lock.lock();
+        if (--bd->Busy == 0)
+            bd->DoneCond.notify_one();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Backend API
+//-----------------------------------------------------------------------------
+
+void ImGui_ImplSoftRaster_RenderDrawData(ImDrawData* draw_data)
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoftRaster_Init()?");
+
+    // Avoid rendering when minimized
+    const int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    const int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0)
+        return;
+    if (fb_width != bd->FramebufferWidth || fb_height != bd->FramebufferHeight)
+    {
+        bd->Framebuffer.resize(fb_width * fb_height);
+        bd->FramebufferWidth = fb_width;
+        bd->FramebufferHeight = fb_height;
+    }
+    bd->TilesX = (fb_width + SOFTRASTER_TILE_SIZE - 1) >> SOFTRASTER_TILE_SHIFT;
+    bd->TilesY = (fb_height + SOFTRASTER_TILE_SIZE - 1) >> SOFTRASTER_TILE_SHIFT;
+
+    // Setup triangles of all command lists
+    // Our visible imgui space lies from draw_data->DisplayPos (top left) to draw_data->DisplayPos+data_data->DisplaySize (bottom right). DisplayPos is (0,0) for single viewport apps.
+    bd->Triangles.resize(0);
+    const ImVec2 clip_off = draw_data->DisplayPos;
+    const ImVec2 clip_scale = draw_data->FramebufferScale;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != nullptr)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.
+                // We have no render state to reset.)
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(draw_list, pcmd);
+                continue;
+            }
+
+            // Project scissor/clipping rectangles into framebuffer space
+            ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+            ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+            if (clip_min.x < 0.0f) { clip_min.x = 0.0f; }
+            if (clip_min.y < 0.0f) { clip_min.y = 0.0f; }
+            if (clip_max.x > (float)fb_width) { clip_max.x = (float)fb_width; }
+            if (clip_max.y > (float)fb_height) { clip_max.y = (float)fb_height; }
+            if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+                continue;
+            const int clip[4] = { (int)clip_min.x, (int)clip_min.y, (int)clip_max.x, (int)clip_max.y };
+
+            const ImGui_ImplSoftRaster_Texture* tex = (const ImGui_ImplSoftRaster_Texture*)(intptr_t)pcmd->GetTexID();
+            const ImDrawVert* vtx = draw_list->VtxBuffer.Data + pcmd->VtxOffset;
+            const ImDrawIdx* idx = draw_list->IdxBuffer.Data + pcmd->IdxOffset;
+            for (unsigned int i = 0; i + 2 < pcmd->ElemCount; i += 3)
+                ImGui_ImplSoftRaster_SetupTriangle(bd, &vtx[idx[i]], &vtx[idx[i + 1]], &vtx[idx[i + 2]], clip_off, clip_scale, clip, tex);
+        }
+    }
+    ImGui_ImplSoftRaster_BinTriangles(bd);
+
+    // Rasterize tiles on all threads
+    bd->NextTile.store(0);
+    if (!bd->Workers.empty())
+    {
+        {
+            std::lock_guard<std::mutex> lock(bd->Mutex);
+            bd->Generation++;
+            bd->Busy = (int)bd->Workers.size();
+        }
+        bd->WorkCond.notify_all();
+    }
+    ImGui_ImplSoftRaster_RasterizeTiles(bd);
+    if (!bd->Workers.empty())
+    {
+        std::unique_lock<std::mutex> lock(bd->Mutex);
+        bd->DoneCond.wait(lock, [&] { return bd->Busy == 0; });
+    }
+}
+
+void ImGui_ImplSoftRaster_SetClearColor(ImU32 col)
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoftRaster_Init()?");
+    bd->ClearColor = col;
+}
+
+int ImGui_ImplSoftRaster_GetThreadCount()
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoftRaster_Init()?");
+    return (int)bd->Workers.size() + 1;
+}
+
+const ImU32* ImGui_ImplSoftRaster_GetFramebuffer(int* out_width, int* out_height)
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoftRaster_Init()?");
+    if (out_width) *out_width = bd->FramebufferWidth;
+    if (out_height) *out_height = bd->FramebufferHeight;
+    return bd->Framebuffer.Size > 0 ? bd->Framebuffer.Data : nullptr;
+}
+
+static void ImGui_ImplSoftRaster_CreateFontsTexture()
+{
+    // Build texture atlas
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    // Keep our own copy: the atlas may free its pixels (ImFontAtlas::ClearTexData)
+    bd->FontPixels.resize(width * height);
+    memcpy(bd->FontPixels.Data, pixels, (size_t)width * height * 4);
+    bd->FontTexture.Width = width;
+    bd->FontTexture.Height = height;
+    bd->FontTexture.Pixels = bd->FontPixels.Data;
+
+    // Store our identifier
+    io.Fonts->SetTexID((ImTextureID)(intptr_t)&bd->FontTexture);
+}
+
+static void ImGui_ImplSoftRaster_DestroyFontsTexture()
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    if (bd->FontTexture.Pixels)
+    {
+        bd->FontPixels.clear();
+        memset((void*)&bd->FontTexture, 0, sizeof(bd->FontTexture));
+        ImGui::GetIO().Fonts->SetTexID(0); // We copied &bd->FontTexture to io.Fonts->TexID so let's clear that as well.
+    }
+}
+
+bool    ImGui_ImplSoftRaster_CreateDeviceObjects()
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    if (bd->FontTexture.Pixels)
+        ImGui_ImplSoftRaster_InvalidateDeviceObjects();
+    ImGui_ImplSoftRaster_CreateFontsTexture();
+    return true;
+}
+
+void    ImGui_ImplSoftRaster_InvalidateDeviceObjects()
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    if (!bd)
+        return;
+    ImGui_ImplSoftRaster_DestroyFontsTexture();
+}
+
+bool    ImGui_ImplSoftRaster_Init(int thread_count)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IMGUI_CHECKVERSION();
+    IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
+
+    // Setup backend capabilities flags
+    ImGui_ImplSoftRaster_Data* bd = IM_NEW(ImGui_ImplSoftRaster_Data)();
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_softraster";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+
+    if (thread_count <= 0)
+        thread_count = (int)std::thread::hardware_concurrency();
+    for (int i = 1; i < thread_count; i++)
+        bd->Workers.emplace_back(ImGui_ImplSoftRaster_WorkerMain, bd);
+
+    return true;
+}
+
+void ImGui_ImplSoftRaster_Shutdown()
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    {
+        std::lock_guard<std::mutex> lock(bd->Mutex);
+        bd->Quit = true;
+    }
+    bd->WorkCond.notify_all();
+    for (std::thread& worker : bd->Workers)
+        worker.join();
+
+    ImGui_ImplSoftRaster_InvalidateDeviceObjects();
+    io.BackendRendererName = nullptr;
+    io.BackendRendererUserData = nullptr;
+    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasVtxOffset;
+    IM_DELETE(bd);
+}
+
+void ImGui_ImplSoftRaster_NewFrame()
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoftRaster_Init()?");
+
+    if (!bd->FontTexture.Pixels)
+        ImGui_ImplSoftRaster_CreateDeviceObjects();
+}
+
+//-----------------------------------------------------------------------------
+
+#endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,57 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer
+// This needs no GPU and no window: draw data is rasterized into an RGBA framebuffer in memory,
+// e.g. to render on headless servers, take screenshots, or measure frame times without a GPU.
+// It can be used with any Platform Backend, or with no Platform Backend at all (set io.DisplaySize and io.DeltaTime yourself).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftRaster_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
+//  [X] Renderer: Multi-threaded rasterization: triangles are binned into screen tiles, tiles are rasterized in parallel.
+// Missing features:
+//  [ ] Renderer: Multi-viewport support (multiple windows).
+//  [ ] Renderer: Bilinear filtering. Textures are point sampled, which is exact for the font atlas since glyphs are pixel aligned.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+#ifndef IMGUI_DISABLE
+
+// A texture in CPU memory: Width*Height pixels packed like IM_COL32(), rows top to bottom with no padding.
+// Pass a pointer to it as ImTextureID. The pixels must stay valid until ImGui_ImplSoftRaster_RenderDrawData() returns.
+struct ImGui_ImplSoftRaster_Texture
+{
+    int             Width;
+    int             Height;
+    const ImU32*    Pixels;
+};
+
+// Follow "Getting Started" link and check examples/ folder to learn about using backends!
+// thread_count: number of threads rasterizing tiles, including the calling thread. 0 uses one per hardware thread.
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_Init(int thread_count = 0);
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_NewFrame();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_RenderDrawData(ImDrawData* draw_data);
+
+// Number of threads rasterizing tiles, including the calling thread (thread_count as resolved by ImGui_ImplSoftRaster_Init()).
+IMGUI_IMPL_API int      ImGui_ImplSoftRaster_GetThreadCount();
+
+// The framebuffer is cleared to this color at the start of ImGui_ImplSoftRaster_RenderDrawData(). Default: opaque black.
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_SetClearColor(ImU32 col);
+
+// Result of the last ImGui_ImplSoftRaster_RenderDrawData() call: DisplaySize*FramebufferScale pixels packed like IM_COL32()
+// (so R,G,B,A bytes in memory with the default color layout), rows top to bottom with no padding.
+// Valid until the next ImGui_ImplSoftRaster_RenderDrawData() call. Returns nullptr if nothing was rendered yet.
+IMGUI_IMPL_API const ImU32* ImGui_ImplSoftRaster_GetFramebuffer(int* out_width, int* out_height);
+
+// Use if you want to rebuild the font texture without losing Dear ImGui state.
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_CreateDeviceObjects();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_InvalidateDeviceObjects();
+
+#endif // #ifndef IMGUI_DISABLE
@@ -791,6 +791,7 @@ struct IMGUI_API ImDrawListSharedData
     ImVec4          ClipRectFullscreen;         // Value for PushClipRectFullscreen()
     ImDrawListFlags InitialFlags;               // Initial flags at the beginning of the frame (it is possible to alter flags on a per-drawlist basis afterwards)
     ImVector<ImVec2> TempBuffer;                // Temporary write buffer
+    bool            TessellationNoSimd;         // Use the scalar code in AddPolyline()/AddConvexPolyFilled() even when SSE/NEON is available (for testing and benchmarking)
 
     // Lookup tables
     ImVec2          ArcFastVtx[IM_DRAWLIST_ARCFAST_TABLE_SIZE]; // Sample points on the quarter of the circle.
@@ -2602,6 +2603,8 @@ struct ImGuiContext
     int                     WantTextInputNextFrame;
     ImVector<char>          TempBuffer;                         // Temporary text buffer
     char                    TempKeychordName[64];
+    ImVector<float>         PlotValues;                         // Temporary buffer for PlotEx(): decimated values
+    ImVector<int>           PlotIndices;                        // Temporary buffer for PlotEx(): source index of each decimated value
 
     ImGuiContext(ImFontAtlas* shared_font_atlas);
 };
@@ -3759,6 +3762,7 @@ namespace ImGui
 
     // Plot
     IMGUI_API int           PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, const ImVec2& size_arg);
+    IMGUI_API int           PlotDecimateEx(float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, int max_points, float* out_values, int* out_indices, ImGuiPlotType plot_type = ImGuiPlotType_Lines, float* out_min = NULL);
 
     // Shade functions (write over already created vertices)
     IMGUI_API void          ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1);
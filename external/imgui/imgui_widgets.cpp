@@ -8356,9 +8356,11 @@ bool ImGui::ListBox(const char* label, int* current_item, const char* (*getter)(
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: PlotLines, PlotHistogram
 //-------------------------------------------------------------------------
+// - PlotDecimateEx() [Internal]
 // - PlotEx() [Internal]
 // - PlotLines()
 // - PlotHistogram()
+// - PlotDecimate()
 //-------------------------------------------------------------------------
 // Plot/Graph widgets are not very good.
 // Consider writing your own, or using a third-party one, see:
@@ -8366,6 +8368,82 @@ bool ImGui::ListBox(const char* label, int* current_item, const char* (*getter)(
 // - others https://github.com/ocornut/imgui/wiki/Useful-Extensions
 //-------------------------------------------------------------------------
 
+// Reduce a series to at most 'max_points' points (>= 2) by splitting it into max_points/2 buckets and keeping
+// the minimum and maximum of each bucket, in their original order. Unlike sub-sampling, spikes always survive.
+// With ImGuiPlotType_Histogram, the series is split into max_points buckets and each one keeps only its maximum,
+// indexed at the start of the bucket, so a bar drawn from the baseline spans the whole bucket and a spike can't
+// end up in a sliver narrower than a pixel. 'out_min' (optional) receives the minimum of all values.
+// NaN values are skipped. 'out_indices' (optional) receives the source index of each output value.
+int ImGui::PlotDecimateEx(float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, int max_points, float* out_values, int* out_indices, ImGuiPlotType plot_type, float* out_min)
+{
+    int out_count = 0;
+    float all_min = FLT_MAX;
+    if (values_count <= max_points)
+    {
+        for (int i = 0; i < values_count; i++)
+        {
+            const float v = values_getter(data, (i + values_offset) % values_count);
+            if (v != v) // Ignore NaN values
+                continue;
+            all_min = ImMin(all_min, v);
+            out_values[out_count] = v;
+            if (out_indices)
+                out_indices[out_count] = i;
+            out_count++;
+        }
+        if (out_min)
+            *out_min = all_min;
+        return out_count;
+    }
+
+    IM_ASSERT(max_points >= 2);
+    const bool max_only = (plot_type == ImGuiPlotType_Histogram);
+    const int bucket_count = max_only ? max_points : max_points / 2;
+    for (int bucket_n = 0; bucket_n < bucket_count; bucket_n++)
+    {
+        const int i0 = (int)((ImS64)values_count * bucket_n / bucket_count);
+        const int i1 = (int)((ImS64)values_count * (bucket_n + 1) / bucket_count);
+        float v_min = FLT_MAX, v_max = -FLT_MAX;
+        int i_min = -1, i_max = -1;
+        for (int i = i0; i < i1; i++)
+        {
+            const float v = values_getter(data, (i + values_offset) % values_count);
+            if (v != v) // Ignore NaN values
+                continue;
+            if (v < v_min) { v_min = v; i_min = i; }
+            if (v > v_max) { v_max = v; i_max = i; }
+        }
+        if (i_min == -1)
+            continue;
+        all_min = ImMin(all_min, v_min);
+
+        if (max_only)
+        {
+            out_values[out_count] = v_max;
+            if (out_indices)
+                out_indices[out_count] = i0;
+            out_count++;
+            continue;
+        }
+
+        const bool min_first = (i_min <= i_max);
+        out_values[out_count] = min_first ? v_min : v_max;
+        if (out_indices)
+            out_indices[out_count] = min_first ? i_min : i_max;
+        out_count++;
+        if (i_min != i_max)
+        {
+            out_values[out_count] = min_first ? v_max : v_min;
+            if (out_indices)
+                out_indices[out_count] = min_first ? i_max : i_min;
+            out_count++;
+        }
+    }
+    if (out_min)
+        *out_min = all_min;
+    return out_count;
+}
+
 int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, const ImVec2& size_arg)
 {
     ImGuiContext& g = *GImGui;
@@ -8388,19 +8466,25 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
     bool hovered;
     ButtonBehavior(frame_bb, id, &hovered, NULL);
 
-    // Determine scale from values if not specified
+    // Gather values, reduced so the cost is bounded by the plot width and spikes remain visible.
+    // Lines keep the min and max envelope of each pixel (two points per pixel), histograms keep one bar per pixel
+    // drawn from the baseline to the pixel's max.
+    const int points_max = ImMax(ImMax((int)inner_bb.GetWidth(), 1) * ((plot_type == ImGuiPlotType_Lines) ? 2 : 1), 2);
+    const int points_capacity = ImMax(ImMin(values_count, points_max), 0);
+    g.PlotValues.resize(points_capacity);
+    g.PlotIndices.resize(points_capacity);
+    float values_min = FLT_MAX;
+    const int points_count = (values_count > 0) ? PlotDecimateEx(values_getter, data, values_count, values_offset, points_max, g.PlotValues.Data, g.PlotIndices.Data, plot_type, &values_min) : 0;
+    const float* plot_values = g.PlotValues.Data;
+    const int* plot_indices = g.PlotIndices.Data;
+
+    // Determine scale from values if not specified (decimation preserves the max, and reports the min)
     if (scale_min == FLT_MAX || scale_max == FLT_MAX)
     {
-        float v_min = FLT_MAX;
+        float v_min = values_min;
         float v_max = -FLT_MAX;
-        for (int i = 0; i < values_count; i++)
-        {
-            const float v = values_getter(data, i);
-            if (v != v) // Ignore NaN values
-                continue;
-            v_min = ImMin(v_min, v);
-            v_max = ImMax(v_max, v);
-        }
+        for (int n = 0; n < points_count; n++)
+            v_max = ImMax(v_max, plot_values[n]);
         if (scale_min == FLT_MAX)
             scale_min = v_min;
         if (scale_max == FLT_MAX)
@@ -8411,9 +8495,8 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
 
     const int values_count_min = (plot_type == ImGuiPlotType_Lines) ? 2 : 1;
     int idx_hovered = -1;
-    if (values_count >= values_count_min)
+    if (values_count >= values_count_min && points_count > 0)
     {
-        int res_w = ImMin((int)frame_size.x, values_count) + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
         int item_count = values_count + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
 
         // Tooltip on hover
@@ -8432,41 +8515,48 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
             idx_hovered = v_idx;
         }
 
-        const float t_step = 1.0f / (float)res_w;
         const float inv_scale = (scale_min == scale_max) ? 0.0f : (1.0f / (scale_max - scale_min));
-
-        float v0 = values_getter(data, (0 + values_offset) % values_count);
-        float t0 = 0.0f;
-        ImVec2 tp0 = ImVec2( t0, 1.0f - ImSaturate((v0 - scale_min) * inv_scale) );                       // Point in the normalized space of our target rectangle
+        const float inv_item_count = 1.0f / (float)item_count;
         float histogram_zero_line_t = (scale_min * scale_max < 0.0f) ? (1 + scale_min * inv_scale) : (scale_min < 0.0f ? 0.0f : 1.0f);   // Where does the zero line stands
 
         const ImU32 col_base = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLines : ImGuiCol_PlotHistogram);
         const ImU32 col_hovered = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLinesHovered : ImGuiCol_PlotHistogramHovered);
 
-        for (int n = 0; n < res_w; n++)
+        if (plot_type == ImGuiPlotType_Lines)
         {
-            const float t1 = t0 + t_step;
-            const int v1_idx = (int)(t0 * item_count + 0.5f);
-            IM_ASSERT(v1_idx >= 0 && v1_idx < values_count);
-            const float v1 = values_getter(data, (v1_idx + values_offset + 1) % values_count);
-            const ImVec2 tp1 = ImVec2( t1, 1.0f - ImSaturate((v1 - scale_min) * inv_scale) );
+            // Submit the whole series as a single polyline, then overdraw the hovered segment
+            for (int n = 0; n < points_count; n++)
+            {
+                const ImVec2 tp = ImVec2(plot_indices[n] * inv_item_count, 1.0f - ImSaturate((plot_values[n] - scale_min) * inv_scale)); // Point in the normalized space of our target rectangle
+                window->DrawList->PathLineTo(ImLerp(inner_bb.Min, inner_bb.Max, tp));
+            }
+            window->DrawList->PathStroke(col_base, ImDrawFlags_None, 1.0f);
 
-            // NB: Draw calls are merged together by the DrawList system. Still, we should render our batch are lower level to save a bit of CPU.
-            ImVec2 pos0 = ImLerp(inner_bb.Min, inner_bb.Max, tp0);
-            ImVec2 pos1 = ImLerp(inner_bb.Min, inner_bb.Max, (plot_type == ImGuiPlotType_Lines) ? tp1 : ImVec2(tp1.x, histogram_zero_line_t));
-            if (plot_type == ImGuiPlotType_Lines)
+            if (idx_hovered != -1)
             {
-                window->DrawList->AddLine(pos0, pos1, idx_hovered == v1_idx ? col_hovered : col_base);
+                const float v0 = values_getter(data, (idx_hovered + values_offset) % values_count);
+                const float v1 = values_getter(data, (idx_hovered + 1 + values_offset) % values_count);
+                const ImVec2 tp0 = ImVec2(idx_hovered * inv_item_count, 1.0f - ImSaturate((v0 - scale_min) * inv_scale));
+                const ImVec2 tp1 = ImVec2((idx_hovered + 1) * inv_item_count, 1.0f - ImSaturate((v1 - scale_min) * inv_scale));
+                if (v0 == v0 && v1 == v1)
+                    window->DrawList->AddLine(ImLerp(inner_bb.Min, inner_bb.Max, tp0), ImLerp(inner_bb.Min, inner_bb.Max, tp1), col_hovered);
             }
-            else if (plot_type == ImGuiPlotType_Histogram)
+        }
+        else if (plot_type == ImGuiPlotType_Histogram)
+        {
+            // Each point covers the source items up to the next point (a whole pixel once decimated)
+            for (int n = 0; n < points_count; n++)
             {
+                const int idx0 = plot_indices[n];
+                const int idx1 = (n + 1 < points_count) ? plot_indices[n + 1] : values_count;
+                const ImVec2 tp0 = ImVec2(idx0 * inv_item_count, 1.0f - ImSaturate((plot_values[n] - scale_min) * inv_scale));
+                const ImVec2 tp1 = ImVec2(idx1 * inv_item_count, histogram_zero_line_t);
+                ImVec2 pos0 = ImLerp(inner_bb.Min, inner_bb.Max, tp0);
+                ImVec2 pos1 = ImLerp(inner_bb.Min, inner_bb.Max, tp1);
                 if (pos1.x >= pos0.x + 2.0f)
                     pos1.x -= 1.0f;
-                window->DrawList->AddRectFilled(pos0, pos1, idx_hovered == v1_idx ? col_hovered : col_base);
+                window->DrawList->AddRectFilled(pos0, pos1, (idx_hovered >= idx0 && idx_hovered < idx1) ? col_hovered : col_base);
             }
-
-            t0 = t1;
-            tp0 = tp1;
         }
     }
 
@@ -8519,6 +8609,12 @@ void ImGui::PlotHistogram(const char* label, float (*values_getter)(void* data,
     PlotEx(ImGuiPlotType_Histogram, label, values_getter, data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size);
 }
 
+int ImGui::PlotDecimate(const float* values, int values_count, int max_points, float* out_values, int* out_indices, int stride)
+{
+    ImGuiPlotArrayGetterData data(values, stride);
+    return PlotDecimateEx(&Plot_ArrayGetter, (void*)&data, values_count, 0, max_points, out_values, out_indices);
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Value helpers
 // Those is not very useful, legacy API.
@@ -30,6 +30,22 @@ SPDLOG_INLINE spdlog::async_logger::async_logger(std::string logger_name,
     : async_logger(
           std::move(logger_name), {std::move(single_sink)}, std::move(tp), overflow_policy) {}
 
+#ifdef SPDLOG_ASYNC_STAGING
+SPDLOG_INLINE size_t
+spdlog::async_logger::thread_pool_id_of_(const std::weak_ptr<details::thread_pool> &tp) {
+    auto pool_ptr = tp.lock();
+    return pool_ptr ? pool_ptr->id() : 0;
+}
+
+// stage the log message in this thread's ring of the thread pool
+SPDLOG_INLINE void spdlog::async_logger::sink_it_(const details::log_msg &msg) {
+    SPDLOG_TRY {
+        details::thread_pool::post_log_staged(thread_pool_id_, thread_pool_, *this, msg,
+                                              overflow_policy_);
+    }
+    SPDLOG_LOGGER_CATCH(msg.source)
+}
+#else
 // send the log message to the thread pool
 SPDLOG_INLINE void spdlog::async_logger::sink_it_(const details::log_msg &msg){
     SPDLOG_TRY{if (auto pool_ptr = thread_pool_.lock()){
@@ -41,6 +57,7 @@ else {
 }
 SPDLOG_LOGGER_CATCH(msg.source)
 }
+#endif
 
 // send flush request to the thread pool
 SPDLOG_INLINE void spdlog::async_logger::flush_(){
@@ -58,9 +75,10 @@ SPDLOG_LOGGER_CATCH(source_loc())
 // backend functions - called from the thread pool to do the actual job
 //
 SPDLOG_INLINE void spdlog::async_logger::backend_sink_it_(const details::log_msg &msg) {
+    details::binary_renderer render;
     for (auto &sink : sinks_) {
         if (sink->should_log(msg.level)) {
-            SPDLOG_TRY { sink->log(msg); }
+            SPDLOG_TRY { sink->log(render(msg, *sink)); }
             SPDLOG_LOGGER_CATCH(msg.source)
         }
     }
@@ -70,6 +88,23 @@ SPDLOG_INLINE void spdlog::async_logger::backend_sink_it_(const details::log_msg
     }
 }
 
+// sink a run of messages of this logger: each sink gets the whole run at once
+SPDLOG_INLINE void spdlog::async_logger::backend_sink_batch_(const details::log_msg *msgs,
+                                                             size_t n) {
+    details::binary_renderer render;
+    for (auto &sink : sinks_) {
+        SPDLOG_TRY { sink->log_batch(render(msgs, n, *sink), n); }
+        SPDLOG_LOGGER_CATCH(msgs[0].source)
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (should_flush_(msgs[i])) {
+            backend_flush_();
+            break;
+        }
+    }
+}
+
 SPDLOG_INLINE void spdlog::async_logger::backend_flush_() {
     for (auto &sink : sinks_) {
         SPDLOG_TRY { sink->flush(); }
@@ -43,7 +43,13 @@ public:
                  async_overflow_policy overflow_policy = async_overflow_policy::block)
         : logger(std::move(logger_name), begin, end),
           thread_pool_(std::move(tp)),
-          overflow_policy_(overflow_policy) {}
+          overflow_policy_(overflow_policy)
+#ifdef SPDLOG_ASYNC_STAGING
+          ,
+          thread_pool_id_(thread_pool_id_of_(thread_pool_))
+#endif
+    {
+    }
 
     async_logger(std::string logger_name,
                  sinks_init_list sinks_list,
@@ -61,11 +67,17 @@ protected:
     void sink_it_(const details::log_msg &msg) override;
     void flush_() override;
     void backend_sink_it_(const details::log_msg &incoming_log_msg);
+    void backend_sink_batch_(const details::log_msg *msgs, size_t n);
     void backend_flush_();
 
 private:
     std::weak_ptr<details::thread_pool> thread_pool_;
     async_overflow_policy overflow_policy_;
+#ifdef SPDLOG_ASYNC_STAGING
+    // identifies this logger's staging ring in the calling thread's ring list
+    size_t thread_pool_id_;
+    static size_t thread_pool_id_of_(const std::weak_ptr<details::thread_pool> &tp);
+#endif
 };
 }  // namespace spdlog
 
@@ -6,31 +6,152 @@
 #ifndef SPDLOG_HEADER_ONLY
     #include <spdlog/details/backtracer.h>
 #endif
+
+#include <spdlog/details/binary_format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
 namespace spdlog {
 namespace details {
-SPDLOG_INLINE backtracer::backtracer(const backtracer &other) {
+
+SPDLOG_INLINE void backtrace_ring::push(const log_msg &msg) {
+    // pairs with begin_read(): either the reader sees us busy and waits, or we
+    // see it reading and leave the slots alone
+    busy_.store(true, std::memory_order_seq_cst);
+    if (!reading_.load(std::memory_order_seq_cst)) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        char *slot = slot_(head);
+        size_t room = slot_size - sizeof(slot_header);
+
+        slot_header header;
+        header.level = msg.level;
+        header.time = msg.time;
+        header.thread_id = msg.thread_id;
+        header.source = msg.source;
+        header.binary = msg.binary;
+        header.name_size = static_cast<std::uint32_t>((std::min)(msg.logger_name.size(), room));
+        std::memcpy(slot + sizeof(header), msg.logger_name.data(), header.name_size);
+        room -= header.name_size;
+
+        string_view_t payload = msg.payload;
+#ifndef SPDLOG_USE_STD_FORMAT
+        memory_buf_t text;
+        if (msg.binary != nullptr && payload.size() > room) {
+            // raw arguments can't be cut: store them formatted instead
+            binary_render(*msg.binary, payload, text);
+            payload = string_view_t(text.data(), text.size());
+            header.binary = nullptr;
+        }
+#endif
+        char *dest = slot + sizeof(header) + header.name_size;
+        if (payload.size() > room) {
+            static const char ellipsis[] = "...";
+            size_t keep = room > 3 ? room - 3 : 0;
+            std::memcpy(dest, payload.data(), keep);
+            std::memcpy(dest + keep, ellipsis, room - keep);
+            header.payload_size = static_cast<std::uint32_t>(room);
+        } else {
+            std::memcpy(dest, payload.data(), payload.size());
+            header.payload_size = static_cast<std::uint32_t>(payload.size());
+        }
+        std::memcpy(slot, &header, sizeof(header));
+        head_.store(head + 1, std::memory_order_release);
+    }
+    busy_.store(false, std::memory_order_release);
+}
+
+SPDLOG_INLINE void backtrace_ring::begin_read() {
+    reading_.store(true, std::memory_order_seq_cst);
+    while (busy_.load(std::memory_order_seq_cst)) {
+        std::this_thread::yield();
+    }
+}
+
+SPDLOG_INLINE size_t backtrace_ring::copy_to(std::vector<char> &dest, bool consume) {
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t first = head - consumed_ > n_slots_ ? head - n_slots_ : consumed_;
+    for (size_t i = first; i < head; i++) {
+        const char *slot = slot_(i);
+        dest.insert(dest.end(), slot, slot + slot_size);
+    }
+    if (consume) {
+        consumed_ = head;
+    }
+    return head - first;
+}
+
+SPDLOG_INLINE log_msg backtrace_ring::read(const char *slot) {
+    slot_header header;
+    std::memcpy(&header, slot, sizeof(header));
+    const char *name = slot + sizeof(header);
+    log_msg msg;
+    msg.logger_name = string_view_t(name, header.name_size);
+    msg.level = header.level;
+    msg.time = header.time;
+    msg.thread_id = header.thread_id;
+    msg.source = header.source;
+    msg.payload = string_view_t(name + header.name_size, header.payload_size);
+    msg.binary = header.binary;
+    return msg;
+}
+
+SPDLOG_INLINE backtracer::backtracer()
+    : id_(next_id_()) {}
+
+SPDLOG_INLINE backtracer::~backtracer() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    reset_rings_();
+}
+
+SPDLOG_INLINE backtracer::backtracer(const backtracer &other)
+    : id_(next_id_()) {
+    std::vector<char> slots;
+    std::vector<const char *> order;
     std::lock_guard<std::mutex> lock(other.mutex_);
     enabled_ = other.enabled();
-    messages_ = other.messages_;
+    n_messages_ = other.n_messages_;
+    other.collect_(slots, order, false);
+    if (!order.empty()) {
+        // a ring of its own that no thread pushes to
+        auto ring = std::make_shared<backtrace_ring>(n_messages_);
+        for (auto slot : order) {
+            ring->push(backtrace_ring::read(slot));
+        }
+        ring->orphan();
+        rings_.push_back(std::move(ring));
+    }
 }
 
 SPDLOG_INLINE backtracer::backtracer(backtracer &&other) SPDLOG_NOEXCEPT {
     std::lock_guard<std::mutex> lock(other.mutex_);
     enabled_ = other.enabled();
-    messages_ = std::move(other.messages_);
+    n_messages_ = other.n_messages_;
+    // the threads find their rings by id, so they keep working with this object
+    id_ = other.id_;
+    rings_ = std::move(other.rings_);
+    other.id_ = next_id_();
+    other.n_messages_ = 0;
+    other.rings_.clear();
 }
 
 SPDLOG_INLINE backtracer &backtracer::operator=(backtracer other) {
     std::lock_guard<std::mutex> lock(mutex_);
+    reset_rings_();
     enabled_ = other.enabled();
-    messages_ = std::move(other.messages_);
+    n_messages_ = other.n_messages_;
+    std::swap(id_, other.id_);
+    rings_ = std::move(other.rings_);
+    other.rings_.clear();
     return *this;
 }
 
 SPDLOG_INLINE void backtracer::enable(size_t size) {
     std::lock_guard<std::mutex> lock{mutex_};
     enabled_.store(true, std::memory_order_relaxed);
-    messages_ = circular_q<log_msg_buffer>{size};
+    reset_rings_();
+    n_messages_ = size;
 }
 
 SPDLOG_INLINE void backtracer::disable() {
@@ -41,23 +162,173 @@ SPDLOG_INLINE void backtracer::disable() {
 SPDLOG_INLINE bool backtracer::enabled() const { return enabled_.load(std::memory_order_relaxed); }
 
 SPDLOG_INLINE void backtracer::push_back(const log_msg &msg) {
+#ifndef SPDLOG_NO_TLS
+    auto *ring = local_ring_();
+    if (ring != nullptr) {
+        ring->push(msg);
+    }
+#else
+    // no thread local rings: all threads share one, under the mutex
     std::lock_guard<std::mutex> lock{mutex_};
-    messages_.push_back(log_msg_buffer{msg});
+    if (rings_.empty()) {
+        if (n_messages_ == 0) {
+            return;
+        }
+        rings_.push_back(std::make_shared<backtrace_ring>(n_messages_));
+    }
+    rings_.back()->push(msg);
+#endif
 }
 
 SPDLOG_INLINE bool backtracer::empty() const {
     std::lock_guard<std::mutex> lock{mutex_};
-    return messages_.empty();
+    for (auto &ring : rings_) {
+        if (!ring->empty()) {
+            return false;
+        }
+    }
+    return true;
 }
 
 // pop all items in the q and apply the given fun on each of them.
 SPDLOG_INLINE void backtracer::foreach_pop(std::function<void(const details::log_msg &)> fun) {
+    std::vector<char> slots;
+    std::vector<const char *> order;
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        collect_(slots, order, true);
+        // the orphaned rings are all empty now
+        reclaim_orphans_();
+    }
+    for (auto slot : order) {
+        fun(backtrace_ring::read(slot));
+    }
+}
+
+#ifndef SPDLOG_NO_TLS
+// the ring of the calling thread, registered on its first message
+SPDLOG_INLINE backtrace_ring *backtracer::local_ring_() {
+    // orphans the rings of the thread when it exits
+    struct local_rings {
+        std::vector<std::pair<std::uint64_t, std::shared_ptr<backtrace_ring>>> entries;
+        ~local_rings() {
+            for (auto &entry : entries) {
+                entry.second->orphan();
+            }
+        }
+    };
+    static thread_local local_rings local;
+    for (auto &entry : local.entries) {
+        if (entry.first == id_ && !entry.second->detached()) {
+            return entry.second.get();
+        }
+    }
+
+    // forget the rings of backtracers that were destroyed or re-enabled
+    local.entries.erase(
+        std::remove_if(local.entries.begin(), local.entries.end(),
+                       [](const std::pair<std::uint64_t, std::shared_ptr<backtrace_ring>> &entry) {
+                           return entry.second->detached();
+                       }),
+        local.entries.end());
+    auto ring = add_ring_();
+    if (ring == nullptr) {
+        return nullptr;
+    }
+    local.entries.emplace_back(id_, ring);
+    return ring.get();
+}
+#endif
+
+SPDLOG_INLINE std::shared_ptr<backtrace_ring> backtracer::add_ring_() {
     std::lock_guard<std::mutex> lock{mutex_};
-    while (!messages_.empty()) {
-        auto &front_msg = messages_.front();
-        fun(front_msg);
-        messages_.pop_front();
+    if (!enabled() || n_messages_ == 0) {
+        return nullptr;
+    }
+    // threads come and go: drop the rings of the ones that exited before adding another
+    reclaim_orphans_();
+    auto ring = std::make_shared<backtrace_ring>(n_messages_);
+    rings_.push_back(ring);
+    return ring;
+}
+
+SPDLOG_INLINE std::uint64_t backtracer::next_id_() {
+    static std::atomic<std::uint64_t> id{0};
+    return id.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+SPDLOG_INLINE void backtracer::reset_rings_() {
+    for (auto &ring : rings_) {
+        ring->detach();
+    }
+    rings_.clear();
+}
+
+SPDLOG_INLINE void backtracer::reclaim_orphans_() {
+    size_t orphans = 0;
+    bool empty = true;
+    for (auto &ring : rings_) {
+        if (ring->orphaned()) {
+            orphans++;
+            empty = empty && ring->empty();
+        }
+    }
+    // a single orphan that still has messages is the shared ring already
+    if (orphans == 0 || (orphans == 1 && !empty)) {
+        return;
+    }
+
+    std::vector<char> slots;
+    for (auto &ring : rings_) {
+        if (ring->orphaned()) {
+            // no producer left, nothing to stop
+            ring->copy_to(slots, true);
+        }
     }
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                [](const std::shared_ptr<backtrace_ring> &ring) {
+                                    return ring->orphaned();
+                                }),
+                 rings_.end());
+    if (slots.empty()) {
+        return;
+    }
+
+    std::vector<const char *> order;
+    order_slots_(slots, order);
+    auto shared = std::make_shared<backtrace_ring>(n_messages_);
+    for (auto slot : order) {
+        shared->push(backtrace_ring::read(slot));
+    }
+    shared->orphan();
+    rings_.push_back(std::move(shared));
 }
+
+SPDLOG_INLINE void backtracer::collect_(std::vector<char> &slots,
+                                        std::vector<const char *> &order,
+                                        bool consume) const {
+    for (auto &ring : rings_) {
+        ring->begin_read();
+        ring->copy_to(slots, consume);
+        ring->end_read();
+    }
+    order_slots_(slots, order);
+}
+
+SPDLOG_INLINE void backtracer::order_slots_(std::vector<char> &slots,
+                                            std::vector<const char *> &order) const {
+    order.clear();
+    for (size_t pos = 0; pos < slots.size(); pos += backtrace_ring::slot_size) {
+        order.push_back(slots.data() + pos);
+    }
+    // each ring is in order already, stable_sort keeps it that way on equal times
+    std::stable_sort(order.begin(), order.end(), [](const char *a, const char *b) {
+        return backtrace_ring::read(a).time < backtrace_ring::read(b).time;
+    });
+    if (order.size() > n_messages_) {
+        order.erase(order.begin(), order.end() - static_cast<std::ptrdiff_t>(n_messages_));
+    }
+}
+
 }  // namespace details
 }  // namespace spdlog
@@ -3,25 +3,121 @@
 
 #pragma once
 
-#include <spdlog/details/circular_q.h>
-#include <spdlog/details/log_msg_buffer.h>
+#include <spdlog/details/log_msg.h>
 
 #include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <utility>
+#include <vector>
+
+#ifndef SPDLOG_BACKTRACE_SLOT_BYTES
+    #define SPDLOG_BACKTRACE_SLOT_BYTES 512
+#endif
 
 // Store log messages in circular buffer.
 // Useful for storing debug data in case of error/warning happens.
+//
+// Each thread that logs pushes into its own ring of preallocated fixed-size
+// slots (SPDLOG_BACKTRACE_SLOT_BYTES, longer messages are truncated), without
+// locking or allocating. Log messages are only rebuilt from the slots when the
+// backtrace is dumped: the rings are merged by time and the last n messages are
+// kept. When a thread exits its ring is orphaned; the backtracer frees it once it
+// is empty, or merges what is left into one shared ring of n slots, so memory
+// stays bounded by the number of live threads.
 
 namespace spdlog {
 namespace details {
+
+// the slots of one producer thread. push() is called by that thread only,
+// everything else by the backtracer under its mutex.
+class SPDLOG_API backtrace_ring {
+public:
+    static constexpr size_t slot_size = SPDLOG_BACKTRACE_SLOT_BYTES;
+
+    // slot layout: header, logger name, payload
+    struct slot_header {
+        level::level_enum level;
+        log_clock::time_point time;
+        size_t thread_id;
+        source_loc source;
+        const binary_format *binary;
+        std::uint32_t name_size;
+        std::uint32_t payload_size;
+    };
+
+    explicit backtrace_ring(size_t n_slots)
+        : n_slots_(n_slots),
+          slots_(new std::uint64_t[n_slots * slot_size / sizeof(std::uint64_t)]) {}
+
+    backtrace_ring(const backtrace_ring &) = delete;
+    backtrace_ring &operator=(const backtrace_ring &) = delete;
+
+    // messages pushed while the ring is being read are dropped
+    void push(const log_msg &msg);
+
+    // the rest is for the backtracer
+
+    // stop the producer and wait until it is out of push()
+    void begin_read();
+    void end_read() { reading_.store(false, std::memory_order_release); }
+
+    // copy the slots not consumed yet to dest, oldest first. returns their count.
+    size_t copy_to(std::vector<char> &dest, bool consume);
+
+    // the message stored in a slot copied by copy_to()
+    static log_msg read(const char *slot);
+
+    bool empty() const { return head_.load(std::memory_order_acquire) == consumed_; }
+
+    void detach() { detached_.store(true, std::memory_order_relaxed); }
+    bool detached() const { return detached_.load(std::memory_order_relaxed); }
+
+    // no thread pushes to the ring anymore (it exited, or the ring was built by the backtracer)
+    void orphan() { orphaned_.store(true, std::memory_order_release); }
+    bool orphaned() const { return orphaned_.load(std::memory_order_acquire); }
+
+private:
+    static_assert(slot_size > sizeof(slot_header) && slot_size % sizeof(std::uint64_t) == 0,
+                  "SPDLOG_BACKTRACE_SLOT_BYTES must be a multiple of 8 larger than the header");
+
+    char *slot_(size_t index) const {
+        return reinterpret_cast<char *>(slots_.get()) + (index % n_slots_) * slot_size;
+    }
+
+    const size_t n_slots_;
+    std::unique_ptr<std::uint64_t[]> slots_;
+    std::atomic<size_t> head_{0};  // messages pushed so far
+    size_t consumed_ = 0;          // messages popped by dumps
+    std::atomic<bool> busy_{false};
+    std::atomic<bool> reading_{false};
+    std::atomic<bool> detached_{false};
+    std::atomic<bool> orphaned_{false};
+};
+
 class SPDLOG_API backtracer {
     mutable std::mutex mutex_;
     std::atomic<bool> enabled_{false};
-    circular_q<log_msg_buffer> messages_;
+    size_t n_messages_ = 0;
+    std::uint64_t id_;
+    std::vector<std::shared_ptr<backtrace_ring>> rings_;
+
+    static std::uint64_t next_id_();
+    backtrace_ring *local_ring_();
+    std::shared_ptr<backtrace_ring> add_ring_();
+    void reset_rings_();
+    // free the orphaned rings, moving their messages into one shared ring
+    void reclaim_orphans_();
+    // the messages of all rings, oldest first, last n_messages_ at most
+    void collect_(std::vector<char> &slots, std::vector<const char *> &order, bool consume) const;
+    // sort copied slots by time and keep the last n_messages_
+    void order_slots_(std::vector<char> &slots, std::vector<const char *> &order) const;
 
 public:
-    backtracer() = default;
+    backtracer();
+    ~backtracer();
     backtracer(const backtracer &other);
 
     backtracer(backtracer &&other) SPDLOG_NOEXCEPT;
@@ -0,0 +1,453 @@
+// Copyright(c) 2015-present, Gabi Melman & spdlog contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+// Deferred formatting ("binary" log records), see SPDLOG_LOGGER_BINARY.
+//
+// The producer doesn't run fmt. It records which call site logged (a
+// binary_format, one static per call site) and copies the raw argument bytes
+// into the payload. Formatting happens only where text is needed: in the
+// logger for text sinks (in the worker thread for async loggers), or offline
+// when decoding a file written by binary_file_sink.
+//
+// Payload layout, in host byte order, one field per argument:
+//   i: int64   u: uint64   d: double   b, c: 1 byte   p: uint64
+//   s: uint32 length followed by the bytes
+
+#include <spdlog/common.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/sink.h>
+
+// not available with std::format, which has no dynamic argument store
+#if defined(SPDLOG_USE_STD_FORMAT)
+#elif !defined(SPDLOG_FMT_EXTERNAL)
+    #ifdef SPDLOG_HEADER_ONLY
+        #ifndef FMT_HEADER_ONLY
+            #define FMT_HEADER_ONLY
+        #endif
+    #endif
+    #include <spdlog/fmt/bundled/args.h>
+#else
+    #include <fmt/args.h>
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace spdlog {
+namespace details {
+
+// one per call site, filled in on its first use
+struct binary_format {
+    std::atomic<bool> ready{false};
+    std::uint64_t id{0};  // hash of the format string and the argument types
+    string_view_t format;
+    const char *signature{nullptr};  // one type tag per argument
+    source_loc source;
+
+    void init(string_view_t fmt, const char *sig, source_loc loc) {
+        static std::mutex init_mutex;
+        std::lock_guard<std::mutex> lock(init_mutex);
+        if (ready.load(std::memory_order_relaxed)) {
+            return;
+        }
+        // FNV-1a
+        std::uint64_t h = 14695981039346656037ull;
+        for (size_t i = 0; i < fmt.size(); i++) {
+            h = (h ^ static_cast<unsigned char>(fmt.data()[i])) * 1099511628211ull;
+        }
+        for (const char *p = sig; *p; p++) {
+            h = (h ^ static_cast<unsigned char>(*p)) * 1099511628211ull;
+        }
+        id = h;
+        format = fmt;
+        signature = sig;
+        source = loc;
+        ready.store(true, std::memory_order_release);
+    }
+};
+
+inline void binary_put(memory_buf_t &buf, const void *data, size_t size) {
+    auto p = static_cast<const char *>(data);
+    buf.append(p, p + size);
+}
+
+template <typename T>
+void binary_put(memory_buf_t &buf, T value) {
+    binary_put(buf, &value, sizeof(value));
+}
+
+inline void binary_put_string(memory_buf_t &buf, const char *data, size_t size) {
+    binary_put(buf, static_cast<std::uint32_t>(size));
+    binary_put(buf, data, size);
+}
+
+inline void binary_put_varint(memory_buf_t &buf, std::uint64_t value) {
+    char tmp[10];
+    size_t n = 0;
+    while (value >= 0x80) {
+        tmp[n++] = static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    tmp[n++] = static_cast<char>(value);
+    buf.append(tmp, tmp + n);
+}
+
+inline std::uint64_t binary_zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t binary_unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+// bounds checked reads from a binary payload or file
+class binary_cursor {
+public:
+    binary_cursor(const char *begin, const char *end)
+        : pos_(begin),
+          end_(end) {}
+
+    bool at_end() const { return pos_ == end_; }
+    const char *pos() const { return pos_; }
+
+    const char *take(size_t size) {
+        if (static_cast<size_t>(end_ - pos_) < size) {
+            throw_spdlog_ex("binary log: truncated record");
+        }
+        const char *p = pos_;
+        pos_ += size;
+        return p;
+    }
+
+    template <typename T>
+    T get() {
+        T value;
+        std::memcpy(&value, take(sizeof(value)), sizeof(value));
+        return value;
+    }
+
+    std::uint64_t get_varint() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            auto byte = static_cast<unsigned char>(*take(1));
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw_spdlog_ex("binary log: bad varint");
+        return 0;
+    }
+
+    string_view_t get_string() {
+        auto size = get<std::uint32_t>();
+        return string_view_t(take(size), size);
+    }
+
+    string_view_t get_varint_string() {
+        auto size = static_cast<size_t>(get_varint());
+        return string_view_t(take(size), size);
+    }
+
+private:
+    const char *pos_;
+    const char *end_;
+};
+
+//
+// argument types
+//
+template <typename T, typename Enable = void>
+struct binary_arg {
+    static_assert(sizeof(T) == 0,
+                  "binary logging supports integers, floating point, bool, char, strings and "
+                  "pointers");
+};
+
+template <>
+struct binary_arg<bool> {
+    static constexpr char tag = 'b';
+    static void encode(memory_buf_t &buf, bool value) {
+        binary_put(buf, static_cast<char>(value ? 1 : 0));
+    }
+};
+
+template <>
+struct binary_arg<char> {
+    static constexpr char tag = 'c';
+    static void encode(memory_buf_t &buf, char value) { binary_put(buf, value); }
+};
+
+template <typename T>
+struct binary_arg<T,
+                  typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value &&
+                                          !std::is_same<T, char>::value>::type> {
+    static constexpr char tag = 'i';
+    static void encode(memory_buf_t &buf, T value) {
+        binary_put(buf, static_cast<std::int64_t>(value));
+    }
+};
+
+template <typename T>
+struct binary_arg<T,
+                  typename std::enable_if<std::is_integral<T>::value &&
+                                          std::is_unsigned<T>::value &&
+                                          !std::is_same<T, bool>::value &&
+                                          !std::is_same<T, char>::value>::type> {
+    static constexpr char tag = 'u';
+    static void encode(memory_buf_t &buf, T value) {
+        binary_put(buf, static_cast<std::uint64_t>(value));
+    }
+};
+
+template <typename T>
+struct binary_arg<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    static constexpr char tag = 'd';
+    static void encode(memory_buf_t &buf, T value) { binary_put(buf, static_cast<double>(value)); }
+};
+
+template <typename T>
+struct binary_arg<T,
+                  typename std::enable_if<std::is_same<T, const char *>::value ||
+                                          std::is_same<T, char *>::value>::type> {
+    static constexpr char tag = 's';
+    static void encode(memory_buf_t &buf, const char *value) {
+        binary_put_string(buf, value, value ? std::strlen(value) : 0);
+    }
+};
+
+template <typename T>
+struct binary_arg<T,
+                  typename std::enable_if<std::is_same<T, std::string>::value ||
+                                          std::is_same<T, string_view_t>::value
+#ifdef __cpp_lib_string_view
+                                          || std::is_same<T, std::string_view>::value
+#endif
+                                          >::type> {
+    static constexpr char tag = 's';
+    static void encode(memory_buf_t &buf, const T &value) {
+        binary_put_string(buf, value.data(), value.size());
+    }
+};
+
+template <typename T>
+struct binary_arg<T,
+                  typename std::enable_if<std::is_pointer<T>::value &&
+                                          !std::is_same<T, const char *>::value &&
+                                          !std::is_same<T, char *>::value>::type> {
+    static constexpr char tag = 'p';
+    static void encode(memory_buf_t &buf, T value) {
+        binary_put(buf, static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(value)));
+    }
+};
+
+template <typename T>
+using binary_arg_t = binary_arg<typename std::decay<T>::type>;
+
+template <typename... Args>
+struct binary_signature {
+    static const char *tags() {
+        static const char value[] = {binary_arg_t<Args>::tag..., '\0'};
+        return value;
+    }
+};
+
+template <typename... Args>
+void binary_encode(memory_buf_t &buf, const Args &...args) {
+    int expand[] = {0, (binary_arg_t<Args>::encode(buf, args), 0)...};
+    (void)expand;
+}
+
+// file layout written by binary_file_sink, see sinks/binary_file_sink.h
+struct binary_log_file {
+    static constexpr size_t magic_size = 8;
+    static const char *magic() { return "SPDLOGB1"; }
+
+    enum record_kind : char {
+        format_record = 1,
+        logger_record = 2,
+        binary_record = 3,
+        text_record = 4
+    };
+};
+
+// storage form used by binary_file_sink: integers become varints
+inline void binary_compact(const char *signature, string_view_t payload, memory_buf_t &dest) {
+    binary_cursor in(payload.data(), payload.data() + payload.size());
+    for (const char *tag = signature; *tag; tag++) {
+        switch (*tag) {
+            case 'i':
+                binary_put_varint(dest, binary_zigzag(in.get<std::int64_t>()));
+                break;
+            case 'u':
+            case 'p':
+                binary_put_varint(dest, in.get<std::uint64_t>());
+                break;
+            case 's': {
+                auto s = in.get_string();
+                binary_put_varint(dest, s.size());
+                binary_put(dest, s.data(), s.size());
+                break;
+            }
+            case 'd':
+                binary_put(dest, in.take(sizeof(double)), sizeof(double));
+                break;
+            default:
+                binary_put(dest, in.take(1), 1);
+                break;
+        }
+    }
+}
+
+// inverse of binary_compact, reading one record's arguments from in
+inline void binary_expand(const char *signature, binary_cursor &in, memory_buf_t &dest) {
+    for (const char *tag = signature; *tag; tag++) {
+        switch (*tag) {
+            case 'i':
+                binary_put(dest, binary_unzigzag(in.get_varint()));
+                break;
+            case 'u':
+            case 'p':
+                binary_put(dest, in.get_varint());
+                break;
+            case 's': {
+                auto s = in.get_varint_string();
+                binary_put_string(dest, s.data(), s.size());
+                break;
+            }
+            case 'd':
+                binary_put(dest, in.take(sizeof(double)), sizeof(double));
+                break;
+            default:
+                binary_put(dest, in.take(1), 1);
+                break;
+        }
+    }
+}
+
+#ifndef SPDLOG_USE_STD_FORMAT
+//
+// formatting
+//
+
+// format the recorded arguments into dest
+inline void binary_render(const binary_format &format, string_view_t payload, memory_buf_t &dest) {
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    binary_cursor in(payload.data(), payload.data() + payload.size());
+    for (const char *tag = format.signature; *tag; tag++) {
+        switch (*tag) {
+            case 'i':
+                store.push_back(in.get<std::int64_t>());
+                break;
+            case 'u':
+                store.push_back(in.get<std::uint64_t>());
+                break;
+            case 'd':
+                store.push_back(in.get<double>());
+                break;
+            case 'b':
+                store.push_back(in.get<char>() != 0);
+                break;
+            case 'c':
+                store.push_back(in.get<char>());
+                break;
+            case 's':
+                store.push_back(in.get_string());
+                break;
+            case 'p':
+                store.push_back(reinterpret_cast<const void *>(
+                    static_cast<std::uintptr_t>(in.get<std::uint64_t>())));
+                break;
+            default:
+                throw_spdlog_ex("binary log: unknown argument type");
+        }
+    }
+    fmt::vformat_to(fmt::appender(dest), fmt::string_view(format.format.data(), format.format.size()),
+                    store);
+}
+
+// hands a sink either the message as is or, if the message is a binary
+// record and the sink can't store those, a copy with the payload formatted
+// to text. the formatting is done at most once per message (or batch).
+class binary_renderer {
+public:
+    const log_msg &operator()(const log_msg &msg, const sinks::sink &sink) {
+        if (msg.binary == nullptr || sink.accepts_binary()) {
+            return msg;
+        }
+        if (rendered_from_ != &msg) {
+            text_.clear();
+            binary_render(*msg.binary, msg.payload, text_);
+            rendered_ = msg;
+            rendered_.binary = nullptr;
+            rendered_.payload = string_view_t(text_.data(), text_.size());
+            rendered_from_ = &msg;
+            batch_from_ = nullptr;
+        }
+        return rendered_;
+    }
+
+    const log_msg *operator()(const log_msg *msgs, size_t n, const sinks::sink &sink) {
+        if (sink.accepts_binary()) {
+            return msgs;
+        }
+        if (batch_from_ == msgs) {
+            return batch_.data();
+        }
+        bool any_binary = false;
+        for (size_t i = 0; i < n && !any_binary; i++) {
+            any_binary = msgs[i].binary != nullptr;
+        }
+        if (!any_binary) {
+            return msgs;
+        }
+
+        // offsets first: text_ may grow while rendering
+        text_.clear();
+        offsets_.clear();
+        batch_.assign(msgs, msgs + n);
+        for (size_t i = 0; i < n; i++) {
+            offsets_.push_back(text_.size());
+            if (msgs[i].binary != nullptr) {
+                binary_render(*msgs[i].binary, msgs[i].payload, text_);
+            }
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (batch_[i].binary != nullptr) {
+                size_t end = i + 1 < n ? offsets_[i + 1] : text_.size();
+                batch_[i].payload = string_view_t(text_.data() + offsets_[i], end - offsets_[i]);
+                batch_[i].binary = nullptr;
+            }
+        }
+        batch_from_ = msgs;
+        rendered_from_ = nullptr;
+        return batch_.data();
+    }
+
+private:
+    memory_buf_t text_;
+    log_msg rendered_;
+    const log_msg *rendered_from_ = nullptr;
+    std::vector<log_msg> batch_;
+    std::vector<size_t> offsets_;
+    const log_msg *batch_from_ = nullptr;
+};
+
+#else
+// nothing to render: binary records can't be produced with std::format
+class binary_renderer {
+public:
+    const log_msg &operator()(const log_msg &msg, const sinks::sink &) { return msg; }
+    const log_msg *operator()(const log_msg *msgs, size_t, const sinks::sink &) { return msgs; }
+};
+#endif
+
+}  // namespace details
+}  // namespace spdlog
@@ -0,0 +1,197 @@
+// Copyright(c) 2015-present, Gabi Melman & spdlog contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+// Reads back the files written by sinks::binary_file_sink, formatting the
+// deferred records on the way:
+//
+//   spdlog::details::binary_log_reader reader("logs/app.bin");
+//   spdlog::details::log_msg msg;
+//   while (reader.next(msg)) {
+//       formatter.format(msg, dest);
+//   }
+//
+// Throws spdlog_ex on malformed input.
+
+#include <spdlog/details/binary_format.h>
+#include <spdlog/details/os.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace spdlog {
+namespace details {
+
+class binary_log_reader {
+public:
+    explicit binary_log_reader(const filename_t &filename) {
+        FILE *fd = nullptr;
+        if (os::fopen_s(&fd, filename, SPDLOG_FILENAME_T("rb"))) {
+            throw_spdlog_ex("binary log: failed opening file " + os::filename_to_str(filename),
+                            errno);
+        }
+        data_.resize(os::filesize(fd));
+        size_t read = data_.empty() ? 0 : std::fread(&data_[0], 1, data_.size(), fd);
+        std::fclose(fd);
+        if (read != data_.size()) {
+            throw_spdlog_ex("binary log: failed reading file " + os::filename_to_str(filename));
+        }
+        pos_ = data_.data();
+    }
+
+    // the next log record, with its payload formatted to text. msg stays
+    // valid until the next call.
+    bool next(log_msg &msg) {
+        binary_cursor in(pos_, data_.data() + data_.size());
+        for (;;) {
+            if (in.at_end()) {
+                pos_ = in.pos();
+                return false;
+            }
+            char kind = *in.take(1);
+            if (kind == binary_log_file::magic()[0]) {
+                start_session_(in);
+                continue;
+            }
+            if (!in_session_) {
+                throw_spdlog_ex("binary log: not a binary log file");
+            }
+            switch (kind) {
+                case binary_log_file::format_record:
+                    read_format_(in);
+                    break;
+                case binary_log_file::logger_record:
+                    read_logger_(in);
+                    break;
+                case binary_log_file::binary_record:
+                case binary_log_file::text_record:
+                    read_record_(kind, in, msg);
+                    pos_ = in.pos();
+                    return true;
+                default:
+                    throw_spdlog_ex("binary log: unknown record");
+            }
+        }
+    }
+
+private:
+    std::string data_;
+    const char *pos_ = nullptr;
+    bool in_session_ = false;
+    std::int64_t last_time_ = 0;
+    std::vector<std::unique_ptr<binary_format>> formats_;
+    std::vector<string_view_t> loggers_;
+    std::deque<std::string> strings_;  // nul terminated copies for the formats' source_loc
+    std::string text_file_;
+    std::string text_func_;
+    memory_buf_t args_;
+    memory_buf_t text_;
+
+    // the sink starts over (new dictionaries, absolute time) each time it
+    // opens the file
+    void start_session_(binary_cursor &in) {
+        const char *magic = in.pos() - 1;
+        in.take(binary_log_file::magic_size - 1);
+        if (std::memcmp(magic, binary_log_file::magic(), binary_log_file::magic_size) != 0) {
+            throw_spdlog_ex("binary log: bad magic");
+        }
+        in_session_ = true;
+        last_time_ = 0;
+        formats_.clear();
+        loggers_.clear();
+    }
+
+    const char *keep_(string_view_t s) {
+        strings_.emplace_back(s.data(), s.size());
+        return strings_.back().c_str();
+    }
+
+    void read_format_(binary_cursor &in) {
+        if (in.get_varint() != formats_.size()) {
+            throw_spdlog_ex("binary log: format out of order");
+        }
+        auto id = in.get<std::uint64_t>();
+        auto fmt = in.get_varint_string();
+        auto signature = keep_(in.get_varint_string());
+        source_loc loc;
+        auto filename = in.get_varint_string();
+        loc.filename = filename.size() > 0 ? keep_(filename) : nullptr;
+        loc.line = static_cast<int>(in.get_varint());
+        auto funcname = in.get_varint_string();
+        loc.funcname = funcname.size() > 0 ? keep_(funcname) : nullptr;
+
+        std::unique_ptr<binary_format> format(new binary_format());
+        format->init(fmt, signature, loc);
+        if (format->id != id) {
+            throw_spdlog_ex("binary log: format id mismatch");
+        }
+        formats_.push_back(std::move(format));
+    }
+
+    void read_logger_(binary_cursor &in) {
+        if (in.get_varint() != loggers_.size()) {
+            throw_spdlog_ex("binary log: logger out of order");
+        }
+        loggers_.push_back(in.get_varint_string());
+    }
+
+    void read_record_(char kind, binary_cursor &in, log_msg &msg) {
+        const binary_format *format = nullptr;
+        if (kind == binary_log_file::binary_record) {
+            auto index = in.get_varint();
+            if (index >= formats_.size()) {
+                throw_spdlog_ex("binary log: unknown format");
+            }
+            format = formats_[static_cast<size_t>(index)].get();
+        }
+        auto logger_index = in.get_varint();
+        if (logger_index >= loggers_.size()) {
+            throw_spdlog_ex("binary log: unknown logger");
+        }
+        auto level = static_cast<unsigned char>(*in.take(1));
+        if (level >= level::n_levels) {
+            throw_spdlog_ex("binary log: bad level");
+        }
+        last_time_ += binary_unzigzag(in.get_varint());
+
+        msg = log_msg();
+        msg.logger_name = loggers_[static_cast<size_t>(logger_index)];
+        msg.level = static_cast<level::level_enum>(level);
+        msg.time = log_clock::time_point(std::chrono::duration_cast<log_clock::duration>(
+            std::chrono::nanoseconds(last_time_)));
+        msg.thread_id = static_cast<size_t>(in.get_varint());
+
+        if (format != nullptr) {
+            args_.clear();
+            binary_expand(format->signature, in, args_);
+            text_.clear();
+#ifndef SPDLOG_USE_STD_FORMAT
+            binary_render(*format, string_view_t(args_.data(), args_.size()), text_);
+#else
+            throw_spdlog_ex("binary log: deferred records need fmt");
+#endif
+            msg.source = format->source;
+            msg.payload = string_view_t(text_.data(), text_.size());
+        } else {
+            auto filename = in.get_varint_string();
+            text_file_.assign(filename.data(), filename.size());
+            msg.source.filename = filename.size() > 0 ? text_file_.c_str() : nullptr;
+            msg.source.line = static_cast<int>(in.get_varint());
+            auto funcname = in.get_varint_string();
+            text_func_.assign(funcname.data(), funcname.size());
+            msg.source.funcname = funcname.size() > 0 ? text_func_.c_str() : nullptr;
+            msg.payload = in.get_varint_string();
+        }
+    }
+};
+
+}  // namespace details
+}  // namespace spdlog
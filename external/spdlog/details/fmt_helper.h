@@ -3,6 +3,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstring>
 #include <iterator>
 #include <spdlog/common.h>
 #include <spdlog/fmt/fmt.h>
@@ -18,9 +19,14 @@ namespace spdlog {
 namespace details {
 namespace fmt_helper {
 
+// memcpy rather than memory_buf_t::append(), which copies char by char
 inline void append_string_view(spdlog::string_view_t view, memory_buf_t &dest) {
-    auto *buf_ptr = view.data();
-    dest.append(buf_ptr, buf_ptr + view.size());
+    if (view.size() == 0) {
+        return;
+    }
+    size_t size = dest.size();
+    dest.resize(size + view.size());
+    std::memcpy(dest.data() + size, view.data(), view.size());
 }
 
 #ifdef SPDLOG_USE_STD_FORMAT
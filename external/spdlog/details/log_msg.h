@@ -8,6 +8,8 @@
 
 namespace spdlog {
 namespace details {
+struct binary_format;
+
 struct SPDLOG_API log_msg {
     log_msg() = default;
     log_msg(log_clock::time_point log_time,
@@ -31,6 +33,10 @@ struct SPDLOG_API log_msg {
 
     source_loc source;
     string_view_t payload;
+
+    // set for deferred formatting records: payload holds the raw arguments of
+    // this call site's format string instead of text (see details/binary_format.h)
+    const binary_format *binary{nullptr};
 };
 }  // namespace details
 }  // namespace spdlog
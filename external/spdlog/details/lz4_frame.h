@@ -0,0 +1,263 @@
+// Copyright(c) 2015-present, Gabi Melman & spdlog contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+// Minimal LZ4 compressor writing the standard LZ4 frame format, so the output
+// can be read back with the lz4 command line tool (lz4 -d). Used by
+// compressed_rotating_file_sink to compress rotated files.
+//
+// The block compressor is the plain greedy LZ4 algorithm with a 4K-entry hash
+// table: it is fast and gets text logs down to roughly a quarter to a fifth.
+
+#include <spdlog/common.h>
+#include <spdlog/details/os.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace spdlog {
+namespace details {
+
+class lz4_frame {
+public:
+    static constexpr size_t block_size = 4 * 1024 * 1024;  // block maximum size id 7
+
+    // compress src_filename into dest_filename.
+    // returns the size of the compressed file, and sets src_size if given.
+    static size_t compress_file(const filename_t &src_filename,
+                                const filename_t &dest_filename,
+                                size_t *src_size = nullptr) {
+        file_ptr src = open_(src_filename, SPDLOG_FILENAME_T("rb"));
+        file_ptr dest = open_(dest_filename, SPDLOG_FILENAME_T("wb"));
+
+        std::vector<char> in(block_size);
+        std::vector<char> out(4 + max_compressed_size(block_size));
+        std::vector<std::uint16_t> table(hash_size);
+
+        // magic, FLG (version 01, independent blocks), BD (4MB blocks), header checksum
+        unsigned char header[7] = {0x04, 0x22, 0x4d, 0x18, 0x60, 0x70, 0};
+        header[6] = static_cast<unsigned char>((xxh32(header + 4, 2, 0) >> 8) & 0xff);
+        size_t written = write_(dest, header, sizeof(header), dest_filename);
+        size_t read = 0;
+
+        for (;;) {
+            size_t n = std::fread(in.data(), 1, in.size(), src.get());
+            if (n == 0) {
+                if (std::ferror(src.get())) {
+                    throw_spdlog_ex("lz4: failed reading " + os::filename_to_str(src_filename),
+                                    errno);
+                }
+                break;
+            }
+            read += n;
+            size_t size = compress_block(in.data(), n, out.data() + 4, table);
+            std::uint32_t block_header = static_cast<std::uint32_t>(size);
+            if (size >= n) {
+                // incompressible: store as is
+                std::memcpy(out.data() + 4, in.data(), n);
+                size = n;
+                block_header = static_cast<std::uint32_t>(n) | 0x80000000u;
+            }
+            put_le32_(out.data(), block_header);
+            written += write_(dest, out.data(), 4 + size, dest_filename);
+        }
+
+        char end_mark[4] = {0, 0, 0, 0};
+        written += write_(dest, end_mark, sizeof(end_mark), dest_filename);
+        if (std::fflush(dest.get()) != 0) {
+            throw_spdlog_ex("lz4: failed writing " + os::filename_to_str(dest_filename), errno);
+        }
+        if (src_size != nullptr) {
+            *src_size = read;
+        }
+        return written;
+    }
+
+    static size_t max_compressed_size(size_t n) { return n + n / 255 + 16; }
+
+    // LZ4 block format. dest must hold max_compressed_size(n) bytes.
+    // returns the compressed size.
+    static size_t compress_block(const char *src,
+                                 size_t n,
+                                 char *dest,
+                                 std::vector<std::uint16_t> &table) {
+        // the last match must start 12 bytes before the end and the last 5 bytes
+        // are always literals
+        const size_t mf_limit = 12;
+        const size_t last_literals = 5;
+        const size_t min_match = 4;
+
+        char *op = dest;
+        size_t anchor = 0;
+        if (n > mf_limit) {
+            // positions are kept relative to a base that moves every 64K so
+            // that 16 bit entries suffice
+            std::fill(table.begin(), table.end(), std::uint16_t(0));
+            size_t base = 0;
+            size_t ip = 1;
+            const size_t match_limit = n - last_literals;
+            const size_t ip_limit = n - mf_limit;
+            while (ip < ip_limit) {
+                if (ip - base >= 0x10000) {
+                    std::fill(table.begin(), table.end(), std::uint16_t(0));
+                    base = ip;
+                }
+                std::uint32_t seq = read32_(src + ip);
+                std::uint32_t h = hash_(seq);
+                size_t ref = base + table[h];
+                table[h] = static_cast<std::uint16_t>(ip - base);
+                if (ref >= ip || ip - ref > 0xffff || read32_(src + ref) != seq) {
+                    ip++;
+                    continue;
+                }
+
+                // extend the match backwards over pending literals, then forwards
+                while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+                    ip--;
+                    ref--;
+                }
+                size_t len = min_match;
+                while (ip + len < match_limit && src[ip + len] == src[ref + len]) {
+                    len++;
+                }
+
+                op = put_sequence_(op, src + anchor, ip - anchor, ip - ref, len - min_match);
+                ip += len;
+                anchor = ip;
+            }
+        }
+
+        // last literals
+        size_t literals = n - anchor;
+        op = put_length_(op, literals, 4);
+        std::memcpy(op, src + anchor, literals);
+        op += literals;
+        return static_cast<size_t>(op - dest);
+    }
+
+    static std::uint32_t xxh32(const void *input, size_t len, std::uint32_t seed) {
+        const std::uint32_t p1 = 2654435761u, p2 = 2246822519u, p3 = 3266489917u,
+                            p4 = 668265263u, p5 = 374761393u;
+        const unsigned char *p = static_cast<const unsigned char *>(input);
+        const unsigned char *end = p + len;
+        std::uint32_t h;
+        if (len >= 16) {
+            std::uint32_t v1 = seed + p1 + p2, v2 = seed + p2, v3 = seed, v4 = seed - p1;
+            for (; p + 16 <= end; p += 16) {
+                v1 = rotl_(v1 + read32_(p) * p2, 13) * p1;
+                v2 = rotl_(v2 + read32_(p + 4) * p2, 13) * p1;
+                v3 = rotl_(v3 + read32_(p + 8) * p2, 13) * p1;
+                v4 = rotl_(v4 + read32_(p + 12) * p2, 13) * p1;
+            }
+            h = rotl_(v1, 1) + rotl_(v2, 7) + rotl_(v3, 12) + rotl_(v4, 18);
+        } else {
+            h = seed + p5;
+        }
+        h += static_cast<std::uint32_t>(len);
+        for (; p + 4 <= end; p += 4) {
+            h = rotl_(h + read32_(p) * p3, 17) * p4;
+        }
+        for (; p < end; p++) {
+            h = rotl_(h + *p * p5, 11) * p1;
+        }
+        h ^= h >> 15;
+        h *= p2;
+        h ^= h >> 13;
+        h *= p3;
+        h ^= h >> 16;
+        return h;
+    }
+
+private:
+    static constexpr size_t hash_log = 12;
+    static constexpr size_t hash_size = size_t(1) << hash_log;
+
+    struct file_closer {
+        void operator()(std::FILE *fd) const { std::fclose(fd); }
+    };
+    using file_ptr = std::unique_ptr<std::FILE, file_closer>;
+
+    static file_ptr open_(const filename_t &filename, const filename_t &mode) {
+        std::FILE *fd = nullptr;
+        if (os::fopen_s(&fd, filename, mode)) {
+            throw_spdlog_ex("lz4: failed opening " + os::filename_to_str(filename), errno);
+        }
+        return file_ptr(fd);
+    }
+
+    static size_t write_(const file_ptr &fd,
+                         const void *data,
+                         size_t size,
+                         const filename_t &filename) {
+        if (std::fwrite(data, 1, size, fd.get()) != size) {
+            throw_spdlog_ex("lz4: failed writing " + os::filename_to_str(filename), errno);
+        }
+        return size;
+    }
+
+    static std::uint32_t read32_(const void *p) {
+        // the frame format is little endian; so are the hash inputs, which only
+        // need to be consistent
+        const unsigned char *b = static_cast<const unsigned char *>(p);
+        return std::uint32_t(b[0]) | std::uint32_t(b[1]) << 8 | std::uint32_t(b[2]) << 16 |
+               std::uint32_t(b[3]) << 24;
+    }
+
+    static void put_le32_(char *p, std::uint32_t v) {
+        for (int i = 0; i < 4; i++) {
+            p[i] = static_cast<char>((v >> (8 * i)) & 0xff);
+        }
+    }
+
+    static std::uint32_t rotl_(std::uint32_t v, int r) { return (v << r) | (v >> (32 - r)); }
+
+    static std::uint32_t hash_(std::uint32_t seq) {
+        return (seq * 2654435761u) >> (32 - hash_log);
+    }
+
+    // token nibble at shift, then the 255-continued remainder
+    static char *put_length_(char *op, size_t len, int shift) {
+        if (len < 15) {
+            *op++ = static_cast<char>(len << shift);
+            return op;
+        }
+        *op++ = static_cast<char>(15 << shift);
+        len -= 15;
+        for (; len >= 255; len -= 255) {
+            *op++ = static_cast<char>(255);
+        }
+        *op++ = static_cast<char>(len);
+        return op;
+    }
+
+    static char *put_sequence_(
+        char *op, const char *literals, size_t n_literals, size_t offset, size_t match_len) {
+        char *token = op;
+        op = put_length_(op, n_literals, 4);
+        std::memcpy(op, literals, n_literals);
+        op += n_literals;
+        *op++ = static_cast<char>(offset & 0xff);
+        *op++ = static_cast<char>(offset >> 8);
+        if (match_len < 15) {
+            *token = static_cast<char>(*token | match_len);
+        } else {
+            *token = static_cast<char>(*token | 15);
+            match_len -= 15;
+            for (; match_len >= 255; match_len -= 255) {
+                *op++ = static_cast<char>(255);
+            }
+            *op++ = static_cast<char>(match_len);
+        }
+        return op;
+    }
+};
+
+}  // namespace details
+}  // namespace spdlog
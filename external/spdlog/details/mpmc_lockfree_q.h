@@ -0,0 +1,235 @@
+// Copyright(c) 2015-present, Gabi Melman & spdlog contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+// lock-free bounded multi producer-multi consumer queue.
+// drop-in alternative to mpmc_blocking_queue (same interface), selected by
+// defining SPDLOG_LOCKFREE_QUEUE (see tweakme.h).
+//
+// each slot carries a sequence number (Dmitry Vyukov's bounded MPMC design):
+// a producer claims position pos by CAS on the enqueue position when the slot's
+// sequence equals pos, writes the item and publishes it by storing pos + 1.
+// a consumer claims pos when the sequence equals pos + 1, moves the item out and
+// frees the slot for the next lap by storing pos + capacity.
+// producers and consumers only contend on their own position counter and never
+// take a lock on the fast path.
+//
+// waiting (consumer on empty queue, producer on full queue with the block
+// policy) spins briefly, then yields, then parks on a condition variable. the
+// mutex is only touched when some thread is actually parked.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spdlog {
+namespace details {
+
+template <typename T>
+class mpmc_lockfree_queue {
+public:
+    using item_type = T;
+    explicit mpmc_lockfree_queue(size_t max_items)
+        : capacity_(max_items > 0 ? max_items : 1),
+          slots_(capacity_) {
+        for (size_t i = 0; i < capacity_; i++) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpmc_lockfree_queue(const mpmc_lockfree_queue &) = delete;
+    mpmc_lockfree_queue &operator=(const mpmc_lockfree_queue &) = delete;
+
+    // try to enqueue and block if no room left
+    void enqueue(T &&item) {
+        if (try_enqueue_(item)) {
+            wake_consumer_();
+            return;
+        }
+        wait_(producers_waiting_, pop_cv_, [this, &item] { return try_enqueue_(item); },
+              std::chrono::steady_clock::time_point::max());
+        wake_consumer_();
+    }
+
+    // enqueue immediately. overrun oldest message in the queue if no room left.
+    void enqueue_nowait(T &&item) {
+        while (!try_enqueue_(item)) {
+            T dropped;
+            if (try_dequeue_(dropped)) {
+                overrun_counter_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        wake_consumer_();
+    }
+
+    void enqueue_if_have_room(T &&item) {
+        if (try_enqueue_(item)) {
+            wake_consumer_();
+        } else {
+            discard_counter_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // dequeue with a timeout.
+    // Return true, if succeeded dequeue item, false otherwise
+    bool dequeue_for(T &popped_item, std::chrono::milliseconds wait_duration) {
+        if (!try_dequeue_(popped_item)) {
+            if (wait_duration.count() <= 0) {
+                return false;
+            }
+            auto deadline = std::chrono::steady_clock::now() + wait_duration;
+            if (!wait_(consumers_waiting_, push_cv_,
+                       [this, &popped_item] { return try_dequeue_(popped_item); }, deadline)) {
+                return false;
+            }
+        }
+        wake_producer_();
+        return true;
+    }
+
+    // blocking dequeue without a timeout.
+    void dequeue(T &popped_item) {
+        if (!try_dequeue_(popped_item)) {
+            wait_(consumers_waiting_, push_cv_, [this, &popped_item] { return try_dequeue_(popped_item); },
+                  std::chrono::steady_clock::time_point::max());
+        }
+        wake_producer_();
+    }
+
+    size_t overrun_counter() { return overrun_counter_.load(std::memory_order_relaxed); }
+
+    size_t discard_counter() { return discard_counter_.load(std::memory_order_relaxed); }
+
+    // approximate while producers/consumers are running
+    size_t size() {
+        size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+        size_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+        if (enqueue_pos <= dequeue_pos) {
+            return 0;
+        }
+        size_t n = enqueue_pos - dequeue_pos;
+        return n < capacity_ ? n : capacity_;
+    }
+
+    void reset_overrun_counter() { overrun_counter_.store(0, std::memory_order_relaxed); }
+
+    void reset_discard_counter() { discard_counter_.store(0, std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t cache_line_size = 64;
+    static constexpr int spin_count = 64;
+    static constexpr int yield_count = 16;
+
+    struct slot {
+        std::atomic<size_t> sequence{0};
+        T item;
+    };
+
+    const size_t capacity_;
+    std::vector<slot> slots_;
+    alignas(cache_line_size) std::atomic<size_t> enqueue_pos_{0};
+    alignas(cache_line_size) std::atomic<size_t> dequeue_pos_{0};
+    alignas(cache_line_size) std::atomic<size_t> overrun_counter_{0};
+    std::atomic<size_t> discard_counter_{0};
+
+    // parking (slow path only)
+    alignas(cache_line_size) std::atomic<int> consumers_waiting_{0};
+    std::atomic<int> producers_waiting_{0};
+    std::mutex park_mutex_;
+    std::condition_variable push_cv_;
+    std::condition_variable pop_cv_;
+
+    // moves from item only on success
+    bool try_enqueue_(T &item) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            slot &s = slots_[pos % capacity_];
+            size_t seq = s.sequence.load(std::memory_order_acquire);
+            if (seq == pos) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    s.item = std::move(item);
+                    s.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (seq < pos) {
+                return false;  // full: slot still holds the item from the previous lap
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_dequeue_(T &popped_item) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            slot &s = slots_[pos % capacity_];
+            size_t seq = s.sequence.load(std::memory_order_acquire);
+            if (seq == pos + 1) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    popped_item = std::move(s.item);
+                    s.sequence.store(pos + capacity_, std::memory_order_release);
+                    return true;
+                }
+            } else if (seq < pos + 1) {
+                return false;  // empty: producer for this position has not published yet
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // spin, then yield, then park until try_op succeeds or the deadline passes.
+    // the waiter count is raised before the final re-check under the mutex, and
+    // the waker checks it after publishing, so a wake-up cannot be lost.
+    template <typename Op>
+    bool wait_(std::atomic<int> &waiting,
+               std::condition_variable &cv,
+               Op try_op,
+               std::chrono::steady_clock::time_point deadline) {
+        for (int i = 0; i < spin_count; i++) {
+            if (try_op()) {
+                return true;
+            }
+        }
+        for (int i = 0; i < yield_count; i++) {
+            std::this_thread::yield();
+            if (try_op()) {
+                return true;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(park_mutex_);
+        waiting.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool done = false;
+        while (!(done = try_op())) {
+            if (deadline == std::chrono::steady_clock::time_point::max()) {
+                cv.wait(lock);
+            } else if (cv.wait_until(lock, deadline) == std::cv_status::timeout) {
+                done = try_op();
+                break;
+            }
+        }
+        waiting.fetch_sub(1, std::memory_order_relaxed);
+        return done;
+    }
+
+    void wake_(std::atomic<int> &waiting, std::condition_variable &cv) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            cv.notify_all();
+        }
+    }
+
+    void wake_consumer_() { wake_(consumers_waiting_, push_cv_); }
+
+    void wake_producer_() { wake_(producers_waiting_, pop_cv_); }
+};
+}  // namespace details
+}  // namespace spdlog
@@ -40,6 +40,7 @@
 
 #else  // unix
 
+    #include <dirent.h>
     #include <fcntl.h>
     #include <unistd.h>
 
@@ -563,6 +564,47 @@ SPDLOG_INLINE filename_t dir_name(const filename_t &path) {
     return pos != filename_t::npos ? path.substr(0, pos) : filename_t{};
 }
 
+SPDLOG_INLINE bool list_dir(const filename_t &path, std::vector<filename_t> &names) {
+    names.clear();
+#ifdef _WIN32
+    filename_t pattern = path.empty() ? filename_t(SPDLOG_FILENAME_T(".")) : path;
+    pattern += SPDLOG_FILENAME_T("\\*");
+    #ifdef SPDLOG_WCHAR_FILENAMES
+    WIN32_FIND_DATAW entry;
+    HANDLE find = ::FindFirstFileW(pattern.c_str(), &entry);
+    #else
+    WIN32_FIND_DATAA entry;
+    HANDLE find = ::FindFirstFileA(pattern.c_str(), &entry);
+    #endif
+    if (find == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    do {
+        filename_t name = entry.cFileName;
+        if (name != SPDLOG_FILENAME_T(".") && name != SPDLOG_FILENAME_T("..")) {
+            names.push_back(std::move(name));
+        }
+    #ifdef SPDLOG_WCHAR_FILENAMES
+    } while (::FindNextFileW(find, &entry));
+    #else
+    } while (::FindNextFileA(find, &entry));
+    #endif
+    ::FindClose(find);
+#else
+    DIR *dir = ::opendir(path.empty() ? "." : path.c_str());
+    if (dir == nullptr) {
+        return false;
+    }
+    while (struct dirent *entry = ::readdir(dir)) {
+        if (std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0) {
+            names.emplace_back(entry->d_name);
+        }
+    }
+    ::closedir(dir);
+#endif
+    return true;
+}
+
 std::string SPDLOG_INLINE getenv(const char *field) {
 #if defined(_MSC_VER)
     #if defined(__cplusplus_winrt)
@@ -5,6 +5,7 @@
 
 #include <ctime>  // std::time_t
 #include <spdlog/common.h>
+#include <vector>
 
 namespace spdlog {
 namespace details {
@@ -106,6 +107,10 @@ SPDLOG_API filename_t dir_name(const filename_t &path);
 // Return true if succeeded or if this dir already exists.
 SPDLOG_API bool create_dir(const filename_t &path);
 
+// Names of the entries in the given dir (empty path means the current dir),
+// without "." and "..". Return false if the dir can't be read.
+SPDLOG_API bool list_dir(const filename_t &path, std::vector<filename_t> &names);
+
 // non thread safe, cross platform getenv/getenv_s
 // return empty string if field not found
 SPDLOG_API std::string getenv(const char *field);
@@ -45,6 +45,7 @@ SPDLOG_INLINE registry::registry()
     loggers_[default_logger_name] = default_logger_;
 
 #endif  // SPDLOG_DISABLE_DEFAULT_LOGGER
+    publish_snapshot_();
 }
 
 SPDLOG_INLINE registry::~registry() = default;
@@ -79,14 +80,15 @@ SPDLOG_INLINE void registry::initialize_logger(std::shared_ptr<logger> new_logge
 }
 
 SPDLOG_INLINE std::shared_ptr<logger> registry::get(const std::string &logger_name) {
-    std::lock_guard<std::mutex> lock(logger_map_mutex_);
-    auto found = loggers_.find(logger_name);
-    return found == loggers_.end() ? nullptr : found->second;
+    snapshot_ptr holder;
+    const auto &loggers = read_snapshot_(holder).loggers;
+    auto found = loggers.find(logger_name);
+    return found == loggers.end() ? nullptr : found->second.lock();
 }
 
 SPDLOG_INLINE std::shared_ptr<logger> registry::default_logger() {
-    std::lock_guard<std::mutex> lock(logger_map_mutex_);
-    return default_logger_;
+    snapshot_ptr holder;
+    return read_snapshot_(holder).default_logger.lock();
 }
 
 // Return raw ptr to the default logger.
@@ -103,6 +105,7 @@ SPDLOG_INLINE void registry::set_default_logger(std::shared_ptr<logger> new_defa
         loggers_[new_default_logger->name()] = new_default_logger;
     }
     default_logger_ = std::move(new_default_logger);
+    publish_snapshot_();
 }
 
 SPDLOG_INLINE void registry::set_tp(std::shared_ptr<thread_pool> tp) {
@@ -187,12 +190,14 @@ SPDLOG_INLINE void registry::drop(const std::string &logger_name) {
     if (is_default_logger) {
         default_logger_.reset();
     }
+    publish_snapshot_();
 }
 
 SPDLOG_INLINE void registry::drop_all() {
     std::lock_guard<std::mutex> lock(logger_map_mutex_);
     loggers_.clear();
     default_logger_.reset();
+    publish_snapshot_();
 }
 
 // clean all resources and threads started by the registry
@@ -255,6 +260,54 @@ SPDLOG_INLINE void registry::register_logger_(std::shared_ptr<logger> new_logger
     auto logger_name = new_logger->name();
     throw_if_exists_(logger_name);
     loggers_[logger_name] = std::move(new_logger);
+    publish_snapshot_();
+}
+
+// copy the map for the lookups. called with logger_map_mutex_ held
+SPDLOG_INLINE void registry::publish_snapshot_() {
+    auto snapshot = std::make_shared<logger_snapshot>();
+    snapshot->loggers.reserve(loggers_.size());
+    for (auto &l : loggers_) {
+        snapshot->loggers.emplace(l.first, l.second);
+    }
+    snapshot->default_logger = default_logger_;
+#ifdef __cpp_lib_atomic_shared_ptr
+    snapshot_.store(std::move(snapshot), std::memory_order_release);
+#else
+    std::atomic_store_explicit(&snapshot_, snapshot_ptr(std::move(snapshot)),
+                               std::memory_order_release);
+#endif
+    snapshot_version_.fetch_add(1, std::memory_order_release);
+}
+
+SPDLOG_INLINE registry::snapshot_ptr registry::load_snapshot_() const {
+#ifdef __cpp_lib_atomic_shared_ptr
+    return snapshot_.load(std::memory_order_acquire);
+#else
+    return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+#endif
+}
+
+// the current snapshot. with thread local storage it is the calling thread's
+// copy, reloaded only after a change, so lookups don't touch its refcount.
+// otherwise it is loaded into holder.
+SPDLOG_INLINE const registry::logger_snapshot &registry::read_snapshot_(
+    snapshot_ptr &holder) const {
+#ifndef SPDLOG_NO_TLS
+    (void)holder;
+    static thread_local snapshot_ptr snapshot;
+    static thread_local size_t snapshot_version = 0;
+
+    auto version = snapshot_version_.load(std::memory_order_acquire);
+    if (snapshot_version != version) {
+        snapshot = load_snapshot_();
+        snapshot_version = version;
+    }
+    return *snapshot;
+#else
+    holder = load_snapshot_();
+    return *holder;
+#endif
 }
 
 }  // namespace details
@@ -7,10 +7,15 @@
 // An attempt to create a logger with an already existing name will result with spdlog_ex exception.
 // If user requests a non existing logger, nullptr will be returned
 // This class is thread safe
+//
+// Lookups (get() and default_logger()) don't take the registry mutex: writers
+// publish an immutable snapshot of the map after every change, and readers
+// keep a thread local copy of it until the next change.
 
 #include <spdlog/common.h>
 #include <spdlog/details/periodic_worker.h>
 
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <memory>
@@ -100,12 +105,23 @@ public:
     void apply_logger_env_levels(std::shared_ptr<logger> new_logger);
 
 private:
+    // what the lookups see. it holds weak pointers so that a thread's cached
+    // copy doesn't keep dropped loggers alive.
+    struct logger_snapshot {
+        std::unordered_map<std::string, std::weak_ptr<logger>> loggers;
+        std::weak_ptr<logger> default_logger;
+    };
+    using snapshot_ptr = std::shared_ptr<const logger_snapshot>;
+
     registry();
     ~registry();
 
     void throw_if_exists_(const std::string &logger_name);
     void register_logger_(std::shared_ptr<logger> new_logger);
     bool set_level_from_cfg_(logger *logger);
+    void publish_snapshot_();
+    snapshot_ptr load_snapshot_() const;
+    const logger_snapshot &read_snapshot_(snapshot_ptr &holder) const;
     std::mutex logger_map_mutex_, flusher_mutex_;
     std::recursive_mutex tp_mutex_;
     std::unordered_map<std::string, std::shared_ptr<logger>> loggers_;
@@ -119,6 +135,14 @@ private:
     std::shared_ptr<logger> default_logger_;
     bool automatic_registration_ = true;
     size_t backtrace_n_messages_ = 0;
+
+    // written under logger_map_mutex_ only
+#ifdef __cpp_lib_atomic_shared_ptr
+    std::atomic<snapshot_ptr> snapshot_;
+#else
+    snapshot_ptr snapshot_;  // accessed with std::atomic_load/std::atomic_store
+#endif
+    std::atomic<size_t> snapshot_version_{0};
 };
 
 }  // namespace details
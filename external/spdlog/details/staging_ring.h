@@ -0,0 +1,292 @@
+// Copyright(c) 2015-present, Gabi Melman & spdlog contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+// single producer-single consumer byte ring used by the async thread pool to
+// stage log messages per producer thread (enabled by SPDLOG_ASYNC_STAGING, see
+// tweakme.h).
+//
+// the producer copies the message header and payload inline into the ring and
+// publishes it with a single release store. it caches the consumer position, so
+// the shared cache lines are only touched when the ring looks full.
+// the consumer turns the staged entries back into log_msg views pointing into
+// the ring. it hands them out in runs that belong to the same logger, and frees
+// the space only after the run has been sunk.
+//
+// staged entries refer to their logger by an index into a small per-ring table
+// of logger pointers. this keeps the shared_ptr refcount off the per-message
+// path. the table is filled by the producer only. it is reset only when the
+// ring is empty, so the consumer never sees a slot change under it.
+
+#include <spdlog/details/log_msg.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#ifndef SPDLOG_ASYNC_STAGING_BYTES
+    #define SPDLOG_ASYNC_STAGING_BYTES (64 * 1024)
+#endif
+
+namespace spdlog {
+class async_logger;
+
+namespace details {
+class thread_pool;
+
+class staging_ring {
+public:
+    static constexpr std::uint32_t max_loggers = 16;
+
+    staging_ring(size_t capacity_bytes, thread_pool *pool)
+        : capacity_(round_capacity_(capacity_bytes)),
+          mask_(capacity_ - 1),
+          buffer_(new std::uint64_t[capacity_ / sizeof(std::uint64_t)]),
+          pool_(pool) {}
+
+    staging_ring(const staging_ring &) = delete;
+    staging_ring &operator=(const staging_ring &) = delete;
+
+    //
+    // producer side
+    //
+
+    // messages that can never fit go through the shared queue instead
+    bool fits(const log_msg &msg) const {
+        return entry_size_(msg.payload.size()) <= capacity_ / 2;
+    }
+
+    bool try_push(std::uint32_t logger_index, const log_msg &msg) {
+        size_t need = entry_size_(msg.payload.size());
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t to_end = capacity_ - (head & mask_);
+        size_t total = need <= to_end ? need : need + to_end;
+        if (head + total - cached_tail_ > capacity_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head + total - cached_tail_ > capacity_) {
+                return false;
+            }
+        }
+
+        if (need > to_end) {
+            // not enough room before the end of the buffer: skip to the start
+            entry_prefix wrap{static_cast<std::uint32_t>(to_end), wrap_marker};
+            std::memcpy(at_(head), &wrap, sizeof(wrap));
+            head += to_end;
+        }
+
+        entry_header header;
+        header.prefix.size = static_cast<std::uint32_t>(need);
+        header.prefix.logger_index = logger_index;
+        header.logger_name = msg.logger_name;
+        header.level = msg.level;
+        header.time = msg.time;
+        header.thread_id = msg.thread_id;
+        header.source = msg.source;
+        header.payload_size = msg.payload.size();
+        header.binary = msg.binary;
+        char *dest = at_(head);
+        std::memcpy(dest, &header, sizeof(header));
+        if (msg.payload.size() > 0) {
+            std::memcpy(dest + sizeof(header), msg.payload.data(), msg.payload.size());
+        }
+
+        pushed_.store(pushed_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        head_.store(head + need, std::memory_order_release);
+        return true;
+    }
+
+    // index of the logger in this ring's table, or -1 if it isn't there yet
+    int find_logger(const async_logger *logger) {
+        if (last_logger_ < logger_count_ && loggers_[last_logger_].get() == logger) {
+            return static_cast<int>(last_logger_);
+        }
+        for (std::uint32_t i = 0; i < logger_count_; i++) {
+            if (loggers_[i].get() == logger) {
+                last_logger_ = i;
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    // -1 if the table is full (wait for empty() and call reset_loggers())
+    int add_logger(std::shared_ptr<async_logger> logger) {
+        if (logger_count_ == max_loggers) {
+            return -1;
+        }
+        loggers_[logger_count_] = std::move(logger);
+        last_logger_ = logger_count_;
+        return static_cast<int>(logger_count_++);
+    }
+
+    void reset_loggers() {
+        for (std::uint32_t i = 0; i < logger_count_; i++) {
+            loggers_[i].reset();
+        }
+        logger_count_ = 0;
+        last_logger_ = 0;
+    }
+
+    // the producer thread exited; the consumer may drop the ring once it is empty
+    void close() { closed_.store(true, std::memory_order_release); }
+
+    // marks the producer as inside the pool, see thread_pool::~thread_pool()
+    void enter() { busy_.store(true, std::memory_order_seq_cst); }
+
+    void leave() { busy_.store(false, std::memory_order_release); }
+
+    bool busy() const { return busy_.load(std::memory_order_acquire); }
+
+    void detach() { detached_.store(true, std::memory_order_seq_cst); }
+
+    bool detached() const { return detached_.load(std::memory_order_seq_cst); }
+
+    thread_pool &pool() const { return *pool_; }
+
+    //
+    // consumer side
+    //
+
+    bool try_begin_drain() { return !draining_.exchange(true, std::memory_order_acquire); }
+
+    void end_drain() { draining_.store(false, std::memory_order_release); }
+
+    // calls on_run(logger, msgs, count) for each run of consecutive messages of
+    // the same logger. returns the number of messages consumed.
+    template <typename F>
+    size_t drain(std::vector<log_msg> &batch, F &&on_run) {
+        size_t head = head_.load(std::memory_order_acquire);
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t consumed = 0;
+        std::uint32_t run_logger = wrap_marker;
+        batch.clear();
+
+        while (tail != head) {
+            const char *src = at_(tail);
+            entry_prefix prefix;
+            std::memcpy(&prefix, src, sizeof(prefix));
+            tail += prefix.size;
+            if (prefix.logger_index == wrap_marker) {
+                continue;
+            }
+
+            entry_header header;
+            std::memcpy(&header, src, sizeof(header));
+            if (header.prefix.logger_index != run_logger && !batch.empty()) {
+                on_run(*loggers_[run_logger], batch.data(), batch.size());
+                batch.clear();
+            }
+            run_logger = header.prefix.logger_index;
+
+            batch.emplace_back();
+            log_msg &msg = batch.back();
+            msg.logger_name = header.logger_name;
+            msg.level = header.level;
+            msg.time = header.time;
+            msg.thread_id = header.thread_id;
+            msg.source = header.source;
+            msg.payload = string_view_t(src + sizeof(header), header.payload_size);
+            msg.binary = header.binary;
+            consumed++;
+        }
+
+        if (!batch.empty()) {
+            on_run(*loggers_[run_logger], batch.data(), batch.size());
+            batch.clear();
+        }
+        popped_.store(popped_.load(std::memory_order_relaxed) + consumed,
+                      std::memory_order_relaxed);
+        tail_.store(tail, std::memory_order_release);
+        return consumed;
+    }
+
+    bool empty() const {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+    // approximate number of staged messages
+    size_t size() const {
+        size_t popped = popped_.load(std::memory_order_relaxed);
+        size_t pushed = pushed_.load(std::memory_order_relaxed);
+        return pushed > popped ? pushed - popped : 0;
+    }
+
+private:
+    static constexpr size_t cache_line_size = 64;
+    static constexpr std::uint32_t wrap_marker = 0xffffffff;
+
+    struct entry_prefix {
+        std::uint32_t size;  // whole entry, multiple of sizeof(uint64_t)
+        std::uint32_t logger_index;
+    };
+
+    struct entry_header {
+        entry_prefix prefix;
+        string_view_t logger_name;  // owned by the logger, which the table keeps alive
+        level::level_enum level;
+        log_clock::time_point time;
+        size_t thread_id;
+        source_loc source;
+        size_t payload_size;
+        const binary_format *binary;
+    };
+
+    static size_t round_capacity_(size_t n) {
+        size_t capacity = 1024;
+        while (capacity < n) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    static size_t entry_size_(size_t payload_size) {
+        size_t n = sizeof(entry_header) + payload_size;
+        return (n + sizeof(std::uint64_t) - 1) & ~(sizeof(std::uint64_t) - 1);
+    }
+
+    char *at_(size_t pos) const { return reinterpret_cast<char *>(buffer_.get()) + (pos & mask_); }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<std::uint64_t[]> buffer_;
+    thread_pool *pool_;
+
+    // producer
+    alignas(cache_line_size) std::atomic<size_t> head_{0};
+    std::atomic<size_t> pushed_{0};
+    std::atomic<bool> busy_{false};
+    size_t cached_tail_ = 0;
+    std::shared_ptr<async_logger> loggers_[max_loggers];
+    std::uint32_t logger_count_ = 0;
+    std::uint32_t last_logger_ = 0;
+
+    // consumer
+    alignas(cache_line_size) std::atomic<size_t> tail_{0};
+    std::atomic<size_t> popped_{0};
+    std::atomic<bool> draining_{false};
+
+    // lifetime
+    alignas(cache_line_size) std::atomic<bool> closed_{false};
+    std::atomic<bool> detached_{false};
+};
+
+// rings staged into by the current thread, one per thread pool it logs to
+struct local_staging_rings {
+    std::vector<std::pair<size_t, std::shared_ptr<staging_ring>>> rings;
+
+    ~local_staging_rings() {
+        for (auto &entry : rings) {
+            entry.second->close();
+        }
+    }
+};
+
+}  // namespace details
+}  // namespace spdlog
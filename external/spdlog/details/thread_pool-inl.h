@@ -7,6 +7,7 @@
     #include <spdlog/details/thread_pool.h>
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <spdlog/common.h>
 
@@ -23,6 +24,10 @@ SPDLOG_INLINE thread_pool::thread_pool(size_t q_max_items,
             "spdlog::thread_pool(): invalid threads_n param (valid "
             "range is 1-1000)");
     }
+#ifdef SPDLOG_ASYNC_STAGING
+    static std::atomic<size_t> next_id{1};
+    id_ = next_id.fetch_add(1, std::memory_order_relaxed);
+#endif
     for (size_t i = 0; i < threads_n; i++) {
         threads_.emplace_back([this, on_thread_start, on_thread_stop] {
             on_thread_start();
@@ -44,6 +49,24 @@ SPDLOG_INLINE thread_pool::thread_pool(size_t q_max_items, size_t threads_n)
 // message all threads to terminate gracefully join them
 SPDLOG_INLINE thread_pool::~thread_pool() {
     SPDLOG_TRY {
+#ifdef SPDLOG_ASYNC_STAGING
+        // stop producers from staging into this pool and wait for the ones
+        // already inside. the workers drain what is staged before they see the
+        // terminate message.
+        std::vector<std::shared_ptr<staging_ring>> rings;
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            rings = rings_;
+        }
+        for (auto &ring : rings) {
+            ring->detach();
+        }
+        for (auto &ring : rings) {
+            while (ring->busy()) {
+                std::this_thread::yield();
+            }
+        }
+#endif
         for (size_t i = 0; i < threads_.size(); i++) {
             post_async_msg_(async_msg(async_msg_type::terminate), async_overflow_policy::block);
         }
@@ -51,6 +74,12 @@ SPDLOG_INLINE thread_pool::~thread_pool() {
         for (auto &t : threads_) {
             t.join();
         }
+#ifdef SPDLOG_ASYNC_STAGING
+        // release the loggers now rather than when the producer threads exit
+        for (auto &ring : rings) {
+            ring->reset_loggers();
+        }
+#endif
     }
     SPDLOG_CATCH_STD
 }
@@ -67,6 +96,7 @@ void SPDLOG_INLINE thread_pool::post_flush(async_logger_ptr &&worker_ptr,
     post_async_msg_(async_msg(std::move(worker_ptr), async_msg_type::flush), overflow_policy);
 }
 
+#ifndef SPDLOG_ASYNC_STAGING
 size_t SPDLOG_INLINE thread_pool::overrun_counter() { return q_.overrun_counter(); }
 
 void SPDLOG_INLINE thread_pool::reset_overrun_counter() { q_.reset_overrun_counter(); }
@@ -76,6 +106,211 @@ size_t SPDLOG_INLINE thread_pool::discard_counter() { return q_.discard_counter(
 void SPDLOG_INLINE thread_pool::reset_discard_counter() { q_.reset_discard_counter(); }
 
 size_t SPDLOG_INLINE thread_pool::queue_size() { return q_.size(); }
+#else
+size_t SPDLOG_INLINE thread_pool::overrun_counter() {
+    return q_.overrun_counter() + staged_overrun_counter_.load(std::memory_order_relaxed);
+}
+
+void SPDLOG_INLINE thread_pool::reset_overrun_counter() {
+    q_.reset_overrun_counter();
+    staged_overrun_counter_.store(0, std::memory_order_relaxed);
+}
+
+size_t SPDLOG_INLINE thread_pool::discard_counter() {
+    return q_.discard_counter() + staged_discard_counter_.load(std::memory_order_relaxed);
+}
+
+void SPDLOG_INLINE thread_pool::reset_discard_counter() {
+    q_.reset_discard_counter();
+    staged_discard_counter_.store(0, std::memory_order_relaxed);
+}
+
+size_t SPDLOG_INLINE thread_pool::queue_size() {
+    size_t n = q_.size();
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (auto &ring : rings_) {
+        n += ring->size();
+    }
+    return n;
+}
+
+void SPDLOG_INLINE thread_pool::post_log_staged(size_t pool_id,
+                                                const std::weak_ptr<thread_pool> &pool,
+                                                async_logger &logger,
+                                                const details::log_msg &msg,
+                                                async_overflow_policy overflow_policy) {
+    staging_ring *ring = nullptr;
+    for (auto &entry : local_rings_().rings) {
+        if (entry.first == pool_id) {
+            ring = entry.second.get();
+            break;
+        }
+    }
+    if (ring == nullptr) {
+        auto pool_ptr = pool.lock();
+        if (!pool_ptr) {
+            throw_spdlog_ex("async log: thread pool doesn't exist anymore");
+        }
+        ring = pool_ptr->register_ring_();
+    }
+
+    // enter before checking detached: the pool destructor detaches first and
+    // then waits for the rings that are still busy
+    struct busy_guard {
+        staging_ring &ring;
+        ~busy_guard() { ring.leave(); }
+    };
+    ring->enter();
+    busy_guard guard{*ring};
+    if (ring->detached()) {
+        throw_spdlog_ex("async log: thread pool doesn't exist anymore");
+    }
+    ring->pool().stage_log_(*ring, logger, msg, overflow_policy);
+}
+
+SPDLOG_INLINE local_staging_rings &thread_pool::local_rings_() {
+    static thread_local local_staging_rings rings;
+    return rings;
+}
+
+SPDLOG_INLINE staging_ring *thread_pool::register_ring_() {
+    auto ring = std::make_shared<staging_ring>(SPDLOG_ASYNC_STAGING_BYTES, this);
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.push_back(ring);
+        rings_version_.fetch_add(1, std::memory_order_release);
+    }
+
+    // forget the rings of pools that are gone
+    auto &local = local_rings_().rings;
+    local.erase(std::remove_if(local.begin(), local.end(),
+                               [](const std::pair<size_t, std::shared_ptr<staging_ring>> &entry) {
+                                   return entry.second->detached();
+                               }),
+                local.end());
+    local.emplace_back(id_, ring);
+    return ring.get();
+}
+
+void SPDLOG_INLINE thread_pool::stage_log_(staging_ring &ring,
+                                           async_logger &logger,
+                                           const details::log_msg &msg,
+                                           async_overflow_policy overflow_policy) {
+    if (!ring.fits(msg)) {
+        // too large to stage. the worker drains the rings before it handles a
+        // queued message, so this still comes after the thread's earlier messages.
+        post_log(logger.shared_from_this(), msg, overflow_policy);
+        return;
+    }
+
+    int index = ring.find_logger(&logger);
+    if (index < 0) {
+        index = ring.add_logger(logger.shared_from_this());
+        if (index < 0) {
+            // logger table full: wait until the worker is done with every staged entry
+            while (!ring.empty()) {
+                wake_worker_();
+                std::this_thread::yield();
+            }
+            ring.reset_loggers();
+            index = ring.add_logger(logger.shared_from_this());
+        }
+    }
+
+    // the producer can't drop the oldest staged message (the consumer owns it),
+    // so with overrun_oldest a full ring drops the new one, like discard_new
+    while (!ring.try_push(static_cast<std::uint32_t>(index), msg)) {
+        if (overflow_policy == async_overflow_policy::overrun_oldest) {
+            staged_overrun_counter_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (overflow_policy == async_overflow_policy::discard_new) {
+            staged_discard_counter_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        wake_worker_();
+        std::this_thread::yield();
+    }
+    wake_worker_();
+}
+
+// pairs with the fences in next_queued_msg_(): either the worker sees the
+// staged message when it rescans the rings, or we see it idle and post a wake.
+void SPDLOG_INLINE thread_pool::wake_worker_() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (idle_workers_.load(std::memory_order_relaxed) > 0 &&
+        !wake_posted_.exchange(true, std::memory_order_acq_rel)) {
+        q_.enqueue(async_msg(async_msg_type::wake));
+    }
+}
+
+// sink everything currently staged, one batch per run of the same logger.
+// return true if anything was drained
+bool SPDLOG_INLINE thread_pool::drain_staging_() {
+    static thread_local std::vector<std::shared_ptr<staging_ring>> rings;
+    static thread_local size_t rings_version = 0;
+    static thread_local std::vector<log_msg> batch;
+
+    if (rings_version != rings_version_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings = rings_;
+        rings_version = rings_version_.load(std::memory_order_relaxed);
+    }
+
+    size_t drained = 0;
+    bool remove_closed = false;
+    for (auto &ring : rings) {
+        if (!ring->try_begin_drain()) {
+            continue;
+        }
+        drained += ring->drain(batch, [](async_logger &logger, const log_msg *msgs, size_t n) {
+            logger.backend_sink_batch_(msgs, n);
+        });
+        remove_closed |= ring->closed() && ring->empty();
+        ring->end_drain();
+    }
+
+    // the producer thread exited and everything it staged was sunk
+    if (remove_closed) {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                    [](const std::shared_ptr<staging_ring> &ring) {
+                                        return ring->closed() && ring->empty();
+                                    }),
+                     rings_.end());
+        rings_version_.fetch_add(1, std::memory_order_release);
+    }
+    return drained > 0;
+}
+
+// wait for the next queued message, sinking staged messages meanwhile.
+// return false if there is no queued message yet (staged ones were drained)
+bool SPDLOG_INLINE thread_pool::next_queued_msg_(async_msg &msg) {
+    if (drain_staging_()) {
+        // producers are busy: keep draining, but don't starve the queue
+        if (!q_.dequeue_for(msg, std::chrono::milliseconds(0))) {
+            return false;
+        }
+    } else {
+        idle_workers_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (drain_staging_()) {
+            idle_workers_.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        q_.dequeue(msg);
+        idle_workers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    if (msg.msg_type == async_msg_type::wake) {
+        wake_posted_.store(false, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    // whatever was staged before this message was queued is sunk first
+    drain_staging_();
+    return true;
+}
+#endif
 
 void SPDLOG_INLINE thread_pool::post_async_msg_(async_msg &&new_msg,
                                                 async_overflow_policy overflow_policy) {
@@ -99,7 +334,13 @@ void SPDLOG_INLINE thread_pool::worker_loop_() {
 // was received)
 bool SPDLOG_INLINE thread_pool::process_next_msg_() {
     async_msg incoming_async_msg;
+#ifdef SPDLOG_ASYNC_STAGING
+    if (!next_queued_msg_(incoming_async_msg)) {
+        return true;
+    }
+#else
     q_.dequeue(incoming_async_msg);
+#endif
 
     switch (incoming_async_msg.msg_type) {
         case async_msg_type::log: {
@@ -115,6 +356,10 @@ bool SPDLOG_INLINE thread_pool::process_next_msg_() {
             return false;
         }
 
+        case async_msg_type::wake: {
+            return true;
+        }
+
         default: {
             assert(false);
         }
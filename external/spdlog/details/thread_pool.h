@@ -5,11 +5,14 @@
 
 #include <spdlog/details/log_msg_buffer.h>
 #include <spdlog/details/mpmc_blocking_q.h>
+#include <spdlog/details/mpmc_lockfree_q.h>
 #include <spdlog/details/os.h>
+#include <spdlog/details/staging_ring.h>
 
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -20,7 +23,8 @@ namespace details {
 
 using async_logger_ptr = std::shared_ptr<spdlog::async_logger>;
 
-enum class async_msg_type { log, flush, terminate };
+// wake: staged messages are waiting (see SPDLOG_ASYNC_STAGING)
+enum class async_msg_type { log, flush, terminate, wake };
 
 // Async msg to move to/from the queue
 // Movable only. should never be copied
@@ -70,7 +74,11 @@ struct async_msg : log_msg_buffer {
 class SPDLOG_API thread_pool {
 public:
     using item_type = async_msg;
+#ifdef SPDLOG_LOCKFREE_QUEUE
+    using q_type = details::mpmc_lockfree_queue<item_type>;
+#else
     using q_type = details::mpmc_blocking_queue<item_type>;
+#endif
 
     thread_pool(size_t q_max_items,
                 size_t threads_n,
@@ -95,11 +103,43 @@ public:
     void reset_discard_counter();
     size_t queue_size();
 
+#ifdef SPDLOG_ASYNC_STAGING
+    // stage the message in the calling thread's ring for the pool with the given id.
+    // throws if that pool no longer exists.
+    static void post_log_staged(size_t pool_id,
+                                const std::weak_ptr<thread_pool> &pool,
+                                async_logger &logger,
+                                const details::log_msg &msg,
+                                async_overflow_policy overflow_policy);
+    size_t id() const { return id_; }
+#endif
+
 private:
     q_type q_;
 
     std::vector<std::thread> threads_;
 
+#ifdef SPDLOG_ASYNC_STAGING
+    size_t id_;
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<staging_ring>> rings_;
+    std::atomic<size_t> rings_version_{0};
+    std::atomic<int> idle_workers_{0};
+    std::atomic<bool> wake_posted_{false};
+    std::atomic<size_t> staged_overrun_counter_{0};
+    std::atomic<size_t> staged_discard_counter_{0};
+
+    static local_staging_rings &local_rings_();
+    staging_ring *register_ring_();
+    void stage_log_(staging_ring &ring,
+                    async_logger &logger,
+                    const details::log_msg &msg,
+                    async_overflow_policy overflow_policy);
+    void wake_worker_();
+    bool drain_staging_();
+    bool next_queued_msg_(async_msg &msg);
+#endif
+
     void post_async_msg_(async_msg &&new_msg, async_overflow_policy overflow_policy);
     void worker_loop_();
 
@@ -133,9 +133,10 @@ SPDLOG_INLINE void logger::log_it_(const spdlog::details::log_msg &log_msg,
 }
 
 SPDLOG_INLINE void logger::sink_it_(const details::log_msg &msg) {
+    details::binary_renderer render;
     for (auto &sink : sinks_) {
         if (sink->should_log(msg.level)) {
-            SPDLOG_TRY { sink->log(msg); }
+            SPDLOG_TRY { sink->log(render(msg, *sink)); }
             SPDLOG_LOGGER_CATCH(msg.source)
         }
     }
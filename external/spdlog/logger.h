@@ -16,6 +16,7 @@
 
 #include <spdlog/common.h>
 #include <spdlog/details/backtracer.h>
+#include <spdlog/details/binary_format.h>
 #include <spdlog/details/log_msg.h>
 
 #ifdef SPDLOG_WCHAR_TO_UTF8_SUPPORT
@@ -125,6 +126,38 @@ public:
 
     void log(level::level_enum lvl, string_view_t msg) { log(source_loc{}, lvl, msg); }
 
+#ifndef SPDLOG_USE_STD_FORMAT
+    // deferred formatting: record only the call site and the raw argument
+    // values, the text is formatted later by whoever needs it (text sinks,
+    // the async worker, or the offline decoder of a binary_file_sink file).
+    // use through SPDLOG_LOGGER_BINARY, which provides the call site's
+    // binary_format; fmt must be a string literal.
+    template <typename... Args>
+    void log_binary(source_loc loc,
+                    level::level_enum lvl,
+                    details::binary_format &format,
+                    format_string_t<Args...> fmt,
+                    Args &&...args) {
+        bool log_enabled = should_log(lvl);
+        bool traceback_enabled = tracer_.enabled();
+        if (!log_enabled && !traceback_enabled) {
+            return;
+        }
+        SPDLOG_TRY {
+            if (!format.ready.load(std::memory_order_acquire)) {
+                format.init(details::to_string_view(fmt), details::binary_signature<Args...>::tags(),
+                            loc);
+            }
+            memory_buf_t buf;
+            details::binary_encode(buf, args...);
+            details::log_msg log_msg(loc, name_, lvl, string_view_t(buf.data(), buf.size()));
+            log_msg.binary = &format;
+            log_it_(log_msg, log_enabled, traceback_enabled);
+        }
+        SPDLOG_LOGGER_CATCH(loc)
+    }
+#endif
+
     template <typename... Args>
     void trace(format_string_t<Args...> fmt, Args &&...args) {
         log(level::trace, fmt, std::forward<Args>(args)...);
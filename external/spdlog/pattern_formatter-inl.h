@@ -607,6 +607,8 @@ private:
 class aggregate_formatter final : public flag_formatter {
 public:
     aggregate_formatter() = default;
+    explicit aggregate_formatter(std::string str)
+        : str_(std::move(str)) {}
 
     void add_ch(char ch) { str_ += ch; }
     void format(const details::log_msg &, const std::tm &, memory_buf_t &dest) override {
@@ -831,106 +833,35 @@ public:
 };
 #endif
 
-// Full info formatter
-// pattern: [%Y-%m-%d %H:%M:%S.%e] [%n] [%l] [%s:%#] %v
-class full_formatter final : public flag_formatter {
+// Date and time part of the full info formatter (%+): "[%Y-%m-%d %H:%M:%S."
+// the rest of it is run inline by pattern_formatter::format().
+class full_datetime_formatter final : public flag_formatter {
 public:
-    explicit full_formatter(padding_info padinfo)
-        : flag_formatter(padinfo) {}
-
-    void format(const details::log_msg &msg, const std::tm &tm_time, memory_buf_t &dest) override {
-        using std::chrono::duration_cast;
-        using std::chrono::milliseconds;
-        using std::chrono::seconds;
-
-        // cache the date/time part for the next second.
-        auto duration = msg.time.time_since_epoch();
-        auto secs = duration_cast<seconds>(duration);
-
-        if (cache_timestamp_ != secs || cached_datetime_.size() == 0) {
-            cached_datetime_.clear();
-            cached_datetime_.push_back('[');
-            fmt_helper::append_int(tm_time.tm_year + 1900, cached_datetime_);
-            cached_datetime_.push_back('-');
-
-            fmt_helper::pad2(tm_time.tm_mon + 1, cached_datetime_);
-            cached_datetime_.push_back('-');
-
-            fmt_helper::pad2(tm_time.tm_mday, cached_datetime_);
-            cached_datetime_.push_back(' ');
-
-            fmt_helper::pad2(tm_time.tm_hour, cached_datetime_);
-            cached_datetime_.push_back(':');
-
-            fmt_helper::pad2(tm_time.tm_min, cached_datetime_);
-            cached_datetime_.push_back(':');
-
-            fmt_helper::pad2(tm_time.tm_sec, cached_datetime_);
-            cached_datetime_.push_back('.');
-
-            cache_timestamp_ = secs;
-        }
-        dest.append(cached_datetime_.begin(), cached_datetime_.end());
-
-        auto millis = fmt_helper::time_fraction<milliseconds>(msg.time);
-        fmt_helper::pad3(static_cast<uint32_t>(millis.count()), dest);
-        dest.push_back(']');
-        dest.push_back(' ');
-
-        // append logger name if exists
-        if (msg.logger_name.size() > 0) {
-            dest.push_back('[');
-            fmt_helper::append_string_view(msg.logger_name, dest);
-            dest.push_back(']');
-            dest.push_back(' ');
-        }
+    full_datetime_formatter() = default;
 
+    void format(const details::log_msg &, const std::tm &tm_time, memory_buf_t &dest) override {
         dest.push_back('[');
-        // wrap the level name with color
-        msg.color_range_start = dest.size();
-        // fmt_helper::append_string_view(level::to_c_str(msg.level), dest);
-        fmt_helper::append_string_view(level::to_string_view(msg.level), dest);
-        msg.color_range_end = dest.size();
-        dest.push_back(']');
+        fmt_helper::append_int(tm_time.tm_year + 1900, dest);
+        dest.push_back('-');
+        fmt_helper::pad2(tm_time.tm_mon + 1, dest);
+        dest.push_back('-');
+        fmt_helper::pad2(tm_time.tm_mday, dest);
         dest.push_back(' ');
-
-        // add source location if present
-        if (!msg.source.empty()) {
-            dest.push_back('[');
-            const char *filename =
-                details::short_filename_formatter<details::null_scoped_padder>::basename(
-                    msg.source.filename);
-            fmt_helper::append_string_view(filename, dest);
-            dest.push_back(':');
-            fmt_helper::append_int(msg.source.line, dest);
-            dest.push_back(']');
-            dest.push_back(' ');
-        }
-
-#ifndef SPDLOG_NO_TLS
-        // add mdc if present
-        auto &mdc_map = mdc::get_context();
-        if (!mdc_map.empty()) {
-            dest.push_back('[');
-            mdc_formatter_.format_mdc(mdc_map, dest);
-            dest.push_back(']');
-            dest.push_back(' ');
-        }
-#endif
-        // fmt_helper::append_string_view(msg.msg(), dest);
-        fmt_helper::append_string_view(msg.payload, dest);
+        fmt_helper::pad2(tm_time.tm_hour, dest);
+        dest.push_back(':');
+        fmt_helper::pad2(tm_time.tm_min, dest);
+        dest.push_back(':');
+        fmt_helper::pad2(tm_time.tm_sec, dest);
+        dest.push_back('.');
     }
-
-private:
-    std::chrono::seconds cache_timestamp_{0};
-    memory_buf_t cached_datetime_;
-
-#ifndef SPDLOG_NO_TLS
-    mdc_formatter<null_scoped_padder> mdc_formatter_{padding_info{}};
-#endif
-
 };
 
+// flags whose output only changes with the second: they are rendered into
+// the formatter's cached text instead of on every message
+inline bool is_cached_flag(char flag) {
+    return std::strchr("aAbhBcCYDxmdHIMSprRTXz%", flag) != nullptr;
+}
+
 }  // namespace details
 
 SPDLOG_INLINE pattern_formatter::pattern_formatter(std::string pattern,
@@ -942,7 +873,13 @@ SPDLOG_INLINE pattern_formatter::pattern_formatter(std::string pattern,
       pattern_time_type_(time_type),
       need_localtime_(false),
       last_log_secs_(0),
-      custom_handlers_(std::move(custom_user_flags)) {
+      custom_handlers_(std::move(custom_user_flags)),
+      cached_text_valid_(false),
+      segments_valid_(false),
+      segment_uses_(0),
+      segment_millis_(0),
+      segment_level_(level::off),
+      segment_thread_id_(0) {
     std::memset(&cached_tm_, 0, sizeof(cached_tm_));
     compile_pattern_(pattern_);
 }
@@ -953,9 +890,15 @@ SPDLOG_INLINE pattern_formatter::pattern_formatter(pattern_time_type time_type,
       eol_(std::move(eol)),
       pattern_time_type_(time_type),
       need_localtime_(true),
-      last_log_secs_(0) {
+      last_log_secs_(0),
+      cached_text_valid_(false),
+      segments_valid_(false),
+      segment_uses_(0),
+      segment_millis_(0),
+      segment_level_(level::off),
+      segment_thread_id_(0) {
     std::memset(&cached_tm_, 0, sizeof(cached_tm_));
-    formatters_.push_back(details::make_unique<details::full_formatter>(details::padding_info{}));
+    compile_pattern_(pattern_);
 }
 
 SPDLOG_INLINE std::unique_ptr<formatter> pattern_formatter::clone() const {
@@ -974,20 +917,167 @@ SPDLOG_INLINE std::unique_ptr<formatter> pattern_formatter::clone() const {
 }
 
 SPDLOG_INLINE void pattern_formatter::format(const details::log_msg &msg, memory_buf_t &dest) {
+    using details::fmt_helper::append_string_view;
+    using kind = details::pattern_op::kind;
+
     if (need_localtime_) {
         const auto secs =
             std::chrono::duration_cast<std::chrono::seconds>(msg.time.time_since_epoch());
         if (secs != last_log_secs_) {
             cached_tm_ = get_time_(msg);
             last_log_secs_ = secs;
+            cached_text_valid_ = false;
+        }
+    }
+    if (!cached_text_valid_) {
+        render_cached_text_(msg);
+    }
+    std::int64_t millis = 0;
+    if (segment_uses_ & uses_millis) {
+        millis = std::chrono::duration_cast<std::chrono::milliseconds>(msg.time.time_since_epoch())
+                     .count();
+    }
+    if (!segments_valid_ || !segments_match_(msg, millis)) {
+        render_segments_(msg, millis);
+    }
+
+    for (const auto &op : ops_) {
+        switch (op.op) {
+            case kind::segment:
+                if (op.color_start != details::pattern_op::no_color) {
+                    msg.color_range_start = dest.size() + op.color_start;
+                }
+                if (op.color_stop != details::pattern_op::no_color) {
+                    msg.color_range_end = dest.size() + op.color_stop;
+                }
+                append_string_view(
+                    string_view_t(segment_text_.data() + op.begin, op.end - op.begin), dest);
+                break;
+            case kind::formatter:
+                formatters_[op.first]->format(msg, cached_tm_, dest);
+                break;
+            case kind::payload:
+                append_string_view(msg.payload, dest);
+                break;
+            case kind::micros:
+                details::fmt_helper::pad6(
+                    static_cast<size_t>(
+                        details::fmt_helper::time_fraction<std::chrono::microseconds>(msg.time)
+                            .count()),
+                    dest);
+                break;
+            case kind::nanos:
+                details::fmt_helper::pad9(
+                    static_cast<size_t>(
+                        details::fmt_helper::time_fraction<std::chrono::nanoseconds>(msg.time)
+                            .count()),
+                    dest);
+                break;
+            case kind::full_source:
+                if (msg.source.empty()) {
+                    break;
+                }
+                if (msg.source.filename != last_source_.filename ||
+                    msg.source.line != last_source_.line) {
+                    source_text_.clear();
+                    source_text_.push_back('[');
+                    append_string_view(
+                        details::short_filename_formatter<details::null_scoped_padder>::basename(
+                            msg.source.filename),
+                        source_text_);
+                    source_text_.push_back(':');
+                    details::fmt_helper::append_int(msg.source.line, source_text_);
+                    append_string_view("] ", source_text_);
+                    last_source_ = msg.source;
+                }
+                append_string_view(string_view_t(source_text_.data(), source_text_.size()), dest);
+                break;
+            case kind::full_mdc:
+#ifndef SPDLOG_NO_TLS
+                if (!mdc::get_context().empty()) {
+                    dest.push_back('[');
+                    formatters_[op.first]->format(msg, cached_tm_, dest);
+                    append_string_view("] ", dest);
+                }
+#endif
+                break;
+            default:  // segment parts never appear here
+                break;
         }
     }
+}
+
+SPDLOG_INLINE bool pattern_formatter::segments_match_(const details::log_msg &msg,
+                                                      std::int64_t millis) const {
+    return (!(segment_uses_ & uses_millis) || millis == segment_millis_) &&
+           (!(segment_uses_ & uses_level) || msg.level == segment_level_) &&
+           (!(segment_uses_ & uses_thread_id) || msg.thread_id == segment_thread_id_) &&
+           (!(segment_uses_ & uses_logger_name) ||
+            msg.logger_name == string_view_t(segment_logger_name_));
+}
 
-    for (auto &f : formatters_) {
-        f->format(msg, cached_tm_, dest);
+SPDLOG_INLINE void pattern_formatter::render_segments_(const details::log_msg &msg,
+                                                       std::int64_t millis) {
+    using details::fmt_helper::append_string_view;
+    using kind = details::pattern_op::kind;
+
+    segment_text_.clear();
+    for (auto &segment : ops_) {
+        if (segment.op != kind::segment) {
+            continue;
+        }
+        segment.begin = static_cast<std::uint32_t>(segment_text_.size());
+        segment.color_start = details::pattern_op::no_color;
+        segment.color_stop = details::pattern_op::no_color;
+        for (auto i = segment.first; i < segment.last; i++) {
+            const auto &op = segment_ops_[i];
+            auto offset = static_cast<std::uint32_t>(segment_text_.size()) - segment.begin;
+            switch (op.op) {
+                case kind::text:
+                    append_string_view(
+                        string_view_t(cached_text_.data() + op.begin, op.end - op.begin),
+                        segment_text_);
+                    break;
+                case kind::logger_name:
+                    append_string_view(msg.logger_name, segment_text_);
+                    break;
+                case kind::level:
+                    append_string_view(level::to_string_view(msg.level), segment_text_);
+                    break;
+                case kind::short_level:
+                    append_string_view(level::to_short_c_str(msg.level), segment_text_);
+                    break;
+                case kind::thread_id:
+                    details::fmt_helper::append_int(msg.thread_id, segment_text_);
+                    break;
+                case kind::millis:
+                    details::fmt_helper::pad3(static_cast<uint32_t>(millis % 1000), segment_text_);
+                    break;
+                case kind::color_start:
+                    segment.color_start = offset;
+                    break;
+                case kind::color_stop:
+                    segment.color_stop = offset;
+                    break;
+                case kind::full_logger_name:
+                    if (msg.logger_name.size() > 0) {
+                        segment_text_.push_back('[');
+                        append_string_view(msg.logger_name, segment_text_);
+                        append_string_view("] ", segment_text_);
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        segment.end = static_cast<std::uint32_t>(segment_text_.size());
     }
-    // write eol
-    details::fmt_helper::append_string_view(eol_, dest);
+
+    segment_millis_ = millis;
+    segment_logger_name_.assign(msg.logger_name.data(), msg.logger_name.size());
+    segment_level_ = msg.level;
+    segment_thread_id_ = msg.thread_id;
+    segments_valid_ = true;
 }
 
 SPDLOG_INLINE void pattern_formatter::set_pattern(std::string pattern) {
@@ -996,6 +1086,21 @@ SPDLOG_INLINE void pattern_formatter::set_pattern(std::string pattern) {
     compile_pattern_(pattern_);
 }
 
+SPDLOG_INLINE void pattern_formatter::render_cached_text_(const details::log_msg &msg) {
+    cached_text_.clear();
+    for (auto &op : segment_ops_) {
+        if (op.op == details::pattern_op::kind::text) {
+            op.begin = static_cast<std::uint32_t>(cached_text_.size());
+            for (auto i = op.first; i < op.last; i++) {
+                formatters_[i]->format(msg, cached_tm_, cached_text_);
+            }
+            op.end = static_cast<std::uint32_t>(cached_text_.size());
+        }
+    }
+    cached_text_valid_ = true;
+    segments_valid_ = false;
+}
+
 SPDLOG_INLINE void pattern_formatter::need_localtime(bool need) { need_localtime_ = need; }
 
 SPDLOG_INLINE std::tm pattern_formatter::get_time_(const details::log_msg &msg) {
@@ -1018,11 +1123,6 @@ SPDLOG_INLINE void pattern_formatter::handle_flag_(char flag, details::padding_i
 
     // process built-in flags
     switch (flag) {
-        case ('+'):  // default formatter
-            formatters_.push_back(details::make_unique<details::full_formatter>(padding));
-            need_localtime_ = true;
-            break;
-
         case 'n':  // logger name
             formatters_.push_back(details::make_unique<details::name_formatter<Padder>>(padding));
             break;
@@ -1300,25 +1400,158 @@ SPDLOG_INLINE details::padding_info pattern_formatter::handle_padspec_(
     return details::padding_info{std::min<size_t>(width, max_width), side, truncate};
 }
 
+SPDLOG_INLINE bool pattern_formatter::add_inline_flag_(char flag, details::padding_info padding) {
+    using kind = details::pattern_op::kind;
+    if (custom_handlers_.find(flag) != custom_handlers_.end()) {
+        return false;
+    }
+    // padding is ignored by the full formatter
+    if (padding.enabled() && flag != '+') {
+        return false;
+    }
+
+    switch (flag) {
+        case ('+'):  // default formatter: [%Y-%m-%d %H:%M:%S.%e] [%n] [%l] [%s:%#] %v
+            add_text_(details::make_unique<details::full_datetime_formatter>());
+            add_op_(kind::millis);
+            add_text_(details::make_unique<details::aggregate_formatter>("] "));
+            add_op_(kind::full_logger_name);
+            add_text_(details::make_unique<details::aggregate_formatter>("["));
+            add_op_(kind::color_start);
+            add_op_(kind::level);
+            add_op_(kind::color_stop);
+            add_text_(details::make_unique<details::aggregate_formatter>("] "));
+            add_op_(kind::full_source);
+#ifndef SPDLOG_NO_TLS
+            formatters_.push_back(
+                details::make_unique<details::mdc_formatter<details::null_scoped_padder>>(
+                    details::padding_info{}));
+            add_op_(kind::full_mdc, formatters_.size() - 1);
+#endif
+            add_op_(kind::payload);
+            need_localtime_ = true;
+            return true;
+        case 'n':
+            add_op_(kind::logger_name);
+            return true;
+        case 'l':
+            add_op_(kind::level);
+            return true;
+        case 'L':
+            add_op_(kind::short_level);
+            return true;
+        case ('t'):
+            add_op_(kind::thread_id);
+            return true;
+        case ('v'):
+            add_op_(kind::payload);
+            return true;
+        case ('e'):
+            add_op_(kind::millis);
+            return true;
+        case ('f'):
+            add_op_(kind::micros);
+            return true;
+        case ('F'):
+            add_op_(kind::nanos);
+            return true;
+        case ('^'):
+            add_op_(kind::color_start);
+            return true;
+        case ('$'):
+            add_op_(kind::color_stop);
+            return true;
+        default:
+            return false;
+    }
+}
+
+SPDLOG_INLINE void pattern_formatter::add_op_(details::pattern_op::kind op, size_t first) {
+    using kind = details::pattern_op::kind;
+    auto index = static_cast<std::uint32_t>(first);
+    details::pattern_op new_op{op, index, index + 1, 0, 0, details::pattern_op::no_color,
+                               details::pattern_op::no_color};
+    if (op >= kind::segment) {
+        ops_.push_back(new_op);
+        return;
+    }
+
+    switch (op) {
+        case kind::millis:
+            segment_uses_ |= uses_millis;
+            break;
+        case kind::logger_name:
+        case kind::full_logger_name:
+            segment_uses_ |= uses_logger_name;
+            break;
+        case kind::level:
+        case kind::short_level:
+            segment_uses_ |= uses_level;
+            break;
+        case kind::thread_id:
+            segment_uses_ |= uses_thread_id;
+            break;
+        default:
+            break;
+    }
+
+    // extend the current segment, consecutive text parts share one op
+    bool in_segment = !ops_.empty() && ops_.back().op == kind::segment;
+    if (in_segment && op == kind::text && segment_ops_.back().op == kind::text &&
+        segment_ops_.back().last == index) {
+        segment_ops_.back().last++;
+        return;
+    }
+    segment_ops_.push_back(new_op);
+    if (in_segment) {
+        ops_.back().last++;
+    } else {
+        auto segment_index = static_cast<std::uint32_t>(segment_ops_.size() - 1);
+        ops_.push_back(details::pattern_op{kind::segment, segment_index, segment_index + 1, 0, 0,
+                                           details::pattern_op::no_color,
+                                           details::pattern_op::no_color});
+    }
+}
+
+SPDLOG_INLINE void pattern_formatter::add_text_(std::unique_ptr<details::flag_formatter> formatter) {
+    formatters_.push_back(std::move(formatter));
+    add_op_(details::pattern_op::kind::text, formatters_.size() - 1);
+}
+
 SPDLOG_INLINE void pattern_formatter::compile_pattern_(const std::string &pattern) {
     auto end = pattern.end();
     std::unique_ptr<details::aggregate_formatter> user_chars;
     formatters_.clear();
+    ops_.clear();
+    segment_ops_.clear();
+    segment_uses_ = 0;
     for (auto it = pattern.begin(); it != end; ++it) {
         if (*it == '%') {
             if (user_chars)  // append user chars found so far
             {
-                formatters_.push_back(std::move(user_chars));
+                add_text_(std::move(user_chars));
             }
 
             auto padding = handle_padspec_(++it, end);
 
             if (it != end) {
+                if (add_inline_flag_(*it, padding)) {
+                    continue;
+                }
+                size_t first = formatters_.size();
                 if (padding.enabled()) {
                     handle_flag_<details::scoped_padder>(*it, padding);
                 } else {
                     handle_flag_<details::null_scoped_padder>(*it, padding);
                 }
+
+                bool cached = details::is_cached_flag(*it) &&
+                              custom_handlers_.find(*it) == custom_handlers_.end();
+                for (size_t i = first; i < formatters_.size(); i++) {
+                    add_op_(cached ? details::pattern_op::kind::text
+                                   : details::pattern_op::kind::formatter,
+                            i);
+                }
             } else {
                 break;
             }
@@ -1332,7 +1565,13 @@ SPDLOG_INLINE void pattern_formatter::compile_pattern_(const std::string &patter
     }
     if (user_chars)  // append raw chars found so far
     {
-        formatters_.push_back(std::move(user_chars));
+        add_text_(std::move(user_chars));
     }
+    // the eol is constant text as well
+    add_text_(details::make_unique<details::aggregate_formatter>(eol_));
+
+    last_log_secs_ = std::chrono::seconds(0);
+    cached_text_valid_ = false;
+    segments_valid_ = false;
 }
 }  // namespace spdlog
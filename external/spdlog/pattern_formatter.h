@@ -9,6 +9,7 @@
 #include <spdlog/formatter.h>
 
 #include <chrono>
+#include <cstdint>
 #include <ctime>
 #include <memory>
 
@@ -51,6 +52,47 @@ protected:
     padding_info padinfo_;
 };
 
+// one step of a compiled pattern.
+//
+// the parts of a line that rarely change between messages (literal text, the
+// date/time, the milliseconds, logger name, level and thread id) are grouped
+// into segments. a segment is rendered once and then copied as is until the
+// second, millisecond, logger, level or thread of the message changes. the
+// rest runs on every message.
+struct pattern_op {
+    enum class kind : unsigned char {
+        // segment parts
+        text,  // literal and date/time flags, rendered once per second
+        logger_name,
+        level,
+        short_level,
+        thread_id,
+        millis,
+        color_start,
+        color_stop,
+        full_logger_name,  // "[name] " if the name isn't empty (%+)
+        // run on every message
+        segment,
+        formatter,
+        payload,
+        micros,
+        nanos,
+        full_source,  // "[file:line] " if known (%+)
+        full_mdc      // "[mdc] " if not empty (%+)
+    };
+
+    static constexpr std::uint32_t no_color = 0xffffffff;
+
+    kind op;
+    std::uint32_t first;  // text: formatters_ [first, last), segment: segment_ops_
+                          // [first, last), formatter and full_mdc: formatters_[first]
+    std::uint32_t last;
+    std::uint32_t begin;  // text: range in cached_text_, segment: in segment_text_
+    std::uint32_t end;
+    std::uint32_t color_start;  // segment: color range marks, relative to begin
+    std::uint32_t color_stop;
+};
+
 }  // namespace details
 
 class SPDLOG_API custom_flag_formatter : public details::flag_formatter {
@@ -99,10 +141,43 @@ private:
     std::vector<std::unique_ptr<details::flag_formatter>> formatters_;
     custom_flags custom_handlers_;
 
+    // the compiled pattern, see details::pattern_op
+    std::vector<details::pattern_op> ops_;
+    std::vector<details::pattern_op> segment_ops_;
+    memory_buf_t cached_text_;
+    memory_buf_t segment_text_;
+    bool cached_text_valid_;
+    bool segments_valid_;
+
+    // what the segments depend on, and their values when last rendered
+    enum : unsigned {
+        uses_millis = 1,
+        uses_logger_name = 2,
+        uses_level = 4,
+        uses_thread_id = 8
+    };
+    unsigned segment_uses_;
+    std::int64_t segment_millis_;
+    std::string segment_logger_name_;
+    level::level_enum segment_level_;
+    size_t segment_thread_id_;
+
+    // "[file:line] " of the last call site seen by %+
+    source_loc last_source_;
+    memory_buf_t source_text_;
+
     std::tm get_time_(const details::log_msg &msg);
     template <typename Padder>
     void handle_flag_(char flag, details::padding_info padding);
 
+    // flags run inline by format(). false if the flag isn't one of them.
+    bool add_inline_flag_(char flag, details::padding_info padding);
+    void add_op_(details::pattern_op::kind op, size_t first = 0);
+    void add_text_(std::unique_ptr<details::flag_formatter> formatter);
+    void render_cached_text_(const details::log_msg &msg);
+    bool segments_match_(const details::log_msg &msg, std::int64_t millis) const;
+    void render_segments_(const details::log_msg &msg, std::int64_t millis);
+
     // Extract given pad spec (e.g. %8X)
     // Advance the given it pass the end of the padding spec found (if any)
     // Return padding.
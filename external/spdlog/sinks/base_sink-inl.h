@@ -28,6 +28,13 @@ void SPDLOG_INLINE spdlog::sinks::base_sink<Mutex>::log(const details::log_msg &
     sink_it_(msg);
 }
 
+template <typename Mutex>
+void SPDLOG_INLINE spdlog::sinks::base_sink<Mutex>::log_batch(const details::log_msg *msgs,
+                                                              size_t n) {
+    std::lock_guard<Mutex> lock(mutex_);
+    sink_batch_(msgs, n);
+}
+
 template <typename Mutex>
 void SPDLOG_INLINE spdlog::sinks::base_sink<Mutex>::flush() {
     std::lock_guard<Mutex> lock(mutex_);
@@ -47,6 +54,16 @@ spdlog::sinks::base_sink<Mutex>::set_formatter(std::unique_ptr<spdlog::formatter
     set_formatter_(std::move(sink_formatter));
 }
 
+template <typename Mutex>
+void SPDLOG_INLINE spdlog::sinks::base_sink<Mutex>::sink_batch_(const details::log_msg *msgs,
+                                                                size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (this->should_log(msgs[i].level)) {
+            sink_it_(msgs[i]);
+        }
+    }
+}
+
 template <typename Mutex>
 void SPDLOG_INLINE spdlog::sinks::base_sink<Mutex>::set_pattern_(const std::string &pattern) {
     set_formatter_(details::make_unique<spdlog::pattern_formatter>(pattern));
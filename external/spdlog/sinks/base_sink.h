@@ -29,6 +29,7 @@ public:
     base_sink &operator=(base_sink &&) = delete;
 
     void log(const details::log_msg &msg) final override;
+    void log_batch(const details::log_msg *msgs, size_t n) final override;
     void flush() final override;
     void set_pattern(const std::string &pattern) final override;
     void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) final override;
@@ -39,6 +40,9 @@ protected:
     Mutex mutex_;
 
     virtual void sink_it_(const details::log_msg &msg) = 0;
+    // called under the lock with the whole batch. the default calls sink_it_()
+    // for each message that passes the sink level.
+    virtual void sink_batch_(const details::log_msg *msgs, size_t n);
     virtual void flush_() = 0;
     virtual void set_pattern_(const std::string &pattern);
     virtual void set_formatter_(std::unique_ptr<spdlog::formatter> sink_formatter);
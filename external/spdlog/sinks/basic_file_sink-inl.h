@@ -39,6 +39,18 @@ SPDLOG_INLINE void basic_file_sink<Mutex>::sink_it_(const details::log_msg &msg)
     file_helper_.write(formatted);
 }
 
+// format the whole batch into one buffer and write it at once
+template <typename Mutex>
+SPDLOG_INLINE void basic_file_sink<Mutex>::sink_batch_(const details::log_msg *msgs, size_t n) {
+    batch_buf_.clear();
+    for (size_t i = 0; i < n; i++) {
+        if (base_sink<Mutex>::should_log(msgs[i].level)) {
+            base_sink<Mutex>::formatter_->format(msgs[i], batch_buf_);
+        }
+    }
+    file_helper_.write(batch_buf_);
+}
+
 template <typename Mutex>
 SPDLOG_INLINE void basic_file_sink<Mutex>::flush_() {
     file_helper_.flush();
@@ -27,10 +27,12 @@ public:
 
 protected:
     void sink_it_(const details::log_msg &msg) override;
+    void sink_batch_(const details::log_msg *msgs, size_t n) override;
     void flush_() override;
 
 private:
     details::file_helper file_helper_;
+    memory_buf_t batch_buf_;
 };
 
 using basic_file_sink_mt = basic_file_sink<std::mutex>;
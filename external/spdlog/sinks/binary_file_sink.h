@@ -0,0 +1,187 @@
+// Copyright(c) 2015-present, Gabi Melman & spdlog contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+// File sink that stores records without formatting them (see
+// SPDLOG_LOGGER_BINARY). Read the file back with details::binary_log_reader.
+// The pattern set on this sink is ignored: the reader applies one when
+// decoding.
+//
+// File layout: every time the sink opens the file it writes the magic
+// "SPDLOGB1", then a stream of records. Format strings and logger names are
+// written once, the first time they are used, and referred to by index after
+// that. Integers are varints and times are deltas to the previous record, so
+// a typical record takes 10-20 bytes.
+//
+//   1 format:  index, id (u64), format, signature, file, line, function
+//   2 logger:  index, name
+//   3 binary:  format index, logger index, level (u8), time delta (ns),
+//              thread id, compacted arguments
+//   4 text:    logger index, level (u8), time delta (ns), thread id, file,
+//              line, function, text
+//
+// Strings are a varint length followed by the bytes. Messages that weren't
+// logged with SPDLOG_LOGGER_BINARY are stored as text records.
+
+#include <spdlog/details/binary_format.h>
+#include <spdlog/details/file_helper.h>
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/details/synchronous_factory.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace spdlog {
+namespace sinks {
+
+template <typename Mutex>
+class binary_file_sink final : public base_sink<Mutex> {
+public:
+    explicit binary_file_sink(const filename_t &filename,
+                              bool truncate = false,
+                              const file_event_handlers &event_handlers = {})
+        : file_helper_{event_handlers} {
+        file_helper_.open(filename, truncate);
+        batch_buf_.append(file::magic(), file::magic() + file::magic_size);
+        file_helper_.write(batch_buf_);
+    }
+
+    const filename_t &filename() const { return file_helper_.filename(); }
+
+    bool accepts_binary() const override { return true; }
+
+protected:
+    void sink_it_(const details::log_msg &msg) override {
+        batch_buf_.clear();
+        encode_(msg);
+        file_helper_.write(batch_buf_);
+    }
+
+    void sink_batch_(const details::log_msg *msgs, size_t n) override {
+        batch_buf_.clear();
+        for (size_t i = 0; i < n; i++) {
+            if (base_sink<Mutex>::should_log(msgs[i].level)) {
+                encode_(msgs[i]);
+            }
+        }
+        file_helper_.write(batch_buf_);
+    }
+
+    void flush_() override { file_helper_.flush(); }
+
+private:
+    using file = details::binary_log_file;
+
+    details::file_helper file_helper_;
+    memory_buf_t batch_buf_;
+    std::unordered_map<const details::binary_format *, std::uint32_t> formats_;
+    std::unordered_map<std::string, std::uint32_t> loggers_;
+    std::string last_logger_;
+    std::uint32_t last_logger_index_ = 0;
+    std::int64_t last_time_ = 0;
+
+    void put_string_(string_view_t s) {
+        details::binary_put_varint(batch_buf_, s.size());
+        details::binary_put(batch_buf_, s.data(), s.size());
+    }
+
+    void put_cstring_(const char *s) { put_string_(s ? string_view_t(s) : string_view_t()); }
+
+    std::uint32_t format_index_(const details::binary_format &format) {
+        auto it = formats_.find(&format);
+        if (it != formats_.end()) {
+            return it->second;
+        }
+        auto index = static_cast<std::uint32_t>(formats_.size());
+        formats_.emplace(&format, index);
+        batch_buf_.push_back(file::format_record);
+        details::binary_put_varint(batch_buf_, index);
+        details::binary_put(batch_buf_, format.id);
+        put_string_(format.format);
+        put_cstring_(format.signature);
+        put_cstring_(format.source.filename);
+        details::binary_put_varint(batch_buf_, static_cast<std::uint64_t>(format.source.line));
+        put_cstring_(format.source.funcname);
+        return index;
+    }
+
+    std::uint32_t logger_index_(string_view_t name) {
+        if (!loggers_.empty() && string_view_t(last_logger_) == name) {
+            return last_logger_index_;
+        }
+        last_logger_.assign(name.data(), name.size());
+        auto it = loggers_.find(last_logger_);
+        if (it != loggers_.end()) {
+            last_logger_index_ = it->second;
+            return last_logger_index_;
+        }
+        last_logger_index_ = static_cast<std::uint32_t>(loggers_.size());
+        loggers_.emplace(last_logger_, last_logger_index_);
+        batch_buf_.push_back(file::logger_record);
+        details::binary_put_varint(batch_buf_, last_logger_index_);
+        put_string_(name);
+        return last_logger_index_;
+    }
+
+    void encode_(const details::log_msg &msg) {
+        // definitions go out before the record that uses them
+        auto logger_index = logger_index_(msg.logger_name);
+        if (msg.binary != nullptr) {
+            auto format_index = format_index_(*msg.binary);
+            batch_buf_.push_back(file::binary_record);
+            details::binary_put_varint(batch_buf_, format_index);
+        } else {
+            batch_buf_.push_back(file::text_record);
+        }
+        details::binary_put_varint(batch_buf_, logger_index);
+        batch_buf_.push_back(static_cast<char>(msg.level));
+        std::int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                msg.time.time_since_epoch())
+                                .count();
+        details::binary_put_varint(batch_buf_, details::binary_zigzag(time - last_time_));
+        last_time_ = time;
+        details::binary_put_varint(batch_buf_, msg.thread_id);
+
+        if (msg.binary != nullptr) {
+            details::binary_compact(msg.binary->signature, msg.payload, batch_buf_);
+        } else {
+            put_cstring_(msg.source.filename);
+            details::binary_put_varint(batch_buf_, static_cast<std::uint64_t>(msg.source.line));
+            put_cstring_(msg.source.funcname);
+            put_string_(msg.payload);
+        }
+    }
+};
+
+using binary_file_sink_mt = binary_file_sink<std::mutex>;
+using binary_file_sink_st = binary_file_sink<details::null_mutex>;
+
+}  // namespace sinks
+
+//
+// factory functions
+//
+template <typename Factory = spdlog::synchronous_factory>
+inline std::shared_ptr<logger> binary_logger_mt(const std::string &logger_name,
+                                                const filename_t &filename,
+                                                bool truncate = false,
+                                                const file_event_handlers &event_handlers = {}) {
+    return Factory::template create<sinks::binary_file_sink_mt>(logger_name, filename, truncate,
+                                                                event_handlers);
+}
+
+template <typename Factory = spdlog::synchronous_factory>
+inline std::shared_ptr<logger> binary_logger_st(const std::string &logger_name,
+                                                const filename_t &filename,
+                                                bool truncate = false,
+                                                const file_event_handlers &event_handlers = {}) {
+    return Factory::template create<sinks::binary_file_sink_st>(logger_name, filename, truncate,
+                                                                event_handlers);
+}
+
+}  // namespace spdlog
@@ -0,0 +1,463 @@
+// Copyright(c) 2015-present, Gabi Melman & spdlog contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <spdlog/common.h>
+#include <spdlog/details/file_helper.h>
+#include <spdlog/details/lz4_frame.h>
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/details/os.h>
+#include <spdlog/details/synchronous_factory.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace spdlog {
+namespace sinks {
+
+// what the background compression did so far
+struct compression_counters {
+    size_t files_compressed = 0;
+    size_t bytes_in = 0;   // size of the rotated files before compression
+    size_t bytes_out = 0;  // size of the compressed files
+    size_t files_removed = 0;
+    size_t bytes_removed = 0;  // compressed bytes removed by max_files/max_total_size
+    size_t failures = 0;
+    size_t pending = 0;  // rotated files waiting for compression
+};
+
+/*
+ * Rotating file sink based on size, compressing the rotated files with LZ4
+ * (frame format, readable with "lz4 -d"):
+ *
+ *   log.txt -> log.1.txt.lz4
+ *   log.1.txt.lz4 -> log.2.txt.lz4
+ *   ...
+ *
+ * On rotation the logging thread only renames the full file to a pending name
+ * (log.pending<n>.txt) and queues it. A background thread owned by the sink
+ * compresses it, shifts the older archives and applies retention: at most
+ * max_files archives and, if max_total_size isn't 0, at most max_total_size
+ * compressed bytes (the oldest archives go first). Pending files left by a
+ * previous run are compressed on open.
+ *
+ * If compressing fails, the pending file stays queued and is counted in
+ * counters().failures. It is retried after the next rotation, or on the next
+ * open if the sink is closed first.
+ */
+template <typename Mutex>
+class compressed_rotating_file_sink final : public base_sink<Mutex> {
+public:
+    compressed_rotating_file_sink(filename_t base_filename,
+                                  std::size_t max_size,
+                                  std::size_t max_files,
+                                  std::size_t max_total_size = 0,
+                                  bool rotate_on_open = false,
+                                  const file_event_handlers &event_handlers = {})
+        : base_filename_(std::move(base_filename)),
+          max_size_(max_size),
+          max_files_(max_files),
+          max_total_size_(max_total_size),
+          file_helper_{event_handlers} {
+        if (max_size == 0) {
+            throw_spdlog_ex("compressed rotating sink constructor: max_size arg cannot be zero");
+        }
+        if (max_files > 200000) {
+            throw_spdlog_ex(
+                "compressed rotating sink constructor: max_files arg cannot exceed 200000");
+        }
+        file_helper_.open(base_filename_);
+        current_size_ = file_helper_.size();  // expensive. called only once
+
+        scan_archives_();
+        scan_pending_();
+        if (rotate_on_open && current_size_ > 0) {
+            rotate_();
+            current_size_ = 0;
+        }
+        worker_ = std::thread([this] { worker_loop_(); });
+    }
+
+    ~compressed_rotating_file_sink() override {
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            stop_ = true;
+        }
+        jobs_cv_.notify_all();
+        worker_.join();
+    }
+
+    compressed_rotating_file_sink(const compressed_rotating_file_sink &) = delete;
+    compressed_rotating_file_sink &operator=(const compressed_rotating_file_sink &) = delete;
+
+    // e.g. calc_filename("logs/mylog.txt", 3) => "logs/mylog.3.txt.lz4".
+    static filename_t calc_filename(const filename_t &filename, std::size_t index) {
+        if (index == 0u) {
+            return filename;
+        }
+        filename_t basename, ext;
+        std::tie(basename, ext) = details::file_helper::split_by_extension(filename);
+        return fmt_lib::format(SPDLOG_FMT_STRING(SPDLOG_FILENAME_T("{}.{}{}.lz4")), basename,
+                               index, ext);
+    }
+
+    filename_t filename() {
+        std::lock_guard<Mutex> lock(base_sink<Mutex>::mutex_);
+        return file_helper_.filename();
+    }
+
+    void rotate_now() {
+        std::lock_guard<Mutex> lock(base_sink<Mutex>::mutex_);
+        rotate_();
+        current_size_ = 0;
+    }
+
+    compression_counters counters() {
+        std::lock_guard<std::mutex> lock(jobs_mutex_);
+        compression_counters result = counters_;
+        result.pending = jobs_.size();
+        return result;
+    }
+
+    // block until every file rotated so far is compressed
+    void wait_for_compression() {
+        std::unique_lock<std::mutex> lock(jobs_mutex_);
+        idle_cv_.wait(lock, [this] { return jobs_.size() == stalled_; });
+    }
+
+protected:
+    void sink_it_(const details::log_msg &msg) override {
+        memory_buf_t formatted;
+        base_sink<Mutex>::formatter_->format(msg, formatted);
+        auto new_size = current_size_ + formatted.size();
+
+        // same as rotating_file_sink: rotate only if the real size > 0
+        if (new_size > max_size_) {
+            file_helper_.flush();
+            if (file_helper_.size() > 0) {
+                rotate_();
+                new_size = formatted.size();
+            }
+        }
+        file_helper_.write(formatted);
+        current_size_ = new_size;
+    }
+
+    void sink_batch_(const details::log_msg *msgs, size_t n) override {
+        batch_buf_.clear();
+        for (size_t i = 0; i < n; i++) {
+            if (!base_sink<Mutex>::should_log(msgs[i].level)) {
+                continue;
+            }
+            auto pending_size = batch_buf_.size();
+            base_sink<Mutex>::formatter_->format(msgs[i], batch_buf_);
+            if (current_size_ + batch_buf_.size() <= max_size_) {
+                continue;
+            }
+
+            memory_buf_t formatted;
+            formatted.append(batch_buf_.data() + pending_size,
+                             batch_buf_.data() + batch_buf_.size());
+            batch_buf_.resize(pending_size);
+            file_helper_.write(batch_buf_);
+            current_size_ += pending_size;
+            batch_buf_.clear();
+
+            file_helper_.flush();
+            if (file_helper_.size() > 0) {
+                rotate_();
+                current_size_ = 0;
+            }
+            batch_buf_.append(formatted.data(), formatted.data() + formatted.size());
+        }
+        file_helper_.write(batch_buf_);
+        current_size_ += batch_buf_.size();
+    }
+
+    void flush_() override { file_helper_.flush(); }
+
+private:
+    filename_t base_filename_;
+    std::size_t max_size_;
+    std::size_t max_files_;
+    std::size_t max_total_size_;
+    std::size_t current_size_ = 0;
+    details::file_helper file_helper_;
+    memory_buf_t batch_buf_;
+    size_t next_pending_ = 0;
+
+    // shared with the worker
+    std::mutex jobs_mutex_;
+    std::condition_variable jobs_cv_;
+    std::condition_variable idle_cv_;
+    std::deque<filename_t> jobs_;  // the front one is being compressed
+    size_t stalled_ = 0;  // jobs_.size() when the front one failed, 0 otherwise
+    bool stop_ = false;
+    compression_counters counters_;
+
+    // worker only
+    std::vector<size_t> archive_sizes_;  // newest first
+    std::thread worker_;
+
+    filename_t pending_filename_(size_t n) const {
+        filename_t basename, ext;
+        std::tie(basename, ext) = details::file_helper::split_by_extension(base_filename_);
+        return fmt_lib::format(SPDLOG_FMT_STRING(SPDLOG_FILENAME_T("{}.pending{}{}")), basename, n,
+                               ext);
+    }
+
+    // move the full file out of the way and queue it. runs on the logging thread,
+    // so it does nothing more expensive than a rename.
+    void rotate_() {
+        file_helper_.close();
+        if (max_files_ == 0) {
+            file_helper_.reopen(true);
+            return;
+        }
+
+        filename_t pending;
+        do {
+            pending = pending_filename_(++next_pending_);
+        } while (details::os::path_exists(pending));
+        if (!rename_file_(base_filename_, pending)) {
+            // if failed try again after a small delay (see rotating_file_sink)
+            details::os::sleep_for_millis(100);
+            if (!rename_file_(base_filename_, pending)) {
+                file_helper_.reopen(true);  // truncate the log file anyway
+                current_size_ = 0;
+                throw_spdlog_ex("compressed_rotating_file_sink: failed renaming " +
+                                    details::os::filename_to_str(base_filename_) + " to " +
+                                    details::os::filename_to_str(pending),
+                                errno);
+            }
+        }
+        file_helper_.reopen(true);
+
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            jobs_.push_back(std::move(pending));
+        }
+        jobs_cv_.notify_one();
+    }
+
+    static bool rename_file_(const filename_t &src_filename, const filename_t &target_filename) {
+        (void)details::os::remove(target_filename);
+        return details::os::rename(src_filename, target_filename) == 0;
+    }
+
+    static size_t file_size_(const filename_t &filename) {
+        std::FILE *fd = nullptr;
+        if (details::os::fopen_s(&fd, filename, SPDLOG_FILENAME_T("rb"))) {
+            return 0;
+        }
+        size_t size = details::os::filesize(fd);
+        std::fclose(fd);
+        return size;
+    }
+
+    void scan_archives_() {
+        for (size_t i = 1; i <= max_files_; i++) {
+            auto archive = calc_filename(base_filename_, i);
+            if (!details::os::path_exists(archive)) {
+                break;
+            }
+            archive_sizes_.push_back(file_size_(archive));
+        }
+    }
+
+    // queue the pending files left by a previous run, oldest (lowest number) first.
+    // the worker removes them in order, so after a crash they usually don't start at 1.
+    void scan_pending_() {
+        filename_t basename, ext;
+        std::tie(basename, ext) = details::file_helper::split_by_extension(base_filename_);
+        auto dir = details::os::dir_name(basename);
+        if (dir.empty()) {
+            dir = SPDLOG_FILENAME_T(".");  // bare file name: the working directory
+        }
+        auto sep = basename.find_last_of(details::os::folder_seps_filename);
+        auto prefix = (sep == filename_t::npos ? basename : basename.substr(sep + 1)) +
+                      SPDLOG_FILENAME_T(".pending");
+
+        std::vector<filename_t> names;
+        if (!details::os::list_dir(dir, names)) {
+            return;
+        }
+        std::vector<size_t> numbers;
+        for (const auto &name : names) {
+            if (name.size() <= prefix.size() + ext.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+                name.compare(name.size() - ext.size(), ext.size(), ext) != 0) {
+                continue;
+            }
+            size_t n = 0;
+            size_t end = name.size() - ext.size();
+            size_t pos = prefix.size();
+            for (; pos < end && name[pos] >= '0' && name[pos] <= '9'; pos++) {
+                n = n * 10 + static_cast<size_t>(name[pos] - '0');
+            }
+            if (pos == end && n > 0) {
+                numbers.push_back(n);
+            }
+        }
+        std::sort(numbers.begin(), numbers.end());
+        for (auto n : numbers) {
+            jobs_.push_back(pending_filename_(n));
+        }
+        if (!numbers.empty()) {
+            next_pending_ = numbers.back();
+        }
+    }
+
+    void worker_loop_() {
+        for (;;) {
+            filename_t pending;
+            {
+                std::unique_lock<std::mutex> lock(jobs_mutex_);
+                jobs_cv_.wait(lock, [this] { return stop_ || jobs_.size() > stalled_; });
+                if (jobs_.size() <= stalled_) {
+                    return;  // stopped, and nothing queued can be compressed now
+                }
+                pending = jobs_.front();
+            }
+
+            compression_counters done;
+            bool ok = false;
+            SPDLOG_TRY {
+                compress_(pending, done);
+                ok = true;
+            }
+            SPDLOG_CATCH_STD
+            if (!ok) {
+                recover_();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                // keep a failed file at the front so the archives stay in order,
+                // and wait for the next rotation before trying it again
+                if (ok) {
+                    jobs_.pop_front();
+                    stalled_ = 0;
+                } else {
+                    stalled_ = jobs_.size();
+                }
+                counters_.files_compressed += done.files_compressed;
+                counters_.bytes_in += done.bytes_in;
+                counters_.bytes_out += done.bytes_out;
+                counters_.files_removed += done.files_removed;
+                counters_.bytes_removed += done.bytes_removed;
+                counters_.failures += ok ? 0 : 1;
+            }
+            idle_cv_.notify_all();
+        }
+    }
+
+    // compress the pending file, make it archive 1 and apply the retention limits
+    void compress_(const filename_t &pending, compression_counters &done) {
+        auto first = calc_filename(base_filename_, 1);
+        auto temp = first + SPDLOG_FILENAME_T(".tmp");
+        size_t in_size = 0;
+        size_t out_size = details::lz4_frame::compress_file(pending, temp, &in_size);
+
+        // shift log.N.txt.lz4 -> log.N+1.txt.lz4, dropping what falls off max_files
+        for (size_t i = archive_sizes_.size(); i > 0; i--) {
+            auto src = calc_filename(base_filename_, i);
+            if (i >= max_files_) {
+                remove_archive_(src, archive_sizes_[i - 1], done);
+                archive_sizes_.pop_back();
+            } else if (!rename_file_(src, calc_filename(base_filename_, i + 1)) &&
+                       details::os::path_exists(src)) {  // removed by someone else is fine
+                throw_spdlog_ex("compressed_rotating_file_sink: failed renaming " +
+                                    details::os::filename_to_str(src),
+                                errno);
+            }
+        }
+        if (!rename_file_(temp, first)) {
+            throw_spdlog_ex("compressed_rotating_file_sink: failed renaming " +
+                                details::os::filename_to_str(temp),
+                            errno);
+        }
+        archive_sizes_.insert(archive_sizes_.begin(), out_size);
+        (void)details::os::remove(pending);
+        done.files_compressed = 1;
+        done.bytes_in = in_size;
+        done.bytes_out = out_size;
+
+        if (max_total_size_ > 0) {
+            size_t total = 0;
+            for (auto size : archive_sizes_) {
+                total += size;
+            }
+            while (total > max_total_size_ && !archive_sizes_.empty()) {
+                total -= archive_sizes_.back();
+                remove_archive_(calc_filename(base_filename_, archive_sizes_.size()),
+                                archive_sizes_.back(), done);
+                archive_sizes_.pop_back();
+            }
+        }
+    }
+
+    // a failed compress_ may leave the temp file behind and the archives
+    // partially shifted: drop the former and take the sizes from the disk
+    void recover_() {
+        (void)details::os::remove(calc_filename(base_filename_, 1) + SPDLOG_FILENAME_T(".tmp"));
+        archive_sizes_.clear();
+        scan_archives_();
+    }
+
+    static void remove_archive_(const filename_t &filename,
+                                size_t size,
+                                compression_counters &done) {
+        if (details::os::remove(filename) == 0) {
+            done.files_removed++;
+            done.bytes_removed += size;
+        }
+    }
+};
+
+using compressed_rotating_file_sink_mt = compressed_rotating_file_sink<std::mutex>;
+using compressed_rotating_file_sink_st = compressed_rotating_file_sink<details::null_mutex>;
+
+}  // namespace sinks
+
+//
+// factory functions
+//
+
+template <typename Factory = spdlog::synchronous_factory>
+inline std::shared_ptr<logger> compressed_rotating_logger_mt(
+    const std::string &logger_name,
+    const filename_t &filename,
+    size_t max_file_size,
+    size_t max_files,
+    size_t max_total_size = 0,
+    bool rotate_on_open = false,
+    const file_event_handlers &event_handlers = {}) {
+    return Factory::template create<sinks::compressed_rotating_file_sink_mt>(
+        logger_name, filename, max_file_size, max_files, max_total_size, rotate_on_open,
+        event_handlers);
+}
+
+template <typename Factory = spdlog::synchronous_factory>
+inline std::shared_ptr<logger> compressed_rotating_logger_st(
+    const std::string &logger_name,
+    const filename_t &filename,
+    size_t max_file_size,
+    size_t max_files,
+    size_t max_total_size = 0,
+    bool rotate_on_open = false,
+    const file_event_handlers &event_handlers = {}) {
+    return Factory::template create<sinks::compressed_rotating_file_sink_st>(
+        logger_name, filename, max_file_size, max_files, max_total_size, rotate_on_open,
+        event_handlers);
+}
+}  // namespace spdlog
@@ -121,6 +121,37 @@ protected:
         }
     }
 
+    // format the batch into one buffer and write it at once, splitting it where
+    // a message falls into the next rotation period
+    void sink_batch_(const details::log_msg *msgs, size_t n) override {
+        bool rotated = false;
+        batch_buf_.clear();
+        for (size_t i = 0; i < n; i++) {
+            if (!base_sink<Mutex>::should_log(msgs[i].level)) {
+                continue;
+            }
+            auto time = msgs[i].time;
+            if (time >= rotation_tp_) {
+                file_helper_.write(batch_buf_);
+                batch_buf_.clear();
+                if (rotated && max_files_ > 0) {
+                    delete_old_();
+                }
+                auto filename = FileNameCalc::calc_filename(base_filename_, now_tm(time));
+                file_helper_.open(filename, truncate_);
+                rotation_tp_ = next_rotation_tp_();
+                rotated = true;
+            }
+            base_sink<Mutex>::formatter_->format(msgs[i], batch_buf_);
+        }
+        file_helper_.write(batch_buf_);
+
+        // Do the cleaning only at the end because it might throw on failure.
+        if (rotated && max_files_ > 0) {
+            delete_old_();
+        }
+    }
+
     void flush_() override { file_helper_.flush(); }
 
 private:
@@ -189,6 +220,7 @@ private:
     bool truncate_;
     uint16_t max_files_;
     details::circular_q<filename_t> filenames_q_;
+    memory_buf_t batch_buf_;
 };
 
 using daily_file_sink_mt = daily_file_sink<std::mutex>;
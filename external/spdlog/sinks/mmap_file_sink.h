@@ -0,0 +1,414 @@
+// Copyright(c) 2015-present, Gabi Melman & spdlog contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <spdlog/common.h>
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/details/os.h>
+#include <spdlog/details/synchronous_factory.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#ifdef _WIN32
+    #include <spdlog/details/windows_include.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace spdlog {
+namespace sinks {
+/*
+ * Append-only file sink writing through a memory mapping instead of stdio.
+ *
+ * The file grows in preallocated segments (fallocate on Linux, so running out
+ * of disk space fails at roll time rather than as SIGBUS on a store).
+ * Only the current segment is mapped. Formatted records are copied in
+ * with a bump pointer, and the next segment is mapped when it fills up.
+ * On close the file is truncated to the real length.
+ *
+ * flush() is free unless sync_on_flush is set, in which case it msyncs the
+ * pages written since the last flush (combine with flush_on()/flush_every()
+ * for crash-safe durability). After a crash the file may end with the zeroed
+ * tail of the last segment. Reopening it in append mode trims that tail.
+ */
+template <typename Mutex>
+class mmap_file_sink final : public base_sink<Mutex> {
+public:
+    static constexpr size_t default_segment_size = 4 * 1024 * 1024;
+
+    explicit mmap_file_sink(const filename_t &filename,
+                            bool truncate = false,
+                            size_t segment_size = default_segment_size,
+                            bool sync_on_flush = false)
+        : filename_(filename),
+          segment_size_(round_segment_size_(segment_size)),
+          sync_on_flush_(sync_on_flush) {
+        details::os::create_dir(details::os::dir_name(filename_));
+        open_(truncate);
+        // the destructor does not run if the constructor throws
+        release_guard guard{this};
+        length_ = truncate ? 0 : recover_length_();
+        synced_ = length_;
+        map_segment_(length_ - length_ % segment_size_);
+        guard.owner = nullptr;
+    }
+
+    ~mmap_file_sink() override {
+        SPDLOG_TRY { close_(); }
+        SPDLOG_CATCH_STD
+    }
+
+    mmap_file_sink(const mmap_file_sink &) = delete;
+    mmap_file_sink &operator=(const mmap_file_sink &) = delete;
+
+    const filename_t &filename() const { return filename_; }
+
+    // bytes written so far (the file is larger until it is closed)
+    size_t length() {
+        std::lock_guard<Mutex> lock(base_sink<Mutex>::mutex_);
+        return length_;
+    }
+
+protected:
+    void sink_it_(const details::log_msg &msg) override {
+        memory_buf_t formatted;
+        base_sink<Mutex>::formatter_->format(msg, formatted);
+        append_(formatted.data(), formatted.size());
+    }
+
+    void sink_batch_(const details::log_msg *msgs, size_t n) override {
+        batch_buf_.clear();
+        for (size_t i = 0; i < n; i++) {
+            if (base_sink<Mutex>::should_log(msgs[i].level)) {
+                base_sink<Mutex>::formatter_->format(msgs[i], batch_buf_);
+            }
+        }
+        append_(batch_buf_.data(), batch_buf_.size());
+    }
+
+    void flush_() override {
+        if (!sync_on_flush_ || synced_ == length_) {
+            return;
+        }
+        sync_(synced_ < map_offset_ ? map_offset_ : synced_, length_);
+        synced_ = length_;
+    }
+
+private:
+    filename_t filename_;
+    size_t segment_size_;
+    bool sync_on_flush_;
+    size_t length_ = 0;     // logical end of the log
+    size_t synced_ = 0;     // end of the range already msync'ed
+    size_t map_offset_ = 0; // file offset of the mapped segment
+    char *map_ = nullptr;
+    memory_buf_t batch_buf_;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = NULL;
+#else
+    int fd_ = -1;
+#endif
+
+    void append_(const char *data, size_t size) {
+        while (size > 0) {
+            size_t used = length_ - map_offset_;
+            if (used == segment_size_) {
+                // sync what is pending while the segment is still mapped
+                if (sync_on_flush_ && synced_ < length_) {
+                    sync_(synced_ < map_offset_ ? map_offset_ : synced_, length_);
+                    synced_ = length_;
+                }
+                map_segment_(map_offset_ + segment_size_);
+                used = 0;
+            }
+            size_t n = std::min(size, segment_size_ - used);
+            std::memcpy(map_ + used, data, n);
+            length_ += n;
+            data += n;
+            size -= n;
+        }
+    }
+
+    // closes the file without trimming it, unless dismissed
+    struct release_guard {
+        mmap_file_sink *owner;
+        ~release_guard() {
+            if (owner != nullptr) {
+                owner->release_();
+            }
+        }
+    };
+
+#ifdef _WIN32
+    void throw_error_(const std::string &what) {
+        throw_spdlog_ex(what + " " + details::os::filename_to_str(filename_) +
+                        ". GetLastError(): " + std::to_string(::GetLastError()));
+    }
+
+    static size_t round_segment_size_(size_t size) {
+        SYSTEM_INFO info;
+        ::GetSystemInfo(&info);
+        size_t granularity = info.dwAllocationGranularity;
+        size = std::max(size, granularity);
+        return (size + granularity - 1) / granularity * granularity;
+    }
+
+    void open_(bool truncate) {
+    #ifdef SPDLOG_WCHAR_FILENAMES
+        file_ = ::CreateFileW(filename_.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                              NULL, truncate ? CREATE_ALWAYS : OPEN_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    #else
+        file_ = ::CreateFileA(filename_.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                              NULL, truncate ? CREATE_ALWAYS : OPEN_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    #endif
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw_error_("Failed opening file");
+        }
+    }
+
+    // the mapping extends the file to cover the segment
+    void map_segment_(size_t offset) {
+        unmap_();
+        unsigned long long end = static_cast<unsigned long long>(offset) + segment_size_;
+        mapping_ = ::CreateFileMappingW(file_, NULL, PAGE_READWRITE, static_cast<DWORD>(end >> 32),
+                                        static_cast<DWORD>(end & 0xffffffff), NULL);
+        if (mapping_ == NULL) {
+            throw_error_("Failed creating file mapping for");
+        }
+        unsigned long long start = offset;
+        map_ = static_cast<char *>(::MapViewOfFile(mapping_, FILE_MAP_WRITE,
+                                                   static_cast<DWORD>(start >> 32),
+                                                   static_cast<DWORD>(start & 0xffffffff),
+                                                   segment_size_));
+        if (map_ == nullptr) {
+            throw_error_("Failed mapping file");
+        }
+        map_offset_ = offset;
+    }
+
+    void unmap_() {
+        if (map_ != nullptr) {
+            ::UnmapViewOfFile(map_);
+            map_ = nullptr;
+        }
+        if (mapping_ != NULL) {
+            ::CloseHandle(mapping_);
+            mapping_ = NULL;
+        }
+    }
+
+    void sync_(size_t begin, size_t end) {
+        if (!::FlushViewOfFile(map_ + (begin - map_offset_), end - begin) ||
+            !::FlushFileBuffers(file_)) {
+            throw_error_("Failed syncing file");
+        }
+    }
+
+    size_t file_size_() {
+        LARGE_INTEGER size;
+        if (!::GetFileSizeEx(file_, &size)) {
+            throw_error_("Failed getting file size of");
+        }
+        return static_cast<size_t>(size.QuadPart);
+    }
+
+    size_t read_at_(char *buf, size_t size, size_t offset) {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(offset & 0xffffffff);
+        overlapped.OffsetHigh = static_cast<DWORD>(static_cast<unsigned long long>(offset) >> 32);
+        DWORD read = 0;
+        if (!::ReadFile(file_, buf, static_cast<DWORD>(size), &read, &overlapped)) {
+            throw_error_("Failed reading file");
+        }
+        return read;
+    }
+
+    void close_() {
+        if (file_ == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        unmap_();
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(length_);
+        ::SetFilePointerEx(file_, end, NULL, FILE_BEGIN);
+        ::SetEndOfFile(file_);
+        release_();
+    }
+
+    void release_() {
+        unmap_();
+        if (file_ != INVALID_HANDLE_VALUE) {
+            ::CloseHandle(file_);
+            file_ = INVALID_HANDLE_VALUE;
+        }
+    }
+#else
+    void throw_error_(const std::string &what) {
+        throw_spdlog_ex(what + " " + details::os::filename_to_str(filename_), errno);
+    }
+
+    static size_t round_segment_size_(size_t size) {
+        size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size = std::max(size, page);
+        return (size + page - 1) / page * page;
+    }
+
+    void open_(bool truncate) {
+        int flags = O_RDWR | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0);
+        fd_ = ::open(filename_.c_str(), flags, 0644);
+        if (fd_ == -1) {
+            throw_error_("Failed opening file");
+        }
+    }
+
+    // reserve the blocks for the segment, then map it
+    void map_segment_(size_t offset) {
+        unmap_();
+        auto end = static_cast<off_t>(offset + segment_size_);
+    #ifdef __linux__
+        if (::fallocate(fd_, 0, static_cast<off_t>(offset), static_cast<off_t>(segment_size_)) != 0 &&
+            (errno != EOPNOTSUPP || ::ftruncate(fd_, end) != 0)) {
+            throw_error_("Failed allocating segment in");
+        }
+    #else
+        struct stat st;
+        if (::fstat(fd_, &st) != 0 || (st.st_size < end && ::ftruncate(fd_, end) != 0)) {
+            throw_error_("Failed allocating segment in");
+        }
+    #endif
+        int flags = MAP_SHARED;
+    #ifdef MAP_POPULATE
+        flags |= MAP_POPULATE;  // fault the segment in now, not one page per append
+    #endif
+        void *map = ::mmap(nullptr, segment_size_, PROT_READ | PROT_WRITE, flags, fd_,
+                           static_cast<off_t>(offset));
+        if (map == MAP_FAILED) {
+            throw_error_("Failed mapping file");
+        }
+        map_ = static_cast<char *>(map);
+        map_offset_ = offset;
+    }
+
+    void unmap_() {
+        if (map_ != nullptr) {
+            ::munmap(map_, segment_size_);
+            map_ = nullptr;
+        }
+    }
+
+    // msync needs a page aligned start
+    void sync_(size_t begin, size_t end) {
+        size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t from = (begin - map_offset_) / page * page;
+        if (::msync(map_ + from, end - map_offset_ - from, MS_SYNC) != 0) {
+            throw_error_("Failed syncing file");
+        }
+    }
+
+    size_t file_size_() {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) {
+            throw_error_("Failed getting file size of");
+        }
+        return static_cast<size_t>(st.st_size);
+    }
+
+    size_t read_at_(char *buf, size_t size, size_t offset) {
+        ssize_t n = ::pread(fd_, buf, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            throw_error_("Failed reading file");
+        }
+        return static_cast<size_t>(n);
+    }
+
+    void close_() {
+        if (fd_ == -1) {
+            return;
+        }
+        unmap_();
+        if (::ftruncate(fd_, static_cast<off_t>(length_)) != 0) {
+            int err = errno;
+            release_();
+            throw_spdlog_ex("Failed truncating file " + details::os::filename_to_str(filename_),
+                            err);
+        }
+        release_();
+    }
+
+    void release_() {
+        unmap_();
+        if (fd_ != -1) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+#endif
+
+    // a file left behind by a crash ends with the unused, zero filled part of
+    // its last segment: the log ends at the last non-zero byte before it
+    size_t recover_length_() {
+        size_t size = file_size_();
+        size_t limit = size > segment_size_ ? size - segment_size_ : 0;
+        char buf[4096];
+        size_t end = size;
+        while (end > limit) {
+            size_t chunk = std::min(sizeof(buf), end - limit);
+            size_t n = read_at_(buf, chunk, end - chunk);
+            if (n != chunk) {
+                break;
+            }
+            size_t i = chunk;
+            while (i > 0 && buf[i - 1] == '\0') {
+                i--;
+            }
+            if (i > 0) {
+                return end - chunk + i;
+            }
+            end -= chunk;
+        }
+        return end;
+    }
+};
+
+using mmap_file_sink_mt = mmap_file_sink<std::mutex>;
+using mmap_file_sink_st = mmap_file_sink<details::null_mutex>;
+
+}  // namespace sinks
+
+//
+// factory functions
+//
+template <typename Factory = spdlog::synchronous_factory>
+inline std::shared_ptr<logger> mmap_logger_mt(
+    const std::string &logger_name,
+    const filename_t &filename,
+    bool truncate = false,
+    size_t segment_size = sinks::mmap_file_sink_mt::default_segment_size,
+    bool sync_on_flush = false) {
+    return Factory::template create<sinks::mmap_file_sink_mt>(logger_name, filename, truncate,
+                                                              segment_size, sync_on_flush);
+}
+
+template <typename Factory = spdlog::synchronous_factory>
+inline std::shared_ptr<logger> mmap_logger_st(
+    const std::string &logger_name,
+    const filename_t &filename,
+    bool truncate = false,
+    size_t segment_size = sinks::mmap_file_sink_st::default_segment_size,
+    bool sync_on_flush = false) {
+    return Factory::template create<sinks::mmap_file_sink_st>(logger_name, filename, truncate,
+                                                              segment_size, sync_on_flush);
+}
+}  // namespace spdlog
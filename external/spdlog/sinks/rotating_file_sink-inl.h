@@ -95,6 +95,41 @@ SPDLOG_INLINE void rotating_file_sink<Mutex>::sink_it_(const details::log_msg &m
     current_size_ = new_size;
 }
 
+// format the batch into one buffer and write it at once. if a message would
+// push the file over max_size_, write what precedes it and rotate first, same
+// as sink_it_() does.
+template <typename Mutex>
+SPDLOG_INLINE void rotating_file_sink<Mutex>::sink_batch_(const details::log_msg *msgs,
+                                                          size_t n) {
+    batch_buf_.clear();
+    for (size_t i = 0; i < n; i++) {
+        if (!base_sink<Mutex>::should_log(msgs[i].level)) {
+            continue;
+        }
+        auto pending_size = batch_buf_.size();
+        base_sink<Mutex>::formatter_->format(msgs[i], batch_buf_);
+        if (current_size_ + batch_buf_.size() <= max_size_) {
+            continue;
+        }
+
+        memory_buf_t formatted;
+        formatted.append(batch_buf_.data() + pending_size, batch_buf_.data() + batch_buf_.size());
+        batch_buf_.resize(pending_size);
+        file_helper_.write(batch_buf_);
+        current_size_ += pending_size;
+        batch_buf_.clear();
+
+        file_helper_.flush();
+        if (file_helper_.size() > 0) {
+            rotate_();
+            current_size_ = 0;
+        }
+        batch_buf_.append(formatted.data(), formatted.data() + formatted.size());
+    }
+    file_helper_.write(batch_buf_);
+    current_size_ += batch_buf_.size();
+}
+
 template <typename Mutex>
 SPDLOG_INLINE void rotating_file_sink<Mutex>::flush_() {
     file_helper_.flush();
@@ -32,6 +32,7 @@ public:
 
 protected:
     void sink_it_(const details::log_msg &msg) override;
+    void sink_batch_(const details::log_msg *msgs, size_t n) override;
     void flush_() override;
 
 private:
@@ -51,6 +52,7 @@ private:
     std::size_t max_files_;
     std::size_t current_size_;
     details::file_helper file_helper_;
+    memory_buf_t batch_buf_;
 };
 
 using rotating_file_sink_mt = rotating_file_sink<std::mutex>;
@@ -9,6 +9,16 @@
 
 #include <spdlog/common.h>
 
+SPDLOG_INLINE void spdlog::sinks::sink::log_batch(const details::log_msg *msgs, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (should_log(msgs[i].level)) {
+            log(msgs[i]);
+        }
+    }
+}
+
+SPDLOG_INLINE bool spdlog::sinks::sink::accepts_binary() const { return false; }
+
 SPDLOG_INLINE bool spdlog::sinks::sink::should_log(spdlog::level::level_enum msg_level) const {
     return msg_level >= level_.load(std::memory_order_relaxed);
 }
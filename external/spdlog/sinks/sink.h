@@ -13,9 +13,15 @@ class SPDLOG_API sink {
 public:
     virtual ~sink() = default;
     virtual void log(const details::log_msg &msg) = 0;
+    // log n consecutive messages, skipping those below the sink level.
+    // the default logs them one by one.
+    virtual void log_batch(const details::log_msg *msgs, size_t n);
     virtual void flush() = 0;
     virtual void set_pattern(const std::string &pattern) = 0;
     virtual void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) = 0;
+    // true if the sink stores binary (deferred formatting) records as they are.
+    // other sinks get such messages with the payload already formatted.
+    virtual bool accepts_binary() const;
 
     void set_level(level::level_enum log_level);
     level::level_enum level() const;
@@ -291,6 +291,26 @@ inline void critical(const T &msg) {
         (logger)->log(spdlog::source_loc{}, level, __VA_ARGS__)
 #endif
 
+// deferred formatting: the arguments are recorded raw and formatted later (see
+// logger::log_binary). each use gets its own static binary_format.
+#ifndef SPDLOG_NO_SOURCE_LOC
+    #define SPDLOG_LOGGER_BINARY(logger, level, ...)                                          \
+        do {                                                                                  \
+            static spdlog::details::binary_format spdlog_binary_format_;                      \
+            (logger)->log_binary(spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}, level, \
+                                 spdlog_binary_format_, __VA_ARGS__);                         \
+        } while (0)
+#else
+    #define SPDLOG_LOGGER_BINARY(logger, level, ...)                                          \
+        do {                                                                                  \
+            static spdlog::details::binary_format spdlog_binary_format_;                      \
+            (logger)->log_binary(spdlog::source_loc{}, level, spdlog_binary_format_,          \
+                                 __VA_ARGS__);                                                \
+        } while (0)
+#endif
+#define SPDLOG_BINARY(level, ...) \
+    SPDLOG_LOGGER_BINARY(spdlog::default_logger_raw(), level, __VA_ARGS__)
+
 #if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
     #define SPDLOG_LOGGER_TRACE(logger, ...) \
         SPDLOG_LOGGER_CALL(logger, spdlog::level::trace, __VA_ARGS__)
@@ -45,6 +45,34 @@
 // #define SPDLOG_NO_TLS
 ///////////////////////////////////////////////////////////////////////////////
 
+///////////////////////////////////////////////////////////////////////////////
+// Uncomment to use a lock-free queue (per-slot sequence numbers) in the async
+// thread pool instead of the mutex/condition-variable queue.
+// Producers never take a lock; the worker spins briefly and then parks when
+// the queue is empty. Overflow policies and counters behave the same.
+//
+// #define SPDLOG_LOCKFREE_QUEUE
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Uncomment to stage async log messages in a per-thread ring instead of posting
+// each one to the shared queue. The thread pool drains the rings in batches.
+// Requires thread local storage. With overrun_oldest, a full ring drops the new
+// message, since the oldest one already belongs to the worker.
+// A logger stays referenced by each thread that logged to it until that thread
+// exits or the thread pool is destroyed.
+//
+// #define SPDLOG_ASYNC_STAGING
+// #define SPDLOG_ASYNC_STAGING_BYTES (64 * 1024)
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Uncomment to change the size of a backtrace slot (see enable_backtrace()).
+// Each thread keeps n_messages slots per logger; longer messages are truncated.
+//
+// #define SPDLOG_BACKTRACE_SLOT_BYTES 512
+///////////////////////////////////////////////////////////////////////////////
+
 ///////////////////////////////////////////////////////////////////////////////
 // Uncomment to avoid spdlog's usage of atomic log levels
 // Use only if your code never modifies a logger's log levels concurrently by
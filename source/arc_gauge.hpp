@@ -0,0 +1,194 @@
+// 圆形仪表、饼图、圆环控件
+// 和 ImDrawList 的 ArcFastVtx 一样，用一张预先算好的单位圆查找表代替每段都调用 cosf/sinf：
+// 中间的顶点直接取表项，任意角度的起点和终点在相邻两个表项之间线性插值。
+// 每个形状（背景、扇形或圆弧）都只生成一条路径、一次填充或描边，所有仪表都落在同一条绘制命令里。
+//
+// 角度按屏幕坐标（y 向下），角度增大为顺时针，0 是 3 点钟方向，-ARC_PI/2 是 12 点钟方向。
+#pragma once
+#include "imgui/imgui.h"
+#include "draw_list_cache.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <unordered_map>
+
+constexpr float ARC_PI = 3.14159265358979323846f;
+
+// 单位圆查找表：SIZE 个等分点，最后多存一个等于第一个的点，插值时不用取模
+class ArcTable {
+public:
+    static const int SIZE = 512;
+
+    static const ArcTable& Get() {
+        static const ArcTable table;
+        return table;
+    }
+
+    // 第 index 个等分点，index 可以是任意整数
+    const ImVec2& Sample(int index) const {
+        index %= SIZE;
+        return points[index < 0 ? index + SIZE : index];
+    }
+
+    // 任意位置（以等分点为单位）的点，在相邻两个等分点之间插值
+    ImVec2 At(float sample) const {
+        sample -= floorf(sample / SIZE) * SIZE;
+        int i = (int)sample;
+        if (i >= SIZE) i = SIZE - 1;
+        float t = sample - (float)i;
+        const ImVec2& a = points[i];
+        const ImVec2& b = points[i + 1];
+        return ImVec2(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+    }
+
+    static float ToSample(float angle) { return angle * (SIZE / (2.0f * ARC_PI)); }
+
+private:
+    ArcTable() {
+        for (int i = 0; i < SIZE; i++) {
+            double a = 2.0 * 3.14159265358979323846 * i / SIZE;   // 用 double 计算，表项精确到 float 的最后一位
+            points[i] = ImVec2((float)cos(a), (float)sin(a));
+        }
+        points[SIZE] = points[0];
+    }
+
+    ImVec2 points[SIZE + 1];
+};
+
+// 两个等分点之间的步长：和 ImDrawList 画整圆时一样，按半径和 CircleSegmentMaxError 决定分段数
+inline int ArcTableStep(ImDrawList* drawList, float radius) {
+    int segments = drawList->_CalcCircleAutoSegmentCount(radius);
+    int step = ArcTable::SIZE / (segments > 0 ? segments : 1);
+    return step > 0 ? step : 1;
+}
+
+// 把 aMin 到 aMax 的圆弧追加到当前路径（aMax < aMin 时逆时针），相当于 PathArcTo
+inline void PathArcFromTable(ImDrawList* drawList, const ImVec2& center, float radius, float aMin, float aMax) {
+    const ArcTable& table = ArcTable::Get();
+    const int step = ArcTableStep(drawList, radius);
+    const float sMin = ArcTable::ToSample(aMin), sMax = ArcTable::ToSample(aMax);
+    const float minGap = step * 0.25f;   // 离端点太近的表项跳过，避免几乎重合的顶点
+    auto push = [&](const ImVec2& unit) {
+        drawList->_Path.push_back(ImVec2(center.x + unit.x * radius, center.y + unit.y * radius));
+    };
+
+    drawList->_Path.reserve(drawList->_Path.Size + (int)(fabsf(sMax - sMin) / step) + 2);
+    push(table.At(sMin));
+    if (sMax >= sMin) {
+        for (int k = (int)floorf(sMin / step) + 1; (float)(k * step) < sMax - minGap; k++)
+            if ((float)(k * step) > sMin + minGap) push(table.Sample(k * step));
+    } else {
+        for (int k = (int)ceilf(sMin / step) - 1; (float)(k * step) > sMax + minGap; k--)
+            if ((float)(k * step) < sMin - minGap) push(table.Sample(k * step));
+    }
+    push(table.At(sMax));
+}
+
+// 整圆：只用表项，调用方用 PathFillConvex 或 PathStroke(..., ImDrawFlags_Closed, ...) 闭合
+inline void PathCircleFromTable(ImDrawList* drawList, const ImVec2& center, float radius) {
+    const ArcTable& table = ArcTable::Get();
+    const int step = ArcTableStep(drawList, radius);
+    drawList->_Path.reserve(drawList->_Path.Size + ArcTable::SIZE / step + 1);
+    for (int k = 0; k < ArcTable::SIZE; k += step) {
+        const ImVec2& unit = table.Sample(k);
+        drawList->_Path.push_back(ImVec2(center.x + unit.x * radius, center.y + unit.y * radius));
+    }
+}
+
+// 饼图：background 整圆，fill 从 startAngle 顺时针占 fraction 的扇形
+inline void AddPie(ImDrawList* drawList, const ImVec2& center, float radius, float fraction,
+                   ImU32 background, ImU32 fill, float startAngle = -ARC_PI * 0.5f) {
+    if (fraction < 1.0f) {
+        PathCircleFromTable(drawList, center, radius);
+        drawList->PathFillConvex(background);
+    }
+    if (fraction >= 1.0f) {
+        PathCircleFromTable(drawList, center, radius);
+        drawList->PathFillConvex(fill);
+    } else if (fraction > 0.0f) {
+        drawList->PathLineTo(center);
+        PathArcFromTable(drawList, center, radius, startAngle, startAngle + fraction * 2.0f * ARC_PI);
+        drawList->PathFillConvex(fill);
+    }
+}
+
+// 圆环：radius 是外径，宽 thickness 的 track 整环上叠加从 startAngle 顺时针占 fraction 的 fill 圆弧
+inline void AddDonut(ImDrawList* drawList, const ImVec2& center, float radius, float thickness, float fraction,
+                     ImU32 track, ImU32 fill, float startAngle = -ARC_PI * 0.5f) {
+    const float r = radius - thickness * 0.5f;   // 圆环中线
+    if ((track & IM_COL32_A_MASK) != 0 && fraction < 1.0f) {
+        PathCircleFromTable(drawList, center, r);
+        drawList->PathStroke(track, ImDrawFlags_Closed, thickness);
+    }
+    if (fraction >= 1.0f) {
+        PathCircleFromTable(drawList, center, r);
+        drawList->PathStroke(fill, ImDrawFlags_Closed, thickness);
+    } else if (fraction > 0.0f) {
+        PathArcFromTable(drawList, center, r, startAngle, startAngle + fraction * 2.0f * ARC_PI);
+        drawList->PathStroke(fill, ImDrawFlags_None, thickness);
+    }
+}
+
+enum class ArcGaugeKind {
+    Pie,
+    Donut
+};
+
+struct ArcGaugeStyle {
+    ArcGaugeKind kind = ArcGaugeKind::Pie;
+    float radius = 0.0f;                  // 外径，0 表示填满控件
+    float thickness = 4.0f;               // 圆环宽度（Donut）
+    float startAngle = -ARC_PI * 0.5f;     // 起始角度，默认 12 点钟方向
+    ImU32 trackColor = IM_COL32(50, 50, 50, 255);
+    ImU32 fillColor = IM_COL32(0, 191, 255, 255);
+    ImU32 faceColor = 0;                  // 圆环内部的底色（Donut），0 表示不画
+    ImU32 textColor = IM_COL32(255, 255, 255, 255);
+};
+
+// 控件：占据 size 大小，圆心在中间，中央显示百分比。
+// 外观只取决于按显示精度（0.1%）取整后的比例，不变时直接回放上一次生成的顶点（见 draw_list_cache.hpp）
+inline void ArcGauge(const char* label, float fraction, const ImVec2& size, const ArcGaugeStyle& style = ArcGaugeStyle()) {
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    ImVec2 center(pos.x + size.x * 0.5f, pos.y + size.y * 0.5f);
+    float radius = style.radius > 0.0f ? style.radius : (size.x < size.y ? size.x : size.y) * 0.5f;
+
+    if (!(fraction >= 0.0f)) fraction = 0.0f;   // 同时处理 NaN
+    if (fraction > 1.0f) fraction = 1.0f;
+    int permille = (int)lroundf(fraction * 1000.0f);
+    fraction = permille / 1000.0f;
+
+    static std::unordered_map<ImGuiID, DrawListCache> caches;
+    DrawListCache& cache = caches[ImGui::GetID(label)];
+    // 失效键：比例、半径和样式（FNV-1a）
+    uint64_t key = 14695981039346656037ull;
+    auto mix = [&key](uint32_t v) { key = (key ^ v) * 1099511628211ull; };
+    mix((uint32_t)permille);
+    mix((uint32_t)(radius * 16.0f));
+    mix((uint32_t)style.kind);
+    mix((uint32_t)(style.thickness * 16.0f));
+    mix((uint32_t)(int32_t)(style.startAngle * 4096.0f));
+    mix(style.trackColor);
+    mix(style.fillColor);
+    mix(style.faceColor);
+    mix(style.textColor);
+    if (cache.Begin(drawList, key, center)) {
+        if (style.kind == ArcGaugeKind::Pie) {
+            AddPie(drawList, center, radius, fraction, style.trackColor, style.fillColor, style.startAngle);
+        } else {
+            if (style.faceColor != 0) {
+                PathCircleFromTable(drawList, center, radius - style.thickness);
+                drawList->PathFillConvex(style.faceColor);
+            }
+            AddDonut(drawList, center, radius, style.thickness, fraction, style.trackColor, style.fillColor, style.startAngle);
+        }
+
+        char overlay[32];
+        snprintf(overlay, sizeof(overlay), "%.1f%%", permille / 10.0f);
+        ImVec2 textSize = ImGui::CalcTextSize(overlay);
+        drawList->AddText(ImVec2(center.x - textSize.x * 0.5f, center.y - textSize.y * 0.5f), style.textColor, overlay);
+        cache.End();
+    }
+
+    ImGui::Dummy(size);
+}
@@ -0,0 +1,13 @@
+// spdlog 日志开销基准测试的独立程序，见 log_benchmark.hpp
+// 每条日志的堆分配次数由 log_bench_allocs.cpp 替换的全局 operator new 统计，
+// 主程序（source/*.cpp）不链接这两个文件，也不为计数付出任何开销。
+//
+// 用法：log_bench [--threads 1,2,4,...] [--sinks ...] [--modes sync,async] [--messages N] [--queue N] [--output -|文件路径]
+#include "log_benchmark.hpp"
+
+int main(int argc, char** argv) {
+    // 独立程序里 --bench-log 可有可无
+    LogBenchOptions options;
+    ParseLogBenchOptions(argc, argv, options);
+    return RunLogBench(options);
+}
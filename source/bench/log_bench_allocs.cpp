@@ -0,0 +1,80 @@
+// log_bench 的分配计数：替换全局 operator new/delete，每次分配调用 LogBenchAllocs::Count()
+// 替换对整个程序生效，所以只链接进独立的 log_bench 程序（见 log_bench.cpp），主程序不包含这个文件。
+// 单独放在一个只包含计数器的翻译单元里，编译器不会把这里的 malloc/free 内联到其他代码的 new/delete 表达式中
+#include "log_bench_allocs.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+    void* Allocate(std::size_t size) {
+        LogBenchAllocs::Count();
+        return std::malloc(size ? size : 1);
+    }
+
+    void* AllocateAligned(std::size_t size, std::size_t alignment) {
+        LogBenchAllocs::Count();
+        if (size == 0) size = 1;
+#ifdef _WIN32
+        return _aligned_malloc(size, alignment);
+#else
+        void* p = nullptr;
+        if (alignment < sizeof(void*)) alignment = sizeof(void*);
+        return posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+#endif
+    }
+
+    void FreeAligned(void* p) {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+// 完整的一组可替换分配函数：普通、数组、nothrow 和对齐版本都计数，释放函数和分配函数一一对应
+void* operator new(std::size_t size) {
+    if (void* p = Allocate(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = Allocate(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+#ifdef __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* p = AllocateAligned(size, (std::size_t)alignment)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* p = AllocateAligned(size, (std::size_t)alignment)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(size, (std::size_t)alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(size, (std::size_t)alignment);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+#endif
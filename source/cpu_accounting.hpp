@@ -0,0 +1,189 @@
+// 进程/线程 CPU 使用率计算
+// 每轮采样只取一个时间戳，所有进程（线程）的 user+system 时间增量都除以同一个采样间隔，
+// 再除以核心数，得到占整机 CPU 的百分比，所有进程加起来不会超过 100%。
+// 上一轮的累计时间保存在以 PID 为键的开放寻址哈希表里，本轮没有出现的 PID 在采样结束时按轮次淘汰
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// 以 PID（或 TID）为键的开放寻址哈希表，线性探测，装载率不超过 1/2
+// 每个槽位记录最近一次被访问的轮次，Evict() 一次性删除本轮没有访问过的键
+template <typename T>
+class FlatPidMap {
+public:
+    struct Slot {
+        uint32_t key = 0;
+        bool used = false;
+        uint64_t generation = 0;
+        T value = T();
+    };
+
+    FlatPidMap() : slots(16) {}
+
+    // 开始新的一轮
+    void NextGeneration() { ++generation; }
+
+    // 查找或插入 key，并标记为本轮存活
+    T& Touch(uint32_t key, bool* inserted = nullptr) {
+        if ((count + 1) * 2 > slots.size()) Rehash(slots.size() * 2);
+        Slot& slot = slots[Probe(slots, key)];
+        if (inserted) *inserted = !slot.used;
+        if (!slot.used) {
+            slot.key = key;
+            slot.used = true;
+            slot.value = T();
+            count++;
+        }
+        slot.generation = generation;
+        return slot.value;
+    }
+
+    T* Find(uint32_t key) {
+        Slot& slot = slots[Probe(slots, key)];
+        return slot.used ? &slot.value : nullptr;
+    }
+
+    // 让 key 在本轮结束时被淘汰，例如读取时发现进程已经退出
+    void Expire(uint32_t key) {
+        Slot& slot = slots[Probe(slots, key)];
+        if (slot.used) slot.generation = 0;
+    }
+
+    // 删除本轮没有访问过的键，删除前调用 onEvict(key, value)
+    template <typename F>
+    size_t Evict(F onEvict) {
+        size_t evicted = 0;
+        for (Slot& slot : slots) {
+            if (slot.used && slot.generation != generation) {
+                onEvict(slot.key, slot.value);
+                evicted++;
+            }
+        }
+        // 线性探测不能直接挖空槽位，有键被删除时把存活的键重新放一遍，容量不变
+        if (evicted > 0) {
+            count -= evicted;
+            Rehash(slots.size(), false);
+        }
+        return evicted;
+    }
+
+    size_t Evict() { return Evict([](uint32_t, T&) {}); }
+
+    size_t Size() const { return count; }
+
+private:
+    std::vector<Slot> slots;
+    std::vector<Slot> spare;   // Rehash 时交替使用，避免每次重新分配
+    size_t count = 0;
+    uint64_t generation = 1;
+
+    static size_t Hash(uint32_t key) {
+        return (size_t)(key * 2654435761u);
+    }
+
+    static size_t Probe(const std::vector<Slot>& table, uint32_t key) {
+        size_t mask = table.size() - 1;
+        size_t index = Hash(key) & mask;
+        while (table[index].used && table[index].key != key) index = (index + 1) & mask;
+        return index;
+    }
+
+    // keepStale 为 false 时丢掉本轮没有访问过的键
+    void Rehash(size_t capacity, bool keepStale = true) {
+        spare.clear();
+        spare.resize(capacity);
+        for (Slot& slot : slots) {
+            if (!slot.used || (!keepStale && slot.generation != generation)) continue;
+            spare[Probe(spare, slot.key)] = std::move(slot);
+        }
+        slots.swap(spare);
+        spare.clear();
+    }
+};
+
+// 不需要附带数据时的占位类型
+struct CpuNoPayload {};
+
+// CPU 时间统一用纳秒表示：Linux 的 clock tick、Windows 的 100ns FILETIME 都先换算成纳秒
+template <typename T = CpuNoPayload>
+class CpuAccounting {
+public:
+    struct Entry {
+        T data = T();
+        uint64_t cpuTime = 0;  // 上一轮的累计 CPU 时间，ns
+        bool primed = false;   // 是否已经有上一轮的数据
+    };
+
+    // 开始一轮采样：timestamp 为本轮唯一的时间戳（单调时钟，ns），coreCount 为在线核心数
+    void BeginSample(uint64_t timestamp, unsigned coreCount) {
+        uint64_t elapsed = lastTimestamp != 0 && timestamp > lastTimestamp ? timestamp - lastTimestamp : 0;
+        lastTimestamp = timestamp;
+        scale = elapsed > 0 ? 100.0 / ((double)elapsed * (coreCount > 0 ? coreCount : 1)) : 0.0;
+        entries.NextGeneration();
+    }
+
+    // 取得 id 对应的条目并标记为本轮存活，inserted 返回是否是新出现的 id
+    Entry& Touch(uint32_t id, bool* inserted = nullptr) { return entries.Touch(id, inserted); }
+
+    // 记录本轮的累计 CPU 时间，返回与上一轮相比的使用率（占整机的百分比）
+    double Account(Entry& entry, uint64_t cpuTime) {
+        double usage = 0.0;
+        if (entry.primed && cpuTime >= entry.cpuTime) usage = (double)(cpuTime - entry.cpuTime) * scale;
+        entry.cpuTime = cpuTime;
+        entry.primed = true;
+        return usage;
+    }
+
+    double Update(uint32_t id, uint64_t cpuTime) { return Account(Touch(id), cpuTime); }
+
+    void Expire(uint32_t id) { entries.Expire(id); }
+
+    // 结束一轮采样，淘汰本轮没有出现的 id
+    template <typename F>
+    size_t EndSample(F onEvict) {
+        return entries.Evict([&onEvict](uint32_t id, Entry& entry) { onEvict(id, entry.data); });
+    }
+
+    size_t EndSample() { return entries.Evict(); }
+
+    size_t Size() const { return entries.Size(); }
+
+private:
+    FlatPidMap<Entry> entries;
+    uint64_t lastTimestamp = 0;
+    double scale = 0.0;
+};
+
+// 按核心统计的使用率，输入为每个核心的累计总时间和空闲时间（任意单位）
+class CoreAccounting {
+public:
+    // 返回核心 index 本轮的使用率，第一次出现时为 0
+    double Update(size_t index, uint64_t total, uint64_t idle) {
+        if (index >= cores.size()) cores.resize(index + 1);
+        Core& core = cores[index];
+        double usage = core.total != 0 ? Usage(core.total, core.idle, total, idle) : 0.0;
+        core.total = total;
+        core.idle = idle;
+        return usage;
+    }
+
+    // 两次采样之间的使用率（%）。差值按有符号数计算：内核的 iowait 计数可能回退，
+    // 空闲时间变少时按 0 处理，结果限制在 [0, 100]
+    static double Usage(uint64_t lastTotal, uint64_t lastIdle, uint64_t total, uint64_t idle) {
+        int64_t totalDelta = (int64_t)(total - lastTotal);
+        int64_t idleDelta = (int64_t)(idle - lastIdle);
+        if (totalDelta <= 0) return 0.0;
+        if (idleDelta < 0) idleDelta = 0;
+        double usage = (1.0 - (double)idleDelta / (double)totalDelta) * 100.0;
+        return usage < 0.0 ? 0.0 : (usage > 100.0 ? 100.0 : usage);
+    }
+
+private:
+    struct Core {
+        uint64_t total = 0;
+        uint64_t idle = 0;
+    };
+    std::vector<Core> cores;
+};
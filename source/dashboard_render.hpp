@@ -0,0 +1,244 @@
+// 无界面渲染模式
+// 不需要 GPU 和窗口：用 CPU 软件光栅化后端（imgui_impl_softraster）渲染 ShowExampleAppMenu 仪表盘，
+// 可以按间隔把画面保存成 PNG 截图，结束时输出帧时间统计（一行 JSON），用于在 CI 中做帧时间回归测试。
+// 构建时需要一起编译 imgui.cpp、imgui_draw.cpp、imgui_tables.cpp、imgui_widgets.cpp 和 imgui_impl_softraster.cpp
+//
+// 用法：app --render [--size 宽x高] [--frames N] [--fps N] [--idle] [--threads N]
+//                   [--snapshot-dir 目录] [--snapshot-interval 秒] [--font 字体文件] [--output -|文件]
+//   --frames 0 表示一直运行直到 Ctrl+C；--fps 0 表示不限帧率，尽快渲染
+//   --idle 和 Windows 窗口的主循环一样按需渲染（见 frame_scheduler.hpp），只在有新数据时渲染几帧，忽略 --fps
+//   --snapshot-interval 0 表示只保存最后一帧
+#pragma once
+#include "imgui/imgui.h"
+#include "imgui/imgui_impl_softraster.h"
+#include "dashboard_ui.hpp"
+#include "headless_exporter.hpp"
+#include "latency_histogram.hpp"
+#include "png_writer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct DashboardRenderOptions {
+    int width = 1280;
+    int height = 800;
+    uint64_t frames = 300;          // 渲染帧数，0 表示一直运行
+    float fps = 30.0f;              // 帧率上限，0 表示不限
+    bool idle = false;              // 按需渲染
+    int threads = 0;                // 光栅化线程数，0 表示每个硬件线程一个
+    std::string snapshotDir;        // 截图目录，为空时不保存截图
+    float snapshotInterval = 5.0f;  // 截图间隔（秒），0 表示只保存最后一帧
+    std::string font;               // 字体文件，为空时依次尝试常见的中文字体
+    std::string output = "-";       // 帧时间统计的输出位置，"-" 为标准输出
+};
+
+// 命令行中有 --render 时返回 true 并解析其余选项
+inline bool ParseDashboardRenderOptions(int argc, char** argv, DashboardRenderOptions& options) {
+    bool render = false;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--render") == 0) {
+            render = true;
+        } else if (strcmp(arg, "--size") == 0 && value) {
+            int w = 0, h = 0;
+            if (sscanf(value, "%dx%d", &w, &h) == 2 && w > 0 && h > 0) {
+                options.width = w;
+                options.height = h;
+            }
+            i++;
+        } else if (strcmp(arg, "--frames") == 0 && value) {
+            options.frames = strtoull(value, nullptr, 10);
+            i++;
+        } else if (strcmp(arg, "--fps") == 0 && value) {
+            options.fps = (float)atof(value);
+            i++;
+        } else if (strcmp(arg, "--idle") == 0) {
+            options.idle = true;
+        } else if (strcmp(arg, "--threads") == 0 && value) {
+            options.threads = atoi(value);
+            i++;
+        } else if (strcmp(arg, "--snapshot-dir") == 0 && value) {
+            options.snapshotDir = value;
+            i++;
+        } else if (strcmp(arg, "--snapshot-interval") == 0 && value) {
+            options.snapshotInterval = (float)atof(value);
+            i++;
+        } else if (strcmp(arg, "--font") == 0 && value) {
+            options.font = value;
+            i++;
+        } else if (strcmp(arg, "--output") == 0 && value) {
+            options.output = value;
+            i++;
+        }
+    }
+    return render;
+}
+
+// 加载中文字体，找不到时使用默认字体（中文会显示成问号）
+inline void LoadDashboardFont(ImGuiIO& io, const std::string& path) {
+    static const char* const candidates[] = {
+#ifdef _WIN32
+        "c:\\Windows\\Fonts\\msyh.ttc",
+#else
+        "/usr/share/fonts/opentype/noto/NotoSansCJK-Regular.ttc",
+        "/usr/share/fonts/noto-cjk/NotoSansCJK-Regular.ttc",
+        "/usr/share/fonts/google-noto-cjk/NotoSansCJK-Regular.ttc",
+        "/usr/share/fonts/truetype/wqy/wqy-microhei.ttc",
+        "/usr/share/fonts/wqy-microhei/wqy-microhei.ttc",
+#endif
+    };
+    std::vector<std::string> paths;
+    if (!path.empty()) paths.push_back(path);
+    for (const char* candidate : candidates) paths.push_back(candidate);
+
+    for (const std::string& p : paths) {
+        // AddFontFromFileTTF 打不开文件时会断言，先确认文件存在
+        FILE* f = fopen(p.c_str(), "rb");
+        if (!f) continue;
+        fclose(f);
+        if (io.Fonts->AddFontFromFileTTF(p.c_str(), 18.0f, nullptr, io.Fonts->GetGlyphRangesChineseFull()))
+            return;
+    }
+    if (!path.empty()) fprintf(stderr, "无法加载字体: %s，使用默认字体\n", path.c_str());
+    io.Fonts->AddFontDefault();
+}
+
+inline bool SaveDashboardSnapshot(const std::string& dir, uint64_t index) {
+    int width = 0, height = 0;
+    const ImU32* pixels = ImGui_ImplSoftRaster_GetFramebuffer(&width, &height);
+    if (!pixels) return false;
+    char name[64];
+    snprintf(name, sizeof(name), "dashboard_%06llu.png", (unsigned long long)index);
+    std::string path = dir + "/" + name;
+    // 帧缓冲按 IM_COL32 排列，小端机器上内存中正好是 R、G、B、A 四个字节
+    if (!PngWriter::Write(path, width, height, (const unsigned char*)pixels)) {
+        fprintf(stderr, "无法写入截图: %s\n", path.c_str());
+        return false;
+    }
+    fprintf(stderr, "截图已保存: %s\n", path.c_str());
+    return true;
+}
+
+// 一类耗时的统计：均值精确，分位数来自直方图（误差约 3%），--frames 0 一直运行时内存也不增长
+struct DashboardTimeStats {
+    LatencyHistogram histogram;
+    double sumMs = 0.0;
+
+    void Record(std::chrono::steady_clock::duration d) {
+        histogram.Record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+        sumMs += std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    double Mean() const { return histogram.Count() ? sumMs / (double)histogram.Count() : 0.0; }
+    double Percentile(double percent) const { return (double)histogram.Percentile(percent) / 1e6; }
+    double Max() const { return (double)histogram.Max() / 1e6; }
+};
+
+// 无界面渲染模式的主循环，返回进程退出码
+inline int RunDashboardRender(const DashboardRenderOptions& options) {
+#ifdef _WIN32
+    SetConsoleCtrlHandler(HeadlessConsoleHandler, TRUE);
+#else
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = HeadlessSignalHandler;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+#endif
+
+    FILE* out = stdout;
+    if (options.output != "-") {
+        out = fopen(options.output.c_str(), "a");
+        if (!out) {
+            fprintf(stderr, "无法打开输出文件: %s\n", options.output.c_str());
+            return 1;
+        }
+    }
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;   // 每次都从相同的布局开始，帧时间才有可比性
+    io.DisplaySize = ImVec2((float)options.width, (float)options.height);
+    LoadDashboardFont(io, options.font);
+    SetupDashboardStyle();
+    ImGui_ImplSoftRaster_Init(options.threads);
+    ImGui_ImplSoftRaster_SetClearColor(IM_COL32(115, 140, 153, 255));
+
+    FrameScheduler scheduler;
+    if (options.idle) g_SystemSampler.SetPublishCallback([&scheduler] { scheduler.Wake(); });
+    g_SystemSampler.Start(g_Settings.refresh_rate);
+
+    using Clock = std::chrono::steady_clock;
+    std::unique_ptr<TickTimer> timer;
+    if (!options.idle && options.fps > 0.0f) timer.reset(new TickTimer(1.0 / options.fps));
+
+    DashboardTimeStats frameTime, uiTime, rasterTime;
+    uint64_t frames = 0;
+    uint64_t snapshots = 0;
+    Clock::time_point start = Clock::now();
+    Clock::time_point last = start;
+    Clock::time_point nextSnapshot = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.snapshotInterval));
+    bool ok = true;
+    while (!g_HeadlessStop && (options.frames == 0 || frames < options.frames)) {
+        if (timer && timer->Wait() == 0) continue;
+        if (options.idle) {
+            scheduler.Wait();
+            if (!scheduler.HasPendingFrames()) continue;
+        }
+
+        Clock::time_point t0 = Clock::now();
+        io.DeltaTime = std::max(std::chrono::duration<float>(t0 - last).count(), 1e-4f);
+        last = t0;
+        ImGui_ImplSoftRaster_NewFrame();
+        ImGui::NewFrame();
+        ShowExampleAppMenu();
+        if (options.idle) RequestDashboardAnimationFrames(scheduler);
+        ImGui::Render();
+        Clock::time_point t1 = Clock::now();
+        ImGui_ImplSoftRaster_RenderDrawData(ImGui::GetDrawData());
+        Clock::time_point t2 = Clock::now();
+
+        uiTime.Record(t1 - t0);
+        rasterTime.Record(t2 - t1);
+        frameTime.Record(t2 - t0);
+        frames++;
+        scheduler.FrameRendered();
+
+        if (!options.snapshotDir.empty() && options.snapshotInterval > 0.0f && t2 >= nextSnapshot) {
+            ok = SaveDashboardSnapshot(options.snapshotDir, snapshots++) && ok;
+            while (nextSnapshot <= t2)
+                nextSnapshot += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.snapshotInterval));
+        }
+    }
+    if (!options.snapshotDir.empty() && options.snapshotInterval <= 0.0f && frames > 0)
+        ok = SaveDashboardSnapshot(options.snapshotDir, snapshots++) && ok;
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    int threads = ImGui_ImplSoftRaster_GetThreadCount();
+    g_SystemSampler.Stop();
+    g_SystemSampler.SetPublishCallback(nullptr);
+    ImGui_ImplSoftRaster_Shutdown();
+    ImGui::DestroyContext();
+
+    // 帧时间统计：frame = ui（界面逻辑）+ raster（光栅化），threads 是光栅化实际使用的线程数
+    fprintf(out,
+            "{\"frames\":%llu,\"seconds\":%.3f,\"width\":%d,\"height\":%d,\"threads\":%d,\"snapshots\":%llu,"
+            "\"frame_ms\":{\"mean\":%.3f,\"p50\":%.3f,\"p95\":%.3f,\"p99\":%.3f,\"max\":%.3f},"
+            "\"ui_ms\":{\"mean\":%.3f},"
+            "\"raster_ms\":{\"mean\":%.3f,\"p50\":%.3f,\"p99\":%.3f}}\n",
+            (unsigned long long)frames, seconds, options.width, options.height, threads, (unsigned long long)snapshots,
+            frameTime.Mean(), frameTime.Percentile(50), frameTime.Percentile(95), frameTime.Percentile(99), frameTime.Max(),
+            uiTime.Mean(),
+            rasterTime.Mean(), rasterTime.Percentile(50), rasterTime.Percentile(99));
+    fflush(out);
+    if (out != stdout) fclose(out);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,851 @@
+// 仪表盘界面（ShowExampleAppMenu）
+// 只依赖 Dear ImGui，不依赖任何平台或渲染后端：
+// Windows 下由 test_imgui.hpp 的 D3D11 窗口显示，Linux 无界面服务器上由 dashboard_render.hpp 用 CPU 软件光栅化渲染
+#pragma once
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#include "imgui/imgui.h"
+#include <float.h>
+#include <vector>
+#include <string>
+#include "system_monitor.hpp"
+#include "system_sampler.hpp"
+#include "process_table.hpp"
+#include "snapshot_recording.hpp"
+#include "arc_gauge.hpp"
+#include "frame_scheduler.hpp"
+
+
+// 在文件开头添加枚举类型
+enum class MenuPage {
+    Dashboard,
+    DataVisualization,
+    SystemMonitor,
+    Settings
+};
+
+// 添加全局变量
+static MenuPage current_page = MenuPage::Dashboard;
+
+// 在文件开头添加新的全局变量
+static const ImVec4 THEME_COLOR_MAIN = ImVec4(0.28f, 0.56f, 1.00f, 1.00f);
+static const ImVec4 THEME_COLOR_DARK = ImVec4(0.13f, 0.14f, 0.17f, 1.00f);
+static const ImVec4 THEME_COLOR_LIGHT = ImVec4(0.20f, 0.22f, 0.27f, 1.00f);
+static const ImVec4 THEME_COLOR_ACCENT = ImVec4(0.28f, 0.56f, 1.00f, 0.50f);
+
+// 仪表盘的基础样式和配色，各个渲染后端共用
+inline void SetupDashboardStyle()
+{
+    ImGui::StyleColorsDark();
+    auto& style = ImGui::GetStyle();
+    
+    // 基础样式设置
+    style.FrameRounding = 6.0f;
+    style.WindowRounding = 8.0f;
+    style.PopupRounding = 6.0f;
+    style.ScrollbarRounding = 6.0f;
+    style.GrabRounding = 6.0f;
+    style.TabRounding = 6.0f;
+    style.WindowBorderSize = 0.0f;
+    style.FrameBorderSize = 0.0f;
+    style.WindowPadding = ImVec2(15, 15);
+    style.ItemSpacing = ImVec2(8, 8);
+    style.ScrollbarSize = 12.0f;
+
+    // 颜色设置
+    auto& colors = style.Colors;
+    colors[ImGuiCol_WindowBg] = THEME_COLOR_DARK;
+    colors[ImGuiCol_FrameBg] = THEME_COLOR_LIGHT;
+    colors[ImGuiCol_FrameBgHovered] = ImVec4(0.25f, 0.27f, 0.32f, 1.00f);
+    colors[ImGuiCol_FrameBgActive] = ImVec4(0.28f, 0.30f, 0.35f, 1.00f);
+    colors[ImGuiCol_TitleBgActive] = THEME_COLOR_DARK;
+    colors[ImGuiCol_CheckMark] = THEME_COLOR_MAIN;
+    colors[ImGuiCol_SliderGrab] = THEME_COLOR_MAIN;
+    colors[ImGuiCol_SliderGrabActive] = THEME_COLOR_ACCENT;
+    colors[ImGuiCol_ScrollbarBg] = THEME_COLOR_DARK;
+    colors[ImGuiCol_ScrollbarGrab] = THEME_COLOR_LIGHT;
+    colors[ImGuiCol_ScrollbarGrabHovered] = THEME_COLOR_MAIN;
+    colors[ImGuiCol_ScrollbarGrabActive] = THEME_COLOR_ACCENT;
+}
+
+// 在文件开头添加
+static const char* const MENU_ICONS[] = { "📊", "📈", "🔍", "⚙" };
+static const char* const MENU_ITEMS[] = { "仪表盘", "数据可视化", "系统监控", "设置" };
+
+// 添加全局变量
+static SystemMonitor g_SystemMonitor;
+static SystemMonitor::SystemInfo g_SystemInfo;
+static ProcessTable g_ProcessTable;
+static uint32_t g_SelectedPid = SystemSnapshot::NO_PROCESS;  // 查看线程列表的进程
+
+// 进程表格中格式化好的单元格文本，按 ProcessTable 的行号缓存，行内容变化（version 改变）时才重新格式化
+struct ProcessRowText {
+    uint32_t version = 0;  // 0 表示还没有格式化过
+    char pid[16];
+    char cpu[16];
+    char memory[32];
+};
+static std::vector<ProcessRowText> g_ProcessRowTexts;
+
+static const ProcessRowText& FormatProcessRow(uint32_t index, const ProcessRow& process) {
+    ProcessRowText& text = g_ProcessRowTexts[index];
+    if (text.version != process.version) {
+        text.version = process.version;
+        snprintf(text.pid, sizeof(text.pid), "%u", process.pid);
+        snprintf(text.cpu, sizeof(text.cpu), "%.1f", process.cpuUsage);
+        snprintf(text.memory, sizeof(text.memory), "%zu MB", process.memoryUsage);
+    }
+    return text;
+}
+
+// 网络表格的单元格文本，每次采样重新生成一次
+struct NetworkRowText {
+    std::string upload;
+    std::string download;
+    std::string total;
+};
+static std::vector<NetworkRowText> g_NetworkRowTexts;
+static uint64_t g_NetworkRowTextsSequence = 0;
+// 后台采样线程，渲染线程只读取它发布的快照
+static SystemSampler g_SystemSampler(g_SystemMonitor);
+static const SystemSnapshot* g_Snapshot = nullptr;
+
+// 曲线读到的历史数据被采样线程覆盖过，需要马上用新的视图再画一帧
+static bool g_HistoryViewTorn = false;
+
+// 滚动曲线：直接绘制 SystemMonitor 中的历史数据，不复制
+// 根据显示的时间范围和控件宽度自动选择降采样级别，点数不超过控件的像素宽度
+struct ScrollingBuffer {
+    const TieredSeries& Series;
+    double RangeSeconds;        // 显示最近多长时间的数据
+    SeriesAggregate Aggregate;
+
+    ScrollingBuffer(const TieredSeries& series, double range_seconds = 100.0, SeriesAggregate aggregate = SeriesAggregate::Avg)
+        : Series(series), RangeSeconds(range_seconds), Aggregate(aggregate) {}
+
+    void Draw(const char* label, float scale_min, float scale_max, float height = 150.0f) {
+        float width = ImGui::GetContentRegionAvail().x;
+        size_t max_points = (size_t)(width > 2.0f ? width : 2.0f);
+        TieredSeries::Selection selection = Series.Select(RangeSeconds, max_points, Aggregate);
+        // PlotLines 在取到视图之后立即读完，采样线程每个周期只写一个样本，正常不会落后 RingSeries::GUARD 个样本；
+        // 渲染线程被挂起太久时读到的点可能被撕裂，这一帧作废，下一帧重新取视图
+        ImGui::PlotLines(label, &TieredSeries::Selection::Getter,
+            &selection, (int)selection.view.size(), 0, nullptr, scale_min, scale_max, ImVec2(-1, height));
+        if (!selection.view.Valid()) g_HistoryViewTorn = true;
+    }
+};
+
+// 历史曲线可选的时间范围
+static const char* const HISTORY_RANGE_NAMES[] = { "1分钟", "10分钟", "1小时", "1天", "1周" };
+static const double HISTORY_RANGE_SECONDS[] = { 60.0, 600.0, 3600.0, 86400.0, 604800.0 };
+
+// 在ShowExampleAppMenu函数中更新系统信息
+// 只从采样线程取最新快照，不在渲染线程上做任何系统调用
+void UpdateSystemInfo() {
+    bool updated = false;
+    g_Snapshot = &g_SystemSampler.Acquire(&updated);
+    if (updated) {
+        g_SystemInfo = g_Snapshot->system;
+        g_ProcessTable.Update(g_Snapshot->processes);
+    }
+}
+
+// 在文件中添加主题函数
+void ApplyBlueTheme()
+{
+    ImGui::StyleColorsDark();
+    ImVec4* colors = ImGui::GetStyle().Colors;
+    colors[ImGuiCol_Text]                   = ImVec4(1.00f, 1.00f, 1.00f, 1.00f);
+    colors[ImGuiCol_TextDisabled]           = ImVec4(0.50f, 0.50f, 0.50f, 1.00f);
+    colors[ImGuiCol_WindowBg]               = ImVec4(0.06f, 0.06f, 0.15f, 0.94f);
+    colors[ImGuiCol_ChildBg]                = ImVec4(0.08f, 0.08f, 0.20f, 0.94f);
+    colors[ImGuiCol_PopupBg]                = ImVec4(0.08f, 0.08f, 0.20f, 0.94f);
+    colors[ImGuiCol_Border]                 = ImVec4(0.43f, 0.43f, 0.50f, 0.50f);
+    colors[ImGuiCol_BorderShadow]           = ImVec4(0.00f, 0.00f, 0.00f, 0.00f);
+    colors[ImGuiCol_FrameBg]                = ImVec4(0.12f, 0.12f, 0.30f, 0.54f);
+    colors[ImGuiCol_FrameBgHovered]         = ImVec4(0.15f, 0.15f, 0.40f, 0.40f);
+    colors[ImGuiCol_FrameBgActive]          = ImVec4(0.18f, 0.18f, 0.50f, 0.67f);
+    colors[ImGuiCol_TitleBg]                = ImVec4(0.04f, 0.04f, 0.12f, 1.00f);
+    colors[ImGuiCol_TitleBgActive]          = ImVec4(0.08f, 0.08f, 0.20f, 1.00f);
+    colors[ImGuiCol_TitleBgCollapsed]       = ImVec4(0.00f, 0.00f, 0.00f, 0.51f);
+    colors[ImGuiCol_MenuBarBg]              = ImVec4(0.14f, 0.14f, 0.35f, 1.00f);
+    colors[ImGuiCol_ScrollbarBg]            = ImVec4(0.02f, 0.02f, 0.02f, 0.53f);
+    colors[ImGuiCol_ScrollbarGrab]          = ImVec4(0.31f, 0.31f, 0.78f, 1.00f);
+    colors[ImGuiCol_ScrollbarGrabHovered]   = ImVec4(0.41f, 0.41f, 0.88f, 1.00f);
+    colors[ImGuiCol_ScrollbarGrabActive]    = ImVec4(0.51f, 0.51f, 0.98f, 1.00f);
+    colors[ImGuiCol_CheckMark]              = ImVec4(0.26f, 0.59f, 0.98f, 1.00f);
+    colors[ImGuiCol_SliderGrab]             = ImVec4(0.24f, 0.52f, 0.88f, 1.00f);
+    colors[ImGuiCol_SliderGrabActive]       = ImVec4(0.26f, 0.59f, 0.98f, 1.00f);
+    colors[ImGuiCol_Button]                 = ImVec4(0.26f, 0.59f, 0.98f, 0.40f);
+    colors[ImGuiCol_ButtonHovered]          = ImVec4(0.26f, 0.59f, 0.98f, 1.00f);
+    colors[ImGuiCol_ButtonActive]           = ImVec4(0.06f, 0.53f, 0.98f, 1.00f);
+}
+
+void ApplyGreenTheme()
+{
+    ImGui::StyleColorsDark();
+    ImVec4* colors = ImGui::GetStyle().Colors;
+    colors[ImGuiCol_Text]                   = ImVec4(1.00f, 1.00f, 1.00f, 1.00f);
+    colors[ImGuiCol_TextDisabled]           = ImVec4(0.50f, 0.50f, 0.50f, 1.00f);
+    colors[ImGuiCol_WindowBg]               = ImVec4(0.06f, 0.15f, 0.06f, 0.94f);
+    colors[ImGuiCol_ChildBg]                = ImVec4(0.08f, 0.20f, 0.08f, 0.94f);
+    colors[ImGuiCol_PopupBg]                = ImVec4(0.08f, 0.20f, 0.08f, 0.94f);
+    colors[ImGuiCol_Border]                 = ImVec4(0.43f, 0.50f, 0.43f, 0.50f);
+    colors[ImGuiCol_BorderShadow]           = ImVec4(0.00f, 0.00f, 0.00f, 0.00f);
+    colors[ImGuiCol_FrameBg]                = ImVec4(0.12f, 0.30f, 0.12f, 0.54f);
+    colors[ImGuiCol_FrameBgHovered]         = ImVec4(0.15f, 0.40f, 0.15f, 0.40f);
+    colors[ImGuiCol_FrameBgActive]          = ImVec4(0.18f, 0.50f, 0.18f, 0.67f);
+    colors[ImGuiCol_TitleBg]                = ImVec4(0.04f, 0.12f, 0.04f, 1.00f);
+    colors[ImGuiCol_TitleBgActive]          = ImVec4(0.08f, 0.20f, 0.08f, 1.00f);
+    colors[ImGuiCol_TitleBgCollapsed]       = ImVec4(0.00f, 0.00f, 0.00f, 0.51f);
+    colors[ImGuiCol_MenuBarBg]              = ImVec4(0.14f, 0.35f, 0.14f, 1.00f);
+    colors[ImGuiCol_ScrollbarBg]            = ImVec4(0.02f, 0.02f, 0.02f, 0.53f);
+    colors[ImGuiCol_ScrollbarGrab]          = ImVec4(0.31f, 0.78f, 0.31f, 1.00f);
+    colors[ImGuiCol_ScrollbarGrabHovered]   = ImVec4(0.41f, 0.88f, 0.41f, 1.00f);
+    colors[ImGuiCol_ScrollbarGrabActive]    = ImVec4(0.51f, 0.98f, 0.51f, 1.00f);
+    colors[ImGuiCol_CheckMark]              = ImVec4(0.26f, 0.98f, 0.26f, 1.00f);
+    colors[ImGuiCol_SliderGrab]             = ImVec4(0.24f, 0.88f, 0.24f, 1.00f);
+    colors[ImGuiCol_SliderGrabActive]       = ImVec4(0.26f, 0.98f, 0.26f, 1.00f);
+    colors[ImGuiCol_Button]                 = ImVec4(0.26f, 0.98f, 0.26f, 0.40f);
+    colors[ImGuiCol_ButtonHovered]          = ImVec4(0.26f, 0.98f, 0.26f, 1.00f);
+    colors[ImGuiCol_ButtonActive]           = ImVec4(0.06f, 0.98f, 0.06f, 1.00f);
+}
+
+// 在文件中添加设置保存函数
+void SaveSettings(bool notifications, bool dark_mode, float refresh_rate, 
+                 int process_limit, bool show_system_processes, 
+                 const char* log_path, int theme)
+{
+    // 这里可以实现设置的保存逻辑，比如写入配置文件
+    // 暂时只打印设置信息
+    printf("Settings saved:\n");
+    printf("Notifications: %d\n", notifications);
+    printf("Dark Mode: %d\n", dark_mode);
+    printf("Refresh Rate: %.1f\n", refresh_rate);
+    printf("Process Limit: %d\n", process_limit);
+    printf("Show System Processes: %d\n", show_system_processes);
+    printf("Log Path: %s\n", log_path);
+    printf("Theme: %d\n", theme);
+}
+
+// 磁盘占用饼图，见 arc_gauge.hpp
+void DrawPieChart(const char* label, float used, float total, const ImVec2& size) {
+    ArcGaugeStyle style;
+    style.kind = ArcGaugeKind::Pie;
+    style.trackColor = IM_COL32(50, 50, 50, 255);
+    style.fillColor = IM_COL32(0, 191, 255, 255);
+    ArcGauge(label, total > 0.0f ? used / total : 0.0f, size, style);
+}
+
+struct AppSettings {
+    bool notifications = true;
+    bool dark_mode = true;
+    float refresh_rate = 1.0f;
+    int process_limit = 50;
+    bool show_system_processes = true;
+    std::string log_path = "system_monitor.log";
+    int theme = 0;
+    
+    void Save(const char* filename = "settings.ini") {
+        FILE* f = fopen(filename, "w");
+        if (f) {
+            fprintf(f, "notifications=%d\n", notifications);
+            fprintf(f, "dark_mode=%d\n", dark_mode);
+            fprintf(f, "refresh_rate=%.1f\n", refresh_rate);
+            fprintf(f, "process_limit=%d\n", process_limit);
+            fprintf(f, "show_system_processes=%d\n", show_system_processes);
+            fprintf(f, "log_path=%s\n", log_path.c_str());
+            fprintf(f, "theme=%d\n", theme);
+            fclose(f);
+        }
+    }
+    
+    void Load(const char* filename = "settings.ini") {
+        FILE* f = fopen(filename, "r");
+        if (f) {
+            char buffer[256];
+            while (fgets(buffer, sizeof(buffer), f)) {
+                char key[64], value[192];
+                if (sscanf(buffer, "%[^=]=%[^\n]", key, value) == 2) {
+                    if (strcmp(key, "notifications") == 0) notifications = atoi(value);
+                    else if (strcmp(key, "dark_mode") == 0) dark_mode = atoi(value);
+                    else if (strcmp(key, "refresh_rate") == 0) refresh_rate = atof(value);
+                    else if (strcmp(key, "process_limit") == 0) process_limit = atoi(value);
+                    else if (strcmp(key, "show_system_processes") == 0) show_system_processes = atoi(value);
+                    else if (strcmp(key, "log_path") == 0) log_path = value;
+                    else if (strcmp(key, "theme") == 0) theme = atoi(value);
+                }
+            }
+            fclose(f);
+        }
+    }
+};
+
+static AppSettings g_Settings;
+
+// 回放录制文件时指向 g_SystemMonitor 当前使用的采集器，实时数据时为空
+static ReplayCollector* g_ReplayCollector = nullptr;
+
+// 切换数据来源前要先停下采样线程
+bool StartReplay(const char* path) {
+    std::unique_ptr<ReplayCollector> replay(new ReplayCollector());
+    if (!replay->Open(path))
+        return false;
+    g_SystemSampler.Stop();
+    g_ReplayCollector = replay.get();
+    g_SystemMonitor.SetCollector(std::move(replay));
+    g_SystemSampler.Start(g_Settings.refresh_rate);
+    return true;
+}
+
+void StopReplay() {
+    g_SystemSampler.Stop();
+    g_ReplayCollector = nullptr;
+    g_SystemMonitor.SetCollector(CreateDefaultCollector());
+    g_SystemSampler.Start(g_Settings.refresh_rate);
+}
+
+// 替换 ShowExampleAppMenu 函数
+void ShowExampleAppMenu()
+{
+    // 保存当前样式状态
+    const auto style_backup = ImGui::GetStyle();
+    
+    // 设置全局样式
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(15, 15));
+    ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(8, 10));
+    
+    // 设置颜色
+    const int color_count = 4;
+    ImGui::PushStyleColor(ImGuiCol_WindowBg, THEME_COLOR_DARK);
+    ImGui::PushStyleColor(ImGuiCol_Button, THEME_COLOR_LIGHT);
+    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, THEME_COLOR_MAIN);
+    ImGui::PushStyleColor(ImGuiCol_ButtonActive, THEME_COLOR_ACCENT);
+
+    try {
+        // 左侧菜单面板
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(ImVec2(250, ImGui::GetIO().DisplaySize.y));
+        
+        if (ImGui::Begin("##MainMenu", nullptr, 
+            ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | 
+            ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoBringToFrontOnFocus))
+        {
+            // Logo和标题区域
+            {
+                ImGui::PushFont(ImGui::GetIO().Fonts->Fonts[0]);
+                ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 10);
+                ImGui::PushStyleColor(ImGuiCol_Text, THEME_COLOR_MAIN);
+                ImGui::Text("系统监控面板");
+                ImGui::PopStyleColor();
+                ImGui::PopFont();
+                
+                ImGui::Text("v1.0.0");
+                ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 20);
+                ImGui::Separator();
+                ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 20);
+            }
+
+            // 菜单项样式
+            ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(10, 12));
+            ImGui::PushStyleColor(ImGuiCol_Header, THEME_COLOR_LIGHT);
+            ImGui::PushStyleColor(ImGuiCol_HeaderHovered, THEME_COLOR_MAIN);
+            ImGui::PushStyleColor(ImGuiCol_HeaderActive, THEME_COLOR_ACCENT);
+
+            // 菜单项
+            for (int i = 0; i < 4; i++) {
+                ImGui::PushID(i);
+                bool selected = current_page == static_cast<MenuPage>(i);
+                
+                if (selected) {
+                    ImGui::PushStyleColor(ImGuiCol_Text, THEME_COLOR_MAIN);
+                }
+                
+                if (ImGui::Selectable(MENU_ITEMS[i], selected, 0, ImVec2(0, 45))) {
+                    current_page = static_cast<MenuPage>(i);
+                }
+                
+                // 在选项左侧绘制图标
+                if (selected) {
+                    ImGui::SameLine(5);
+                    ImGui::Text(MENU_ICONS[i]);
+                    ImGui::PopStyleColor();
+                    
+                    // 绘制选中指示器
+                    auto pos = ImGui::GetItemRectMin();
+                    auto size = ImGui::GetItemRectSize();
+                    ImGui::GetWindowDrawList()->AddRectFilled(
+                        ImVec2(pos.x - 5, pos.y), 
+                        ImVec2(pos.x - 2, pos.y + size.y),
+                        ImGui::ColorConvertFloat4ToU32(THEME_COLOR_MAIN)
+                    );
+                }
+                
+                ImGui::PopID();
+            }
+
+            // 底部信息
+            ImGui::SetCursorPos(ImVec2(15, ImGui::GetIO().DisplaySize.y - 70));
+            ImGui::Text("系统状态: 正常运行");
+            ImGui::Text("更新时间: %s", "2024-01-01");
+
+            ImGui::PopStyleVar(); // FramePadding
+            ImGui::PopStyleColor(3); // Header colors
+        }
+        ImGui::End();
+
+        // 主内容区域
+        ImGui::SetNextWindowPos(ImVec2(250, 0));
+        ImGui::SetNextWindowSize(ImVec2(ImGui::GetIO().DisplaySize.x - 250, ImGui::GetIO().DisplaySize.y));
+        
+        if (ImGui::Begin("##MainContent", nullptr, 
+            ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | 
+            ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoBringToFrontOnFocus))
+        {
+            // 内容区域的标题栏
+            ImGui::PushFont(ImGui::GetIO().Fonts->Fonts[0]);
+            ImGui::Text("%s %s", MENU_ICONS[static_cast<int>(current_page)], 
+                MENU_ITEMS[static_cast<int>(current_page)]);
+            ImGui::PopFont();
+            ImGui::Separator();
+            ImGui::Spacing();
+
+            // 根据当前选择的页面显示不同内容
+            switch (current_page)
+            {
+                case MenuPage::Dashboard:
+                {
+                    UpdateSystemInfo();
+                    
+                    ImGui::Text("系统概览");
+                    ImGui::Separator();
+                    ImGui::Spacing();
+
+                    // CPU和内存使用率
+                    {
+                        ImGui::BeginChild("Performance", ImVec2(0, 150), true);
+                        float memUsage = g_SystemInfo.memoryUsage / 100.0f;
+                        
+                        // CPU使用率圆形进度条
+                        ArcGaugeStyle cpuGaugeStyle;
+                        cpuGaugeStyle.kind = ArcGaugeKind::Donut;
+                        cpuGaugeStyle.radius = 52.0f;
+                        cpuGaugeStyle.thickness = 4.0f;
+                        cpuGaugeStyle.startAngle = 0.0f;
+                        cpuGaugeStyle.trackColor = IM_COL32(100, 100, 100, 255);
+                        cpuGaugeStyle.faceColor = IM_COL32(30, 30, 30, 255);
+                        ArcGauge("##CpuGauge", g_SystemInfo.cpuUsage / 100.0f, ImVec2(120, 120), cpuGaugeStyle);
+                        
+                        // 内存使用率条
+                        ImGui::SameLine(150);
+                        ImGui::BeginGroup();
+                        ImGui::Text("内存使用");
+                        ImGui::ProgressBar(memUsage, ImVec2(200, 20));
+                        ImGui::Text("%.1f%%", g_SystemInfo.memoryUsage);
+                        ImGui::EndGroup();
+
+                        // 各核心使用率
+                        if (!g_SystemInfo.coreUsage.empty()) {
+                            static std::vector<float> coreValues;
+                            coreValues.assign(g_SystemInfo.coreUsage.begin(), g_SystemInfo.coreUsage.end());
+                            ImGui::SameLine(400);
+                            ImGui::BeginGroup();
+                            ImGui::Text("各核心使用率 (%d 核)", (int)coreValues.size());
+                            ImGui::PlotHistogram("##Cores", coreValues.data(), (int)coreValues.size(),
+                                0, nullptr, 0.0f, 100.0f, ImVec2(ImGui::GetContentRegionAvail().x, 100));
+                            ImGui::EndGroup();
+                        }
+                        
+                        ImGui::EndChild();
+                    }
+
+                    // 系统信息卡片
+                    ImGui::Columns(3, "SystemInfo", false);
+                    
+                    // 运行时间卡片
+                    ImGui::BeginChild("Uptime", ImVec2(0, 100), true);
+                    ImGui::Text("系统运行时间");
+                    float hours = g_SystemInfo.systemUptime;
+                    int days = (int)(hours / 24);
+                    hours = fmod(hours, 24);
+                    ImGui::Text("%d 天 %.1f 小时", days, hours);
+                    ImGui::EndChild();
+                    ImGui::NextColumn();
+
+                    // CPU温度卡片
+                    ImGui::BeginChild("Temperature", ImVec2(0, 100), true);
+                    ImGui::Text("CPU温度");
+                    ImGui::Text("%.1f °C", g_SystemInfo.cpuTemperature);
+                    if (g_SystemInfo.cpuTemperature > 80)
+                        ImGui::TextColored(ImVec4(1, 0, 0, 1), "警告：温度过高！");
+                    ImGui::EndChild();
+                    ImGui::NextColumn();
+
+                    // 磁盘使用卡片
+                    ImGui::BeginChild("DiskUsage", ImVec2(0, 100), true);
+                    ImGui::Text("磁盘使用率");
+                    ImGui::Text("%.1f%%", g_SystemInfo.diskUsage);
+                    ImGui::ProgressBar(g_SystemInfo.diskUsage / 100.0f);
+                    ImGui::EndChild();
+                    
+                    ImGui::Columns(1);
+                    break;
+                }
+                case MenuPage::DataVisualization:
+                {
+                    UpdateSystemInfo();
+                    static ScrollingBuffer cpuData(g_SystemMonitor.GetCpuHistory());
+                    static ScrollingBuffer memData(g_SystemMonitor.GetMemoryHistory());
+                    static ScrollingBuffer netDownData(g_SystemMonitor.GetNetworkDownloadHistory());
+                    static ScrollingBuffer netUpData(g_SystemMonitor.GetNetworkUploadHistory());
+                    static ScrollingBuffer diskReadData(g_SystemMonitor.GetDiskReadHistory());
+                    static ScrollingBuffer diskWriteData(g_SystemMonitor.GetDiskWriteHistory());
+                    static int range_index = 0;
+
+                    // 时间范围
+                    if (ImGui::Combo("时间范围", &range_index, HISTORY_RANGE_NAMES, IM_ARRAYSIZE(HISTORY_RANGE_NAMES))) {
+                        for (ScrollingBuffer* data : { &cpuData, &memData, &netDownData, &netUpData, &diskReadData, &diskWriteData })
+                            data->RangeSeconds = HISTORY_RANGE_SECONDS[range_index];
+                    }
+
+                    // CPU和内存使用率历史图表
+                    ImGui::BeginChild("性能历史", ImVec2(0, 400), true);
+                    
+                    ImGui::Text("CPU使用率历史");
+                    cpuData.Draw("##CPU", 0.0f, 100.0f);
+                    
+                    ImGui::Spacing();
+                    ImGui::Text("内存使用率历史");
+                    memData.Draw("##Memory", 0.0f, 100.0f);
+                    
+                    ImGui::EndChild();
+
+                    // 网络和磁盘速度历史图表，纵轴自动缩放
+                    ImGui::BeginChild("IO历史", ImVec2(0, 420), true);
+
+                    ImGui::Text("网络下载速度 (B/s)");
+                    netDownData.Draw("##NetDown", FLT_MAX, FLT_MAX, 80.0f);
+                    ImGui::Text("网络上传速度 (B/s)");
+                    netUpData.Draw("##NetUp", FLT_MAX, FLT_MAX, 80.0f);
+                    ImGui::Text("磁盘读取速度 (MB/s)");
+                    diskReadData.Draw("##DiskRead", FLT_MAX, FLT_MAX, 80.0f);
+                    ImGui::Text("磁盘写入速度 (MB/s)");
+                    diskWriteData.Draw("##DiskWrite", FLT_MAX, FLT_MAX, 80.0f);
+
+                    ImGui::EndChild();
+
+                    // 磁盘使用情况
+                    ImGui::Text("磁盘使用情况");
+                    const auto& diskInfos = g_Snapshot->disks;
+                    
+                    ImGui::Columns(3, "DiskInfo", false);
+                    for (const auto& disk : diskInfos) {
+                        ImGui::BeginGroup();
+                        ImGui::Text("%s", disk.driveLetter.c_str());
+                        DrawPieChart(disk.driveLetter.c_str(), 
+                                    disk.usedSpace,
+                                    disk.totalSpace,
+                                    ImVec2(150, 150));
+                        
+                        ImGui::Text("总容量: %.1f GB", disk.totalSpace);
+                        ImGui::Text("已用: %.1f GB", disk.usedSpace);
+                        ImGui::Text("可用: %.1f GB", disk.freeSpace);
+                        ImGui::Text("读取速度: %.1f MB/s", disk.readSpeed);
+                        ImGui::Text("写入速度: %.1f MB/s", disk.writeSpeed);
+                        ImGui::EndGroup();
+                        
+                        ImGui::NextColumn();
+                    }
+                    ImGui::Columns(1);
+                    break;
+                }
+                case MenuPage::SystemMonitor:
+                {
+                    UpdateSystemInfo();
+                    
+                    // 进程列表
+                    static ImGuiTableFlags flags = 
+                        ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | 
+                        ImGuiTableFlags_Hideable | ImGuiTableFlags_Sortable | 
+                        ImGuiTableFlags_SortMulti | ImGuiTableFlags_RowBg | 
+                        ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV |
+                        ImGuiTableFlags_ScrollY;
+                        
+                    // 选中进程时在表格下方留出线程列表的位置
+                    const float thread_panel_height = 200.0f;
+                    bool show_threads = g_SelectedPid != SystemSnapshot::NO_PROCESS;
+                    ImVec2 table_size(0.0f, show_threads ? -thread_panel_height : 0.0f);
+
+                    if (ImGui::BeginTable("进程列表", 5, flags, table_size)) {
+                        ImGui::TableSetupScrollFreeze(0, 1); // 顶部行固定
+                        ImGui::TableSetupColumn("进程名", ImGuiTableColumnFlags_DefaultSort);
+                        ImGui::TableSetupColumn("PID");
+                        ImGui::TableSetupColumn("CPU使用率 %");
+                        ImGui::TableSetupColumn("内存使用");
+                        ImGui::TableSetupColumn("状态");
+                        ImGui::TableHeadersRow();
+
+                        // 进程列表排序：只在排序规则变化时整体排序，数据刷新时由 ProcessTable 增量修复
+                        if (ImGuiTableSortSpecs* sorts_specs = ImGui::TableGetSortSpecs()) {
+                            if (sorts_specs->SpecsDirty) {
+                                std::vector<ProcessSortKey> keys;
+                                for (int n = 0; n < sorts_specs->SpecsCount; n++) {
+                                    const ImGuiTableColumnSortSpecs* sort_spec = &sorts_specs->Specs[n];
+                                    ProcessSortKey key;
+                                    key.column = sort_spec->ColumnIndex;
+                                    key.ascending = sort_spec->SortDirection == ImGuiSortDirection_Ascending;
+                                    keys.push_back(key);
+                                }
+                                g_ProcessTable.SetSortKeys(keys);
+                                sorts_specs->SpecsDirty = false;
+                            }
+                        }
+
+                        // 显示进程信息：按排序结果取前 process_limit 行，只提交可见的行
+                        int row_count = (int)g_ProcessTable.Size();
+                        if (g_Settings.process_limit > 0 && row_count > g_Settings.process_limit)
+                            row_count = g_Settings.process_limit;
+                        if (g_ProcessRowTexts.size() < g_ProcessTable.RowCapacity())
+                            g_ProcessRowTexts.resize(g_ProcessTable.RowCapacity());
+
+                        ImGuiListClipper clipper;
+                        clipper.Begin(row_count);
+                        while (clipper.Step()) {
+                            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                                const ProcessRow& process = g_ProcessTable.SortedRow(row);
+                                const ProcessRowText& text = FormatProcessRow(g_ProcessTable.SortedRowIndex(row), process);
+                                ImGui::TableNextRow();
+                                ImGui::TableNextColumn();
+                                ImGui::PushID((int)process.pid);
+                                bool selected = process.pid == g_SelectedPid;
+                                if (ImGui::Selectable(g_ProcessTable.Name(process).c_str(), selected, ImGuiSelectableFlags_SpanAllColumns)) {
+                                    g_SelectedPid = selected ? SystemSnapshot::NO_PROCESS : process.pid;
+                                    g_SystemSampler.SetThreadFocus(g_SelectedPid);
+                                }
+                                ImGui::PopID();
+                                ImGui::TableNextColumn();
+                                ImGui::TextUnformatted(text.pid);
+                                ImGui::TableNextColumn();
+                                ImGui::TextUnformatted(text.cpu);
+                                ImGui::TableNextColumn();
+                                ImGui::TextUnformatted(text.memory);
+                                ImGui::TableNextColumn();
+                                ImGui::TextUnformatted(g_ProcessTable.Status(process).c_str());
+                            }
+                        }
+                        ImGui::EndTable();
+                    }
+
+                    // 选中进程的线程列表，由采样线程在下一次采样时开始采集
+                    if (show_threads) {
+                        ImGui::Text("线程 (PID %u)", g_SelectedPid);
+                        ImGuiTableFlags thread_flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter |
+                            ImGuiTableFlags_BordersV | ImGuiTableFlags_ScrollY;
+                        if (ImGui::BeginTable("线程列表", 4, thread_flags, ImVec2(0.0f, thread_panel_height - ImGui::GetFrameHeightWithSpacing()))) {
+                            ImGui::TableSetupScrollFreeze(0, 1);
+                            ImGui::TableSetupColumn("TID");
+                            ImGui::TableSetupColumn("线程名");
+                            ImGui::TableSetupColumn("CPU使用率 %");
+                            ImGui::TableSetupColumn("状态");
+                            ImGui::TableHeadersRow();
+
+                            if (g_Snapshot->threadPid == g_SelectedPid) {
+                                for (const auto& thread : g_Snapshot->threads) {
+                                    ImGui::TableNextRow();
+                                    ImGui::TableNextColumn();
+                                    ImGui::Text("%u", thread.tid);
+                                    ImGui::TableNextColumn();
+                                    ImGui::Text("%s", thread.name.c_str());
+                                    ImGui::TableNextColumn();
+                                    ImGui::Text("%.1f", thread.cpuUsage);
+                                    ImGui::TableNextColumn();
+                                    ImGui::Text("%s", thread.status.c_str());
+                                }
+                            }
+                            ImGui::EndTable();
+                        }
+                    }
+
+                    // 网络监控：格式化结果每次采样只计算一次
+                    const auto& networkInfos = g_Snapshot->networks;
+                    if (g_NetworkRowTextsSequence != g_Snapshot->sequence) {
+                        g_NetworkRowTextsSequence = g_Snapshot->sequence;
+                        g_NetworkRowTexts.resize(networkInfos.size());
+                        for (size_t i = 0; i < networkInfos.size(); i++) {
+                            const auto& net = networkInfos[i];
+                            NetworkRowText& text = g_NetworkRowTexts[i];
+                            text.upload = g_SystemMonitor.FormatBytes(net.uploadSpeed) + "/s";
+                            text.download = g_SystemMonitor.FormatBytes(net.downloadSpeed) + "/s";
+                            text.total = "↑" + g_SystemMonitor.FormatBytes(net.bytesSent) + " ↓" + g_SystemMonitor.FormatBytes(net.bytesReceived);
+                        }
+                    }
+                    if (ImGui::BeginTable("网络监控", 4, ImGuiTableFlags_Borders)) {
+                        ImGui::TableSetupColumn("适配器");
+                        ImGui::TableSetupColumn("上传速度");
+                        ImGui::TableSetupColumn("下载速度");
+                        ImGui::TableSetupColumn("总流量");
+                        ImGui::TableHeadersRow();
+
+                        ImGuiListClipper clipper;
+                        clipper.Begin((int)networkInfos.size());
+                        while (clipper.Step()) {
+                            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                                const NetworkRowText& text = g_NetworkRowTexts[row];
+                                ImGui::TableNextRow();
+                                ImGui::TableNextColumn();
+                                ImGui::TextUnformatted(networkInfos[row].adapterName.c_str());
+                                ImGui::TableNextColumn();
+                                ImGui::TextUnformatted(text.upload.c_str());
+                                ImGui::TableNextColumn();
+                                ImGui::TextUnformatted(text.download.c_str());
+                                ImGui::TableNextColumn();
+                                ImGui::TextUnformatted(text.total.c_str());
+                            }
+                        }
+                        ImGui::EndTable();
+                    }
+                    break;
+                }
+                case MenuPage::Settings:
+                {
+                    static bool enable_notifications = true;
+                    static bool dark_mode = true;
+                    static bool show_system_processes = true;
+                    static char log_path[256] = "system_monitor.log";
+                    static int selected_theme = 0;
+                    const char* themes[] = { "深色主题", "浅色主题", "蓝色主题", "绿色主题" };
+
+                    ImGui::Text("基本设置");
+                    ImGui::Separator();
+                    ImGui::Spacing();
+
+                    if (ImGui::Checkbox("启用通知", &enable_notifications)) {
+                        // 处理通知设置变更
+                    }
+
+                    if (ImGui::Checkbox("深色模式", &dark_mode)) {
+                        // 切换主题
+                        if (dark_mode)
+                            ImGui::StyleColorsDark();
+                        else
+                            ImGui::StyleColorsLight();
+                    }
+
+                    if (ImGui::SliderFloat("刷新频率 (秒)", &g_Settings.refresh_rate, 0.1f, 5.0f, "%.1f")) {
+                        g_SystemSampler.SetInterval(g_Settings.refresh_rate);
+                    }
+                    ImGui::SliderInt("进程显示数量限制", &g_Settings.process_limit, 0, 1000,
+                        g_Settings.process_limit == 0 ? "不限" : "%d");
+                    ImGui::Checkbox("显示系统进程", &show_system_processes);
+
+                    ImGui::Spacing();
+                    ImGui::Text("主题设置");
+                    ImGui::Separator();
+                    ImGui::Spacing();
+
+                    if (ImGui::Combo("选择主题", &selected_theme, themes, IM_ARRAYSIZE(themes))) {
+                        // 应用选择的主题
+                        switch (selected_theme) {
+                            case 0: ImGui::StyleColorsDark(); break;
+                            case 1: ImGui::StyleColorsLight(); break;
+                            case 2: ApplyBlueTheme(); break;
+                            case 3: ApplyGreenTheme(); break;
+                        }
+                    }
+
+                    ImGui::Spacing();
+                    ImGui::Text("录制回放");
+                    ImGui::Separator();
+                    ImGui::Spacing();
+
+                    // 录制文件由无窗口模式的 --record 生成
+                    static char replay_path[256] = "system_monitor.rec";
+                    static bool replay_failed = false;
+                    ImGui::InputText("录制文件", replay_path, sizeof(replay_path));
+                    if (g_ReplayCollector == nullptr) {
+                        if (ImGui::Button("开始回放"))
+                            replay_failed = !StartReplay(replay_path);
+                        if (replay_failed)
+                            ImGui::TextColored(ImVec4(1, 0, 0, 1), "无法打开录制文件");
+                    } else {
+                        double start = g_ReplayCollector->StartTime();
+                        float position = (float)(g_ReplayCollector->CurrentTime() - start);
+                        if (ImGui::SliderFloat("回放位置 (秒)", &position, 0.0f, (float)(g_ReplayCollector->EndTime() - start), "%.0f"))
+                            g_ReplayCollector->Seek(start + position);
+                        if (ImGui::Button("返回实时数据"))
+                            StopReplay();
+                    }
+
+                    ImGui::Spacing();
+                    ImGui::Text("日志设置");
+                    ImGui::Separator();
+                    ImGui::Spacing();
+
+                    ImGui::InputText("日志文件路径", log_path, sizeof(log_path));
+
+                    ImGui::Spacing();
+                    ImGui::Separator();
+                    ImGui::Spacing();
+
+                    if (ImGui::Button("保存设置", ImVec2(120, 30))) {
+                        // 保存所有设置
+                        SaveSettings(enable_notifications, dark_mode, g_Settings.refresh_rate, 
+                                    g_Settings.process_limit, show_system_processes, log_path, selected_theme);
+                    }
+                    ImGui::SameLine();
+                    if (ImGui::Button("重置设置", ImVec2(120, 30))) {
+                        // 重置为默认设置
+                        enable_notifications = true;
+                        dark_mode = true;
+                        g_Settings.refresh_rate = 1.0f;
+                        g_SystemSampler.SetInterval(g_Settings.refresh_rate);
+                        g_Settings.process_limit = 50;
+                        show_system_processes = true;
+                        strcpy(log_path, "system_monitor.log");
+                        selected_theme = 0;
+                        ImGui::StyleColorsDark();
+                    }
+
+                    // 显示关于信息
+                    ImGui::Spacing();
+                    ImGui::Separator();
+                    ImGui::Text("关于");
+                    ImGui::Text("系统监控工具 v1.0.0");
+                    ImGui::Text("作者: Your Name");
+                    ImGui::Text("构建时间: %s %s", __DATE__, __TIME__);
+                    break;
+                }
+            }
+        }
+        ImGui::End();
+    }
+    catch (...) {
+        // 确保样式被正确恢复
+        ImGui::PopStyleColor(color_count);
+        ImGui::PopStyleVar(2);
+        ImGui::GetStyle() = style_backup;
+        throw;
+    }
+
+    // 恢复样式
+    ImGui::PopStyleColor(color_count);
+    ImGui::PopStyleVar(2);
+}
+
+// 按需渲染时，界面自己的动画不会产生输入或新数据，需要定时再渲染一帧：
+// 悬停提示在 HoverDelayNormal 之后出现，输入框的光标会闪烁；曲线读到撕裂的数据时立即重画
+inline void RequestDashboardAnimationFrames(FrameScheduler& scheduler) {
+    if (g_HistoryViewTorn) {
+        g_HistoryViewTorn = false;
+        scheduler.RequestFrameAfter(0.0f);
+    }
+    if (ImGui::GetIO().WantTextInput)
+        scheduler.RequestFrameAfter(0.5f);
+    if (ImGui::IsAnyItemHovered())
+        scheduler.RequestFrameAfter(ImGui::GetStyle().HoverDelayNormal);
+}
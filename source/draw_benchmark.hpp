@@ -0,0 +1,169 @@
+// ImDrawList 三角化基准测试
+// 测量 AddPolyline/AddConvexPolyFilled 在不同点数下每个点的耗时，对比 SIMD（SSE/NEON）和标量两条路径，
+// 并检查两条路径生成的顶点和索引完全相同。每个组合输出一行 JSON，人能读的摘要写到标准错误。
+//   polyline      1 像素抗锯齿折线（无纹理，每点 3 个顶点，曲线图用的就是这种）
+//   polyline_tex  1 像素抗锯齿折线（用字体图集里的线条纹理，每点 2 个顶点）
+//   polyline_thick 3.5 像素抗锯齿折线（每点 4 个顶点）
+//   convex        抗锯齿凸多边形填充
+//
+// 用法：app --bench-draw [--points 16,64,256,...] [--rounds N] [--output -|文件路径]
+#pragma once
+#include "imgui/imgui.h"
+#include "imgui/imgui_internal.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct DrawBenchOptions {
+    std::vector<int> points = { 16, 64, 256, 1024, 4096, 16384 };
+    int rounds = 7;               // 每个组合重复测量的次数，取最快的一次
+    std::string output = "-";     // 结果输出位置，"-" 为标准输出
+};
+
+// 命令行中有 --bench-draw 时返回 true 并解析其余选项
+inline bool ParseDrawBenchOptions(int argc, char** argv, DrawBenchOptions& options) {
+    bool bench = false;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--bench-draw") == 0) {
+            bench = true;
+        } else if (strcmp(arg, "--points") == 0 && value) {
+            options.points.clear();
+            for (const char* p = value; *p;) {
+                char* end = nullptr;
+                long n = strtol(p, &end, 10);
+                if (end == p) break;
+                if (n >= 3) options.points.push_back((int)n);
+                p = *end == ',' ? end + 1 : end;
+            }
+            i++;
+        } else if (strcmp(arg, "--rounds") == 0 && value) {
+            options.rounds = atoi(value) > 0 ? atoi(value) : 1;
+            i++;
+        } else if (strcmp(arg, "--output") == 0 && value) {
+            options.output = value;
+            i++;
+        }
+    }
+    return bench;
+}
+
+enum class DrawBenchCase { Polyline, PolylineTex, PolylineThick, Convex };
+
+// 每帧把 shape 重复绘制到 drawList，直到累计约 pointsPerFrame 个点（缓冲区大小和一帧里所有曲线相当，能留在缓存里），
+// 重复多帧直到累计 minSeconds 秒；返回每个点的耗时（纳秒）
+inline double TimeDrawBenchCase(ImDrawList* drawList, DrawBenchCase which, const std::vector<ImVec2>& shape, int pointsPerFrame, double minSeconds) {
+    const int count = (int)shape.size();
+    const int repeat = pointsPerFrame / count > 0 ? pointsPerFrame / count : 1;
+    const ImU32 col = IM_COL32(90, 200, 120, 255);
+
+    using Clock = std::chrono::steady_clock;
+    uint64_t frames = 0;
+    Clock::time_point start = Clock::now(), now = start;
+    do {
+        drawList->_ResetForNewFrame();
+        drawList->PushClipRectFullScreen();
+        drawList->PushTextureID(ImGui::GetIO().Fonts->TexID);
+        drawList->Flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill | ImDrawListFlags_AllowVtxOffset;
+        if (which == DrawBenchCase::PolylineTex) drawList->Flags |= ImDrawListFlags_AntiAliasedLinesUseTex;
+        for (int r = 0; r < repeat; r++) {
+            switch (which) {
+            case DrawBenchCase::Polyline:
+            case DrawBenchCase::PolylineTex: drawList->AddPolyline(shape.data(), count, col, ImDrawFlags_None, 1.0f); break;
+            case DrawBenchCase::PolylineThick: drawList->AddPolyline(shape.data(), count, col, ImDrawFlags_None, 3.5f); break;
+            case DrawBenchCase::Convex: drawList->AddConvexPolyFilled(shape.data(), count, col); break;
+            }
+        }
+        frames++;
+        now = Clock::now();
+    } while (std::chrono::duration<double>(now - start).count() < minSeconds);
+    return std::chrono::duration<double, std::nano>(now - start).count() / ((double)frames * repeat * count);
+}
+
+// 基准测试主函数，返回进程退出码
+inline int RunDrawBench(const DrawBenchOptions& options) {
+    FILE* out = stdout;
+    if (options.output != "-") {
+        out = fopen(options.output.c_str(), "w");
+        if (!out) {
+            fprintf(stderr, "无法创建输出文件: %s\n", options.output.c_str());
+            return 1;
+        }
+    }
+
+    // 需要一个完整的上下文：抗锯齿线条的纹理坐标和白色像素来自字体图集
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(4096.0f, 4096.0f);
+    io.Fonts->Build();
+    io.Fonts->SetTexID((ImTextureID)1);
+    ImGui::NewFrame();
+    ImDrawListSharedData* shared = ImGui::GetDrawListSharedData();
+    ImDrawList drawList(shared);
+    ImDrawList reference(shared);
+
+    static const struct { DrawBenchCase which; const char* name; } cases[] = {
+        { DrawBenchCase::Polyline, "polyline" },
+        { DrawBenchCase::PolylineTex, "polyline_tex" },
+        { DrawBenchCase::PolylineThick, "polyline_thick" },
+        { DrawBenchCase::Convex, "convex" },
+    };
+    const int pointsPerFrame = 8192;
+    bool identical = true;
+
+    fprintf(stderr, "%-15s %7s %12s %12s %8s\n", "case", "points", "scalar ns/pt", "simd ns/pt", "speedup");
+    for (const auto& c : cases) {
+        for (int points : options.points) {
+            // 折线是一条正弦曲线（和曲线图一样 x 单调递增），凸多边形是顺时针的圆
+            std::vector<ImVec2> shape((size_t)points);
+            for (int i = 0; i < points; i++) {
+                float t = (float)i / (float)points;
+                if (c.which == DrawBenchCase::Convex)
+                    shape[i] = ImVec2(2048.0f + 1500.0f * cosf(-6.2831853f * t), 2048.0f + 1500.0f * sinf(-6.2831853f * t));
+                else
+                    shape[i] = ImVec2(48.0f + 4000.0f * t, 2048.0f + 1000.0f * sinf(t * 40.0f) + 30.0f * sinf(t * 977.0f));
+            }
+
+            double best[2] = { 1e30, 1e30 };   // [0] 标量，[1] SIMD
+            for (int round = 0; round < options.rounds; round++) {
+                for (int simd = 0; simd < 2; simd++) {
+                    shared->TessellationNoSimd = simd == 0;
+                    double ns = TimeDrawBenchCase(&drawList, c.which, shape, pointsPerFrame, 0.02);
+                    if (ns < best[simd]) best[simd] = ns;
+                }
+            }
+
+            // 两条路径各画一次，逐字节比较
+            shared->TessellationNoSimd = true;
+            TimeDrawBenchCase(&reference, c.which, shape, 1, 0.0);
+            shared->TessellationNoSimd = false;
+            TimeDrawBenchCase(&drawList, c.which, shape, 1, 0.0);
+            bool same = drawList.VtxBuffer.Size == reference.VtxBuffer.Size && drawList.IdxBuffer.Size == reference.IdxBuffer.Size &&
+                        memcmp(drawList.VtxBuffer.Data, reference.VtxBuffer.Data, (size_t)drawList.VtxBuffer.Size * sizeof(ImDrawVert)) == 0 &&
+                        memcmp(drawList.IdxBuffer.Data, reference.IdxBuffer.Data, (size_t)drawList.IdxBuffer.Size * sizeof(ImDrawIdx)) == 0;
+            identical = identical && same;
+
+            double speedup = best[1] > 0.0 ? best[0] / best[1] : 0.0;
+            fprintf(stderr, "%-15s %7d %12.2f %12.2f %7.2fx%s\n", c.name, points, best[0], best[1], speedup, same ? "" : "  输出不一致！");
+            fprintf(out, "{\"case\":\"%s\",\"points\":%d,\"scalar_ns_per_point\":%.3f,\"simd_ns_per_point\":%.3f,\"speedup\":%.3f,\"identical\":%s}\n",
+                    c.name, points, best[0], best[1], speedup, same ? "true" : "false");
+            fflush(out);
+        }
+    }
+    shared->TessellationNoSimd = false;
+
+    drawList._ClearFreeMemory();
+    reference._ClearFreeMemory();
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    if (out != stdout) fclose(out);
+    return identical ? 0 : 1;
+}
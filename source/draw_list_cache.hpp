@@ -0,0 +1,133 @@
+// ImDrawList 片段缓存
+// 仪表盘上的圆形仪表、饼图这类自绘图形，每帧都要重新计算几十次三角函数、重新生成抗锯齿的三角形，
+// 而它们的外观只取决于少数几个值（例如保留一位小数的占用率），在两次采样之间通常完全不变。
+// DrawListCache 把一段绘制生成的顶点和索引保存下来，只要失效键不变，之后每帧只把它们平移后复制回绘制列表。
+//
+// 用法：
+//   static DrawListCache cache;
+//   if (cache.Begin(draw_list, key, origin)) {
+//       ... 以 origin 为基准正常绘制 ...
+//       cache.End();
+//   }
+// key 必须包含所有影响外观的值；origin 是片段的基准点，窗口滚动或移动时缓存平移后仍然有效。
+// 字体、纹理、抗锯齿设置或裁剪矩形（相对 origin）变化时自动重新绘制。
+// 片段内不能切换裁剪矩形或纹理（PushClipRect/PushTextureID），否则 End() 不缓存，下一帧仍然重新绘制。
+// 只缓存绘制，不缓存控件：需要响应鼠标的控件（按钮、可选项）仍然要每帧提交。
+#pragma once
+#include "imgui/imgui.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+class DrawListCache {
+public:
+    // 缓存有效时把它回放到 drawList 并返回 false；否则返回 true，调用方绘制完后必须调用 End()
+    bool Begin(ImDrawList* drawList, uint64_t key, const ImVec2& origin) {
+        IM_ASSERT(recording == nullptr && "DrawListCache::Begin() without End()");
+        State state = CurrentState(drawList, key, origin);
+        if (valid && state.SameAs(cached)) {
+            Replay(drawList, ImVec2(origin.x - cachedOrigin.x, origin.y - cachedOrigin.y));
+            return false;
+        }
+        cached = state;
+        cachedOrigin = origin;
+        recording = drawList;
+        startCmdCount = drawList->CmdBuffer.Size;
+        startVtx = drawList->VtxBuffer.Size;
+        startIdx = drawList->IdxBuffer.Size;
+        startVtxIdx = drawList->_VtxCurrentIdx;
+        startVtxOffset = drawList->_CmdHeader.VtxOffset;
+        return true;
+    }
+
+    void End() {
+        IM_ASSERT(recording != nullptr && "DrawListCache::End() without Begin()");
+        ImDrawList* drawList = recording;
+        recording = nullptr;
+
+        // 片段必须落在同一条绘制命令里，索引才能整体平移
+        valid = drawList->CmdBuffer.Size == startCmdCount &&
+                drawList->_CmdHeader.VtxOffset == startVtxOffset &&
+                drawList->_CmdHeader.TextureId == cached.texture &&
+                drawList->_VtxCurrentIdx >= startVtxIdx;
+        if (!valid) return;
+
+        vertices.assign(drawList->VtxBuffer.Data + startVtx, drawList->VtxBuffer.Data + drawList->VtxBuffer.Size);
+        indices.resize((size_t)(drawList->IdxBuffer.Size - startIdx));
+        const ImDrawIdx* src = drawList->IdxBuffer.Data + startIdx;
+        for (size_t i = 0; i < indices.size(); i++)
+            indices[i] = (ImDrawIdx)(src[i] - startVtxIdx);
+    }
+
+    void Invalidate() { valid = false; }
+
+private:
+    // 失效键和影响生成结果的绘制环境
+    struct State {
+        uint64_t key;
+        ImTextureID texture;
+        ImFont* font;
+        float fontSize;
+        float fringeScale;
+        int flags;
+        ImVec4 clipRect;   // 相对 origin：文字会按裁剪矩形丢弃字形
+
+        bool SameAs(const State& o) const {
+            return key == o.key && texture == o.texture && font == o.font && fontSize == o.fontSize &&
+                   fringeScale == o.fringeScale && flags == o.flags &&
+                   clipRect.x == o.clipRect.x && clipRect.y == o.clipRect.y &&
+                   clipRect.z == o.clipRect.z && clipRect.w == o.clipRect.w;
+        }
+    };
+
+    static State CurrentState(ImDrawList* drawList, uint64_t key, const ImVec2& origin) {
+        State state;
+        state.key = key;
+        state.texture = drawList->_CmdHeader.TextureId;
+        state.font = ImGui::GetFont();
+        state.fontSize = ImGui::GetFontSize();
+        state.fringeScale = drawList->_FringeScale;
+        state.flags = drawList->Flags;
+        const ImVec4& clip = drawList->_CmdHeader.ClipRect;
+        state.clipRect = ImVec4(clip.x - origin.x, clip.y - origin.y, clip.z - origin.x, clip.w - origin.y);
+        return state;
+    }
+
+    void Replay(ImDrawList* drawList, const ImVec2& offset) {
+        if (indices.empty()) return;
+        const int vtxCount = (int)vertices.size();
+        const int idxCount = (int)indices.size();
+        drawList->PrimReserve(idxCount, vtxCount);
+
+        ImDrawVert* vtx = drawList->_VtxWritePtr;
+        memcpy(vtx, vertices.data(), (size_t)vtxCount * sizeof(ImDrawVert));
+        if (offset.x != 0.0f || offset.y != 0.0f) {
+            for (int i = 0; i < vtxCount; i++) {
+                vtx[i].pos.x += offset.x;
+                vtx[i].pos.y += offset.y;
+            }
+        }
+        const ImDrawIdx base = (ImDrawIdx)drawList->_VtxCurrentIdx;
+        ImDrawIdx* idx = drawList->_IdxWritePtr;
+        for (int i = 0; i < idxCount; i++)
+            idx[i] = (ImDrawIdx)(base + indices[i]);
+
+        drawList->_VtxWritePtr += vtxCount;
+        drawList->_IdxWritePtr += idxCount;
+        drawList->_VtxCurrentIdx += (unsigned int)vtxCount;
+    }
+
+    bool valid = false;
+    State cached = {};
+    ImVec2 cachedOrigin;
+    std::vector<ImDrawVert> vertices;
+    std::vector<ImDrawIdx> indices;
+
+    // 录制中的状态
+    ImDrawList* recording = nullptr;
+    int startCmdCount = 0;
+    int startVtx = 0;
+    int startIdx = 0;
+    unsigned int startVtxIdx = 0;
+    unsigned int startVtxOffset = 0;
+};
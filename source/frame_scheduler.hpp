@@ -0,0 +1,123 @@
+// 按需渲染的帧调度
+// 界面上的数据只在采样线程发布新快照时变化，持续按显示器刷新率重绘只是在空耗 CPU/GPU。
+// FrameScheduler 让主循环在没有事情可做时阻塞：直到有窗口消息（输入、缩放等）、采样线程调用 Wake()、
+// 或者之前请求的定时帧（悬停提示的延迟、文本光标闪烁）到期。
+// 每次有活动之后再多渲染几帧（TRAILING_FRAMES），让 ImGui 的悬停状态、布局等在输入停止后稳定下来。
+//
+// 主循环：
+//   scheduler.Wait();                    // 空闲时阻塞在这里
+//   处理消息，每条消息调用 scheduler.NotifyActivity();
+//   渲染一帧，然后调用 scheduler.FrameRendered();
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+class FrameScheduler {
+public:
+    static const int TRAILING_FRAMES = 3;
+
+    FrameScheduler() {
+#ifdef _WIN32
+        wakeEvent = CreateEventW(NULL, FALSE, FALSE, NULL);
+#endif
+    }
+
+    ~FrameScheduler() {
+#ifdef _WIN32
+        if (wakeEvent) CloseHandle(wakeEvent);
+#endif
+    }
+
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    // 请求尽快渲染，可以在任何线程调用（例如采样线程发布新数据之后）
+    void Wake() {
+        wakeRequested.store(true, std::memory_order_release);
+#ifdef _WIN32
+        SetEvent(wakeEvent);
+#else
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+        }
+        wakeup.notify_one();
+#endif
+    }
+
+    // 以下只能在主线程调用
+
+    // 有输入等活动：接下来连续渲染 TRAILING_FRAMES 帧
+    void NotifyActivity() { pendingFrames = TRAILING_FRAMES; }
+
+    // seconds 秒后至少再渲染一帧；多次调用取最早的时间
+    void RequestFrameAfter(float seconds) {
+        auto when = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(seconds));
+        if (!hasDeadline || when < deadline) deadline = when;
+        hasDeadline = true;
+    }
+
+    // 放弃还没渲染的帧（例如窗口被遮挡时），之后只在有新活动时渲染
+    void CancelPendingFrames() { pendingFrames = 0; }
+
+    void FrameRendered() {
+        if (pendingFrames > 0) pendingFrames--;
+    }
+
+    // 需要渲染时立即返回；否则阻塞，直到有窗口消息（Windows）、Wake() 或定时帧到期。
+    // 返回后调用方照常处理消息，再用 HasPendingFrames() 判断是否需要渲染
+    void Wait() {
+        if (pendingFrames > 0 || TakeWake() || TakeDeadline()) return;
+#ifdef _WIN32
+        DWORD timeout = INFINITE;
+        if (hasDeadline) {
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+            timeout = ms < 0 ? 0 : (DWORD)ms + 1;
+        }
+        MsgWaitForMultipleObjectsEx(1, &wakeEvent, timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+#else
+        std::unique_lock<std::mutex> lock(mutex);
+        auto ready = [this] { return wakeRequested.load(std::memory_order_acquire); };
+        if (hasDeadline)
+            wakeup.wait_until(lock, deadline, ready);
+        else
+            wakeup.wait(lock, ready);
+#endif
+        TakeWake();
+        TakeDeadline();
+    }
+
+    bool HasPendingFrames() const { return pendingFrames > 0; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // 新数据只需要重绘到稳定为止，和输入一样处理
+    bool TakeWake() {
+        if (!wakeRequested.exchange(false, std::memory_order_acq_rel)) return false;
+        pendingFrames = TRAILING_FRAMES;
+        return true;
+    }
+
+    bool TakeDeadline() {
+        if (!hasDeadline || Clock::now() < deadline) return false;
+        hasDeadline = false;
+        if (pendingFrames < 1) pendingFrames = 1;
+        return true;
+    }
+
+    std::atomic<bool> wakeRequested{false};
+    int pendingFrames = TRAILING_FRAMES;   // 启动时先渲染几帧
+    bool hasDeadline = false;
+    Clock::time_point deadline;
+#ifdef _WIN32
+    HANDLE wakeEvent = NULL;
+#else
+    std::mutex mutex;
+    std::condition_variable wakeup;
+#endif
+};
@@ -0,0 +1,407 @@
+// 无窗口的采集/导出模式
+// 不创建窗口和 D3D 设备，主线程按固定节拍调用 SystemMonitor，每次采样编码成一行 JSON，
+// 写到标准输出、文件或者本地 Unix socket（Linux）。
+// 节拍由 timerfd（Linux）或可等待定时器（Windows）驱动，两次采样之间线程一直阻塞，不占 CPU。
+//
+// 同时可以用 --record 把完整的采样数据录制成二进制文件，之后在界面中回放（见 snapshot_recording.hpp）
+//
+// 用法：app --headless [--interval 秒] [--output -|none|文件路径|unix:/path/to.sock] [--top N] [--count N] [--record 文件路径]
+#pragma once
+#include "system_monitor.hpp"
+#include "system_sampler.hpp"
+#include "snapshot_recording.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdarg>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#endif
+
+struct HeadlessOptions {
+    float intervalSeconds = 1.0f;
+    std::string output = "-";   // "-" 为标准输出，"none" 不输出，"unix:" 开头为 Unix socket，其余为文件（追加写入）
+    int top = 20;               // 每次输出 CPU 占用最高的进程数，0 表示全部
+    uint64_t count = 0;         // 采样次数，0 表示一直运行
+    std::string record;         // 录制文件路径，为空时不录制
+};
+
+// 命令行中有 --headless 时返回 true 并解析它后面的选项；没有 --headless 时不解析也不报错，
+// 参数留给其他模式
+inline bool ParseHeadlessOptions(int argc, char** argv, HeadlessOptions& options) {
+    bool headless = false;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--headless") == 0) {
+            headless = true;
+        } else if (!headless) {
+            continue;
+        } else if (strcmp(arg, "--interval") == 0 && value) {
+            options.intervalSeconds = (float)atof(value);
+            i++;
+        } else if (strcmp(arg, "--output") == 0 && value) {
+            options.output = value;
+            i++;
+        } else if (strcmp(arg, "--top") == 0 && value) {
+            options.top = atoi(value);
+            i++;
+        } else if (strcmp(arg, "--count") == 0 && value) {
+            options.count = strtoull(value, nullptr, 10);
+            i++;
+        } else if (strcmp(arg, "--record") == 0 && value) {
+            options.record = value;
+            i++;
+        } else {
+            fprintf(stderr, "未知参数: %s\n", arg);
+        }
+    }
+    if (options.intervalSeconds < 0.05f) options.intervalSeconds = 0.05f;
+    return headless;
+}
+
+// 把快照编码成一行紧凑的 JSON，输出缓冲区在多次调用之间复用
+// {"seq":1,"t":1700000000.000,"cpu":3.5,"mem":41.2,"disk":7.0,"up":12.50,"temp":45.0,"cores":[..],
+//  "net":[["eth0",rx,tx,down,up],..],"disks":[["/",total,used,read,write],..],"procs":[[pid,"name",cpu,memMB,"status"],..]}
+class SnapshotEncoder {
+public:
+    const std::string& Encode(const SystemSnapshot& snapshot, double time, int top) {
+        const SystemInfo& system = snapshot.system;
+        out.clear();
+        Append("{\"seq\":%llu,\"t\":%.3f", (unsigned long long)snapshot.sequence, time);
+        Append(",\"cpu\":%.1f,\"mem\":%.1f,\"disk\":%.1f,\"up\":%.2f,\"temp\":%.1f",
+            system.cpuUsage, system.memoryUsage, system.diskUsage, system.systemUptime, system.cpuTemperature);
+
+        out += ",\"cores\":[";
+        for (size_t i = 0; i < system.coreUsage.size(); i++)
+            Append(i ? ",%.1f" : "%.1f", system.coreUsage[i]);
+
+        out += "],\"net\":[";
+        for (size_t i = 0; i < snapshot.networks.size(); i++) {
+            const NetworkInfo& net = snapshot.networks[i];
+            out += i ? ",[" : "[";
+            AppendString(net.adapterName);
+            Append(",%llu,%llu,%.0f,%.0f]", (unsigned long long)net.bytesReceived, (unsigned long long)net.bytesSent,
+                net.downloadSpeed, net.uploadSpeed);
+        }
+
+        out += "],\"disks\":[";
+        for (size_t i = 0; i < snapshot.disks.size(); i++) {
+            const DiskInfo& disk = snapshot.disks[i];
+            out += i ? ",[" : "[";
+            AppendString(disk.driveLetter);
+            Append(",%.2f,%.2f,%.2f,%.2f]", disk.totalSpace, disk.usedSpace, disk.readSpeed, disk.writeSpeed);
+        }
+
+        // 只输出 CPU 占用最高的 top 个进程
+        const std::vector<ProcessInfo>& processes = snapshot.processes;
+        order.resize(processes.size());
+        for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+        size_t shown = (top > 0 && (size_t)top < order.size()) ? (size_t)top : order.size();
+        std::partial_sort(order.begin(), order.begin() + shown, order.end(), [&processes](uint32_t a, uint32_t b) {
+            return processes[a].cpuUsage > processes[b].cpuUsage;
+        });
+
+        out += "],\"procs\":[";
+        for (size_t i = 0; i < shown; i++) {
+            const ProcessInfo& process = processes[order[i]];
+            Append(i ? ",[%u," : "[%u,", process.pid);
+            AppendString(process.name);
+            Append(",%.1f,%zu,", process.cpuUsage, process.memoryUsage);
+            AppendString(process.status);
+            out += ']';
+        }
+        out += "]}\n";
+        return out;
+    }
+
+private:
+    std::string out;
+    std::vector<uint32_t> order;
+
+    void Append(const char* format, ...) {
+        char text[256];
+        va_list args;
+        va_start(args, format);
+        int length = vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+        if (length > 0) out.append(text, std::min((size_t)length, sizeof(text) - 1));
+    }
+
+    void AppendString(const std::string& text) {
+        out += '"';
+        for (unsigned char c : text) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (c < 0x20) {
+                        char escaped[8];
+                        snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        out += escaped;
+                    } else {
+                        out += (char)c;
+                    }
+            }
+        }
+        out += '"';
+    }
+};
+
+// 输出目标：标准输出、文件，或者 Unix socket
+// Unix socket 模式下本进程监听 path，每次输出前接受新的连接，写不进去的客户端直接断开，不会阻塞采样
+class ExportSink {
+public:
+    ExportSink() = default;
+    ExportSink(const ExportSink&) = delete;
+    ExportSink& operator=(const ExportSink&) = delete;
+
+    ~ExportSink() { Close(); }
+
+    bool Open(const std::string& target) {
+        Close();
+        if (target == "-") {
+            file = stdout;
+            return true;
+        }
+        if (target.compare(0, 5, "unix:") == 0) {
+#ifdef _WIN32
+            fprintf(stderr, "Windows 下不支持 Unix socket 输出\n");
+            return false;
+#else
+            return Listen(target.substr(5));
+#endif
+        }
+        file = fopen(target.c_str(), "ab");
+        ownsFile = file != nullptr;
+        if (!file) fprintf(stderr, "无法打开输出文件: %s\n", target.c_str());
+        return file != nullptr;
+    }
+
+    void Close() {
+        if (ownsFile && file) fclose(file);
+        file = nullptr;
+        ownsFile = false;
+#ifndef _WIN32
+        for (int client : clients) ::close(client);
+        clients.clear();
+        if (listenFd >= 0) {
+            ::close(listenFd);
+            listenFd = -1;
+            unlink(socketPath.c_str());
+        }
+#endif
+    }
+
+    // 写入一行，返回 false 表示输出已经不可用（例如管道的读端已经关闭）
+    bool Write(const std::string& line) {
+        if (file) {
+            if (fwrite(line.data(), 1, line.size(), file) != line.size()) return false;
+            return fflush(file) == 0;
+        }
+#ifndef _WIN32
+        if (listenFd >= 0) {
+            AcceptClients();
+            for (size_t i = 0; i < clients.size();) {
+                // 只写了一部分的客户端也断开，保证每个客户端收到的都是完整的行
+                ssize_t n = send(clients[i], line.data(), line.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+                if (n != (ssize_t)line.size()) {
+                    ::close(clients[i]);
+                    clients[i] = clients.back();
+                    clients.pop_back();
+                } else {
+                    i++;
+                }
+            }
+            return true;
+        }
+#endif
+        return false;
+    }
+
+private:
+    FILE* file = nullptr;
+    bool ownsFile = false;
+#ifndef _WIN32
+    int listenFd = -1;
+    std::string socketPath;
+    std::vector<int> clients;
+
+    bool Listen(const std::string& path) {
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            fprintf(stderr, "无效的 Unix socket 路径: %s\n", path.c_str());
+            return false;
+        }
+        memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0) return false;
+        unlink(path.c_str());
+        if (bind(listenFd, (const sockaddr*)&address, sizeof(address)) != 0 || listen(listenFd, 16) != 0) {
+            fprintf(stderr, "无法监听 Unix socket %s: %s\n", path.c_str(), strerror(errno));
+            ::close(listenFd);
+            listenFd = -1;
+            return false;
+        }
+        socketPath = path;
+        return true;
+    }
+
+    void AcceptClients() {
+        for (;;) {
+            int client = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (client < 0) break;
+            clients.push_back(client);
+        }
+    }
+#endif
+};
+
+// 固定节拍的定时器，Wait() 阻塞到下一个节拍
+// Linux 用 timerfd，创建失败时退化为 clock_nanosleep 按绝对时间睡眠；Windows 用周期性的可等待定时器
+class TickTimer {
+public:
+    explicit TickTimer(double intervalSeconds) {
+        uint64_t intervalNs = (uint64_t)(intervalSeconds * 1e9);
+#ifdef _WIN32
+        timer = CreateWaitableTimerW(NULL, FALSE, NULL);
+        LARGE_INTEGER due;
+        due.QuadPart = -(LONGLONG)(intervalNs / 100);  // 负数表示相对时间，单位 100ns
+        if (timer) SetWaitableTimer(timer, &due, (LONG)(intervalNs / 1000000), NULL, NULL, FALSE);
+#else
+        interval.tv_sec = (time_t)(intervalNs / 1000000000ull);
+        interval.tv_nsec = (long)(intervalNs % 1000000000ull);
+        fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        if (fd >= 0) {
+            itimerspec spec;
+            spec.it_interval = interval;
+            spec.it_value = interval;
+            timerfd_settime(fd, 0, &spec, nullptr);
+        } else {
+            clock_gettime(CLOCK_MONOTONIC, &deadline);
+        }
+#endif
+    }
+
+    ~TickTimer() {
+#ifdef _WIN32
+        if (timer) CloseHandle(timer);
+#else
+        if (fd >= 0) ::close(fd);
+#endif
+    }
+
+    TickTimer(const TickTimer&) = delete;
+    TickTimer& operator=(const TickTimer&) = delete;
+
+    // 返回自上次 Wait() 以来经过的节拍数，大于 1 说明采样耗时超过了间隔，错过的节拍直接跳过；
+    // 被信号打断时返回 0
+    uint64_t Wait() {
+#ifdef _WIN32
+        if (!timer) return 0;
+        return WaitForSingleObject(timer, INFINITE) == WAIT_OBJECT_0 ? 1 : 0;
+#else
+        if (fd >= 0) {
+            uint64_t expirations = 0;
+            if (read(fd, &expirations, sizeof(expirations)) != (ssize_t)sizeof(expirations)) return 0;
+            return expirations;
+        }
+        deadline.tv_sec += interval.tv_sec;
+        deadline.tv_nsec += interval.tv_nsec;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        return clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == 0 ? 1 : 0;
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE timer = NULL;
+#else
+    int fd = -1;
+    timespec interval = {};
+    timespec deadline = {};
+#endif
+};
+
+static volatile sig_atomic_t g_HeadlessStop = 0;
+
+#ifdef _WIN32
+static BOOL WINAPI HeadlessConsoleHandler(DWORD) {
+    g_HeadlessStop = 1;
+    return TRUE;
+}
+#else
+static void HeadlessSignalHandler(int) {
+    g_HeadlessStop = 1;
+}
+#endif
+
+// 无窗口模式的主循环，返回进程退出码
+inline int RunHeadless(const HeadlessOptions& options) {
+    // Ctrl+C/SIGTERM 只设置标志；不带 SA_RESTART，阻塞中的 Wait() 会立即返回
+#ifdef _WIN32
+    SetConsoleCtrlHandler(HeadlessConsoleHandler, TRUE);
+#else
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = HeadlessSignalHandler;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    bool exportLines = options.output != "none";
+    ExportSink sink;
+    if (exportLines && !sink.Open(options.output)) return 1;
+
+    SnapshotRecorder recorder;
+    if (!options.record.empty() && !recorder.Open(options.record)) {
+        fprintf(stderr, "无法创建录制文件: %s\n", options.record.c_str());
+        return 1;
+    }
+
+    SystemMonitor monitor;
+    SystemSnapshot snapshot;
+    SnapshotEncoder encoder;
+    TickTimer timer(options.intervalSeconds);
+
+    // 第一次采样只用来建立各项增量的基准，从第二次开始输出
+    CollectSnapshot(monitor, snapshot, SystemSnapshot::NO_PROCESS);
+    uint64_t written = 0;
+    while (!g_HeadlessStop && (options.count == 0 || written < options.count)) {
+        if (timer.Wait() == 0) continue;
+        CollectSnapshot(monitor, snapshot, SystemSnapshot::NO_PROCESS);
+        snapshot.sequence = ++written;
+        double now = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+        if (recorder.IsOpen() && !recorder.Append(snapshot, now))
+            fprintf(stderr, "录制失败，已停止录制: %s\n", recorder.Error().c_str());
+        if (exportLines && !sink.Write(encoder.Encode(snapshot, now, options.top))) break;
+    }
+    if (recorder.IsOpen() && !recorder.Close())
+        fprintf(stderr, "录制失败: %s\n", recorder.Error().c_str());
+    return recorder.Error().empty() ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+// 对数分桶的延迟直方图，内存大小固定，和样本数量无关
+// 用于 log_benchmark.hpp 的生产者延迟和 dashboard_render.hpp 的帧时间统计
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 对数分桶的延迟直方图（纳秒）：64 以下每个值一个桶，之后每个 2 的幂区间分 32 个桶
+class LatencyHistogram {
+public:
+    LatencyHistogram() : buckets(LinearBuckets + (MaxExponent - 5) * SubBuckets, 0) {}
+
+    void Record(uint64_t ns) {
+        buckets[BucketOf(ns)]++;
+        total++;
+        if (ns > maxValue) maxValue = ns;
+    }
+
+    void Merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < buckets.size(); i++) buckets[i] += other.buckets[i];
+        total += other.total;
+        if (other.maxValue > maxValue) maxValue = other.maxValue;
+    }
+
+    // 返回所在桶的上界，和 HdrHistogram 的 highestEquivalentValue 一致
+    uint64_t Percentile(double percent) const {
+        if (total == 0) return 0;
+        uint64_t rank = (uint64_t)(percent / 100.0 * (double)total + 0.5);
+        if (rank < 1) rank = 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < buckets.size(); i++) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                uint64_t upper = UpperBound(i);
+                return upper < maxValue ? upper : maxValue;
+            }
+        }
+        return maxValue;
+    }
+
+    uint64_t Max() const { return maxValue; }
+    uint64_t Count() const { return total; }
+
+private:
+    static constexpr int LinearBuckets = 64;
+    static constexpr int SubBuckets = 32;
+    static constexpr int MaxExponent = 40;   // 2^40 ns，约 18 分钟
+
+    std::vector<uint64_t> buckets;
+    uint64_t total = 0;
+    uint64_t maxValue = 0;
+
+    static int Log2(uint64_t v) {
+        int e = 0;
+        while (v >>= 1) e++;
+        return e;
+    }
+
+    static size_t BucketOf(uint64_t ns) {
+        if (ns < LinearBuckets) return (size_t)ns;
+        int e = Log2(ns);
+        if (e > MaxExponent) return LinearBuckets + (MaxExponent - 5) * SubBuckets - 1;
+        uint64_t sub = (ns >> (e - 5)) & (SubBuckets - 1);
+        return LinearBuckets + (size_t)(e - 6) * SubBuckets + (size_t)sub;
+    }
+
+    static uint64_t UpperBound(size_t bucket) {
+        if (bucket < LinearBuckets) return bucket;
+        size_t e = (bucket - LinearBuckets) / SubBuckets + 6;
+        size_t sub = (bucket - LinearBuckets) % SubBuckets;
+        return ((uint64_t)(SubBuckets + sub + 1) << (e - 5)) - 1;
+    }
+};
@@ -0,0 +1,36 @@
+// log_bench 的堆分配计数器，由 bench/log_bench_allocs.cpp 中替换的全局 operator new 调用 Count()
+// 不依赖 spdlog：替换分配函数的翻译单元只包含这个头文件，其中没有任何 new/delete 表达式
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// 按线程分散到多个计数槽，避免 64 个线程抢同一条缓存行
+namespace LogBenchAllocs {
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> count{0};
+    };
+    constexpr unsigned SlotCount = 64;
+
+    inline Slot* Slots() {
+        static Slot slots[SlotCount];
+        return slots;
+    }
+
+    inline std::atomic<bool>& Enabled() {
+        static std::atomic<bool> enabled{false};
+        return enabled;
+    }
+
+    inline void Count() {
+        if (!Enabled().load(std::memory_order_relaxed)) return;
+        static std::atomic<unsigned> nextSlot{0};
+        thread_local unsigned slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % SlotCount;
+        Slots()[slot].count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline uint64_t Total() {
+        uint64_t total = 0;
+        for (unsigned i = 0; i < SlotCount; i++) total += Slots()[i].count.load(std::memory_order_relaxed);
+        return total;
+    }
+}
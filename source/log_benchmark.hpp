@@ -0,0 +1,230 @@
+// spdlog 日志开销基准测试
+// 对同步/异步 logger 和几种常用 sink 的组合，在不同生产者线程数下测量：
+// 吞吐量（条/秒）、生产者单次调用延迟的 p50/p99/p99.9/最大值，以及每条日志的堆分配次数。
+// 每个组合输出一行 JSON，方便脚本对比前后两次运行，发现队列、格式化或 sink 改动带来的退化。
+// 人能读的摘要写到标准错误。
+//
+// 延迟用对数分桶的直方图统计（和 HdrHistogram 同样的思路，误差约 3%），每个线程一个，结束后合并。
+// 堆分配次数由 bench/log_bench_allocs.cpp 中替换的全局 operator new 统计，替换对整个进程生效，
+// 所以基准测试是一个单独的程序，主程序不包含这个头文件。
+//
+// 用法：log_bench [--threads 1,2,4,...] [--sinks null,basic,rotating,ringbuffer,dup_filter]
+//                 [--modes sync,async] [--messages 每组总条数] [--queue 异步队列长度] [--output -|文件路径]
+#pragma once
+#include "latency_histogram.hpp"
+#include "log_bench_allocs.hpp"
+#include <spdlog/spdlog.h>
+#include <spdlog/async.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/dup_filter_sink.h>
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/sinks/ringbuffer_sink.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct LogBenchOptions {
+    std::vector<int> threads = {1, 2, 4, 8, 16, 32, 64};
+    std::vector<std::string> sinks = {"null", "basic", "rotating", "ringbuffer", "dup_filter"};
+    std::vector<std::string> modes = {"sync", "async"};
+    uint64_t messages = 200000;     // 每个组合的总条数，平分给各个线程
+    size_t queueSize = 8192;        // 异步线程池的队列长度（满了阻塞，不丢消息）
+    std::string output = "-";       // "-" 为标准输出
+};
+
+inline std::vector<std::string> SplitList(const char* value) {
+    std::vector<std::string> items;
+    std::string item;
+    for (const char* p = value;; p++) {
+        if (*p == ',' || *p == '\0') {
+            if (!item.empty()) items.push_back(item);
+            item.clear();
+            if (*p == '\0') break;
+        } else {
+            item += *p;
+        }
+    }
+    return items;
+}
+
+// 解析选项，命令行中有 --bench-log 时返回 true
+inline bool ParseLogBenchOptions(int argc, char** argv, LogBenchOptions& options) {
+    bool bench = false;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--bench-log") == 0) {
+            bench = true;
+        } else if (strcmp(arg, "--threads") == 0 && value) {
+            options.threads.clear();
+            for (const std::string& item : SplitList(value)) {
+                int n = atoi(item.c_str());
+                if (n > 0) options.threads.push_back(n);
+            }
+            i++;
+        } else if (strcmp(arg, "--sinks") == 0 && value) {
+            options.sinks = SplitList(value);
+            i++;
+        } else if (strcmp(arg, "--modes") == 0 && value) {
+            options.modes = SplitList(value);
+            i++;
+        } else if (strcmp(arg, "--messages") == 0 && value) {
+            options.messages = strtoull(value, nullptr, 10);
+            i++;
+        } else if (strcmp(arg, "--queue") == 0 && value) {
+            options.queueSize = (size_t)strtoull(value, nullptr, 10);
+            i++;
+        } else if (strcmp(arg, "--output") == 0 && value) {
+            options.output = value;
+            i++;
+        }
+    }
+    return bench;
+}
+
+struct LogBenchResult {
+    std::string mode;
+    std::string sink;
+    int threads = 0;
+    uint64_t messages = 0;
+    double seconds = 0;
+    LatencyHistogram latency;
+    uint64_t allocations = 0;
+};
+
+// 每次运行都新建 sink，文件类 sink 截断重写
+inline spdlog::sink_ptr CreateBenchSink(const std::string& name) {
+    if (name == "null") return std::make_shared<spdlog::sinks::null_sink_mt>();
+    if (name == "basic") return std::make_shared<spdlog::sinks::basic_file_sink_mt>("logs/bench/basic.txt", true);
+    if (name == "rotating") {
+        auto sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>("logs/bench/rotating.txt", 8 * 1024 * 1024, 2);
+        sink->rotate_now();
+        return sink;
+    }
+    if (name == "ringbuffer") return std::make_shared<spdlog::sinks::ringbuffer_sink_mt>(1024);
+    if (name == "dup_filter") {
+        // 连续 8 条内容相同（见 RunLogBenchCase），大部分被过滤掉
+        auto sink = std::make_shared<spdlog::sinks::dup_filter_sink_mt>(std::chrono::seconds(5));
+        sink->add_sink(std::make_shared<spdlog::sinks::null_sink_mt>());
+        return sink;
+    }
+    return nullptr;
+}
+
+inline bool RunLogBenchCase(const LogBenchOptions& options, const std::string& mode, const std::string& sinkName,
+                            int threads, LogBenchResult& result) {
+    spdlog::sink_ptr sink = CreateBenchSink(sinkName);
+    if (!sink) {
+        fprintf(stderr, "未知的 sink: %s\n", sinkName.c_str());
+        return false;
+    }
+    std::shared_ptr<spdlog::details::thread_pool> pool;
+    std::shared_ptr<spdlog::logger> logger;
+    if (mode == "async") {
+        pool = std::make_shared<spdlog::details::thread_pool>(options.queueSize, 1);
+        logger = std::make_shared<spdlog::async_logger>("bench", sink, pool, spdlog::async_overflow_policy::block);
+    } else if (mode == "sync") {
+        logger = std::make_shared<spdlog::logger>("bench", sink);
+    } else {
+        fprintf(stderr, "未知的模式: %s\n", mode.c_str());
+        return false;
+    }
+
+    uint64_t perThread = options.messages / (uint64_t)threads;
+    if (perThread == 0) perThread = 1;
+    std::vector<LatencyHistogram> histograms(threads);
+    std::vector<std::thread> producers;
+    std::atomic<int> ready{0};
+    std::atomic<bool> start{false};
+    for (int t = 0; t < threads; t++) {
+        producers.emplace_back([&, t] {
+            LatencyHistogram& histogram = histograms[t];
+            ready.fetch_add(1);
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            // 相邻两次取时间的差就是一次调用的耗时，每条日志只取一次时间
+            auto last = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < perThread; i++) {
+                logger->info("request {} from {} took {:.3f} ms", i / 8, "client", 1.25);
+                auto now = std::chrono::steady_clock::now();
+                histogram.Record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count());
+                last = now;
+            }
+        });
+    }
+    while (ready.load() < threads) std::this_thread::yield();
+
+    uint64_t allocationsBefore = LogBenchAllocs::Total();
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (std::thread& producer : producers) producer.join();
+    // 异步模式要等工作线程把队列写完：线程池析构时处理完剩余消息才退出
+    logger->flush();
+    logger.reset();
+    pool.reset();
+    auto end = std::chrono::steady_clock::now();
+    uint64_t allocationsAfter = LogBenchAllocs::Total();
+
+    result.mode = mode;
+    result.sink = sinkName;
+    result.threads = threads;
+    result.messages = perThread * (uint64_t)threads;
+    result.seconds = std::chrono::duration<double>(end - begin).count();
+    for (const LatencyHistogram& histogram : histograms) result.latency.Merge(histogram);
+    result.allocations = allocationsAfter - allocationsBefore;
+    return true;
+}
+
+inline int RunLogBench(const LogBenchOptions& options) {
+    FILE* out = stdout;
+    if (options.output != "-") {
+        out = fopen(options.output.c_str(), "w");
+        if (!out) {
+            fprintf(stderr, "无法创建输出文件: %s\n", options.output.c_str());
+            return 1;
+        }
+    }
+
+    int result = 0;
+    LogBenchAllocs::Enabled().store(true);
+    try {
+        fprintf(stderr, "%-6s %-11s %7s %14s %9s %9s %9s %11s %12s\n",
+            "mode", "sink", "threads", "msgs/sec", "p50(ns)", "p99(ns)", "p99.9(ns)", "max(ns)", "allocs/msg");
+        for (const std::string& mode : options.modes) {
+            for (const std::string& sink : options.sinks) {
+                for (int threads : options.threads) {
+                    LogBenchResult r;
+                    if (!RunLogBenchCase(options, mode, sink, threads, r)) {
+                        result = 1;
+                        continue;
+                    }
+                    double rate = r.seconds > 0 ? (double)r.messages / r.seconds : 0;
+                    double allocs = (double)r.allocations / (double)r.messages;
+                    fprintf(out, "{\"mode\":\"%s\",\"sink\":\"%s\",\"threads\":%d,\"messages\":%llu,\"seconds\":%.6f,"
+                        "\"msgs_per_sec\":%.0f,\"p50_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,\"max_ns\":%llu,"
+                        "\"allocs_per_msg\":%.4f}\n",
+                        r.mode.c_str(), r.sink.c_str(), r.threads, (unsigned long long)r.messages, r.seconds, rate,
+                        (unsigned long long)r.latency.Percentile(50), (unsigned long long)r.latency.Percentile(99),
+                        (unsigned long long)r.latency.Percentile(99.9), (unsigned long long)r.latency.Max(), allocs);
+                    fflush(out);
+                    fprintf(stderr, "%-6s %-11s %7d %14.0f %9llu %9llu %9llu %11llu %12.4f\n",
+                        r.mode.c_str(), r.sink.c_str(), r.threads, rate,
+                        (unsigned long long)r.latency.Percentile(50), (unsigned long long)r.latency.Percentile(99),
+                        (unsigned long long)r.latency.Percentile(99.9), (unsigned long long)r.latency.Max(), allocs);
+                }
+            }
+        }
+    } catch (const spdlog::spdlog_ex& ex) {
+        fprintf(stderr, "基准测试失败: %s\n", ex.what());
+        result = 1;
+    }
+    LogBenchAllocs::Enabled().store(false);
+    if (out != stdout) fclose(out);
+    return result;
+}
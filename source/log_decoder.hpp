@@ -0,0 +1,72 @@
+// 二进制日志离线解码
+// binary_file_sink 写的文件里只有调用点编号和原始参数，格式化推迟到这里完成，
+// 按给定的 pattern 还原成和文本日志一样的行。
+//
+// 用法：app --decode-log 输入文件 [输出文件|-] [--pattern "%+"]
+#pragma once
+#include <spdlog/spdlog.h>
+#include <spdlog/details/binary_log_reader.h>
+#include <spdlog/pattern_formatter.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+struct LogDecoderOptions {
+    std::string input;
+    std::string output = "-";   // "-" 为标准输出
+    std::string pattern = "%+"; // 与 spdlog 默认格式一致
+};
+
+// 命令行中有 --decode-log 时返回 true 并解析其余选项
+inline bool ParseLogDecoderOptions(int argc, char** argv, LogDecoderOptions& options) {
+    bool decode = false;
+    bool outputSet = false;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--decode-log") == 0 && value) {
+            decode = true;
+            options.input = value;
+            i++;
+        } else if (strcmp(arg, "--pattern") == 0 && value) {
+            options.pattern = value;
+            i++;
+        } else if (decode && !outputSet && (arg[0] != '-' || arg[1] == '\0')) {
+            options.output = arg;
+            outputSet = true;
+        }
+    }
+    return decode;
+}
+
+inline int RunLogDecoder(const LogDecoderOptions& options) {
+    FILE* out = stdout;
+    if (options.output != "-") {
+        out = fopen(options.output.c_str(), "wb");
+        if (!out) {
+            fprintf(stderr, "无法创建输出文件: %s\n", options.output.c_str());
+            return 1;
+        }
+    }
+
+    int result = 0;
+    uint64_t count = 0;
+    try {
+        spdlog::details::binary_log_reader reader(options.input);
+        spdlog::pattern_formatter formatter(options.pattern);
+        spdlog::details::log_msg msg;
+        spdlog::memory_buf_t line;
+        while (reader.next(msg)) {
+            line.clear();
+            formatter.format(msg, line);
+            fwrite(line.data(), 1, line.size(), out);
+            count++;
+        }
+    } catch (const spdlog::spdlog_ex& ex) {
+        // 文件末尾可能有进程崩溃时没写完的记录，前面已解码的内容仍然保留
+        fprintf(stderr, "解码失败（已输出 %llu 条）: %s\n", (unsigned long long)count, ex.what());
+        result = 1;
+    }
+    if (out != stdout) fclose(out);
+    return result;
+}
@@ -1,11 +1,39 @@
+#ifdef _WIN32
 #include "test_c11.hpp"
+#endif
 #include "test_spdlog.hpp"
+#ifdef _WIN32
 #include "test_imgui.hpp"
+#endif
 #include "test_cpp.hpp"
+#include "headless_exporter.hpp"
+#include "log_decoder.hpp"
+#include "dashboard_render.hpp"
+#include "draw_benchmark.hpp"
 #include <iostream>
 #include <thread>
 #include <chrono>
-int main() {
+int main(int argc, char** argv) {
+    // --decode-log：把二进制日志还原成文本，见 log_decoder.hpp
+    LogDecoderOptions decoderOptions;
+    if (ParseLogDecoderOptions(argc, argv, decoderOptions))
+        return RunLogDecoder(decoderOptions);
+
+    // --bench-draw：ImDrawList 三角化基准测试，见 draw_benchmark.hpp
+    DrawBenchOptions drawBenchOptions;
+    if (ParseDrawBenchOptions(argc, argv, drawBenchOptions))
+        return RunDrawBench(drawBenchOptions);
+
+    // --render：用 CPU 软件光栅化渲染仪表盘，见 dashboard_render.hpp
+    DashboardRenderOptions renderOptions;
+    if (ParseDashboardRenderOptions(argc, argv, renderOptions))
+        return RunDashboardRender(renderOptions);
+
+    // --headless：不创建窗口，只采样并输出，见 headless_exporter.hpp
+    HeadlessOptions options;
+    if (ParseHeadlessOptions(argc, argv, options))
+        return RunHeadless(options);
+
     base_cpp();
     return 0;
-}
\ No newline at end of file
+}
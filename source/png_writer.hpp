@@ -0,0 +1,215 @@
+// PNG 截图写出
+// 只支持 8 位 RGBA。压缩用最简单的 deflate：固定 Huffman 编码 + 哈希链贪心匹配。
+// 界面截图大片同色，压缩后一般只有原始大小的几个百分点，不需要引入 zlib/libpng。
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+class PngWriter {
+public:
+    // rgba：width*height 个像素，每个像素按 R、G、B、A 四个字节存放，行之间没有填充
+    static bool Write(const std::string& path, int width, int height, const unsigned char* rgba) {
+        // 每行前加滤波类型 1（Sub：与左边像素相减），渐变和抗锯齿边缘更容易压缩
+        const size_t stride = (size_t)width * 4;
+        std::vector<unsigned char> raw((stride + 1) * height);
+        for (int y = 0; y < height; y++) {
+            const unsigned char* src = rgba + stride * y;
+            unsigned char* dst = &raw[(stride + 1) * y];
+            dst[0] = 1;
+            for (size_t i = 0; i < stride; i++)
+                dst[1 + i] = (unsigned char)(src[i] - (i >= 4 ? src[i - 4] : 0));
+        }
+
+        std::vector<unsigned char> idat;
+        Deflate(raw, idat);
+
+        unsigned char ihdr[13];
+        PutBE32(ihdr, (uint32_t)width);
+        PutBE32(ihdr + 4, (uint32_t)height);
+        ihdr[8] = 8;   // 位深
+        ihdr[9] = 6;   // RGBA
+        ihdr[10] = ihdr[11] = ihdr[12] = 0;
+
+        FILE* f = fopen(path.c_str(), "wb");
+        if (!f) return false;
+        static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+        bool ok = fwrite(signature, 1, sizeof(signature), f) == sizeof(signature) &&
+                  WriteChunk(f, "IHDR", ihdr, sizeof(ihdr)) &&
+                  WriteChunk(f, "IDAT", idat.data(), idat.size()) &&
+                  WriteChunk(f, "IEND", nullptr, 0);
+        ok = fclose(f) == 0 && ok;
+        return ok;
+    }
+
+private:
+    static void PutBE32(unsigned char* p, uint32_t v) {
+        p[0] = (unsigned char)(v >> 24);
+        p[1] = (unsigned char)(v >> 16);
+        p[2] = (unsigned char)(v >> 8);
+        p[3] = (unsigned char)v;
+    }
+
+    static uint32_t Crc32(uint32_t crc, const unsigned char* data, size_t size) {
+        static uint32_t table[256];
+        static bool ready = false;
+        if (!ready) {
+            for (uint32_t n = 0; n < 256; n++) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; k++) c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                table[n] = c;
+            }
+            ready = true;
+        }
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    static bool WriteChunk(FILE* f, const char* type, const unsigned char* data, size_t size) {
+        unsigned char header[8];
+        PutBE32(header, (uint32_t)size);
+        memcpy(header + 4, type, 4);
+        uint32_t crc = Crc32(Crc32(0, header + 4, 4), data, size);
+        unsigned char trailer[4];
+        PutBE32(trailer, crc);
+        return fwrite(header, 1, 8, f) == 8 &&
+               (size == 0 || fwrite(data, 1, size, f) == size) &&
+               fwrite(trailer, 1, 4, f) == 4;
+    }
+
+    // 按 deflate 的顺序（低位在前）写比特
+    struct BitWriter {
+        std::vector<unsigned char>& out;
+        uint32_t bits = 0;
+        int count = 0;
+
+        explicit BitWriter(std::vector<unsigned char>& out) : out(out) {}
+
+        void Put(uint32_t value, int n) {
+            bits |= value << count;
+            count += n;
+            while (count >= 8) {
+                out.push_back((unsigned char)bits);
+                bits >>= 8;
+                count -= 8;
+            }
+        }
+        // Huffman 码从高位开始写
+        void PutCode(uint32_t code, int n) {
+            uint32_t reversed = 0;
+            for (int i = 0; i < n; i++) reversed |= ((code >> i) & 1) << (n - 1 - i);
+            Put(reversed, n);
+        }
+        void Flush() {
+            if (count > 0) out.push_back((unsigned char)bits);
+            bits = 0;
+            count = 0;
+        }
+    };
+
+    // 固定 Huffman 表中字面量/长度符号的编码
+    static void PutSymbol(BitWriter& bw, int symbol) {
+        if (symbol < 144) bw.PutCode(0x30 + symbol, 8);
+        else if (symbol < 256) bw.PutCode(0x190 + symbol - 144, 9);
+        else if (symbol < 280) bw.PutCode(symbol - 256, 7);
+        else bw.PutCode(0xc0 + symbol - 280, 8);
+    }
+
+    static void PutMatch(BitWriter& bw, int length, int distance) {
+        static const int lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static const int lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                             3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static const int distBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                          257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                          8193, 12289, 16385, 24577 };
+        static const int distExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                           7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+        int l = 28;
+        while (lengthBase[l] > length) l--;
+        PutSymbol(bw, 257 + l);
+        bw.Put((uint32_t)(length - lengthBase[l]), lengthExtra[l]);
+        int d = 29;
+        while (distBase[d] > distance) d--;
+        bw.PutCode((uint32_t)d, 5);
+        bw.Put((uint32_t)(distance - distBase[d]), distExtra[d]);
+    }
+
+    // zlib 格式：头、一个使用固定 Huffman 表的 deflate 块、Adler-32
+    static void Deflate(const std::vector<unsigned char>& in, std::vector<unsigned char>& out) {
+        const int windowSize = 32768;
+        const int hashBits = 15;
+        const int maxChain = 32;
+        const int minMatch = 3, maxMatch = 258;
+        const size_t n = in.size();
+
+        out.clear();
+        out.reserve(n / 8 + 64);
+        out.push_back(0x78);
+        out.push_back(0x01);
+        BitWriter bw(out);
+        bw.Put(1, 1);   // BFINAL
+        bw.Put(1, 2);   // BTYPE = 01，固定 Huffman
+
+        // head：每个哈希值最近出现的位置 + 1；prev：同一哈希值的上一个位置 + 1（按窗口取模）
+        std::vector<int> head((size_t)1 << hashBits, 0);
+        std::vector<int> prev(windowSize, 0);
+        auto hashAt = [&](size_t i) {
+            uint32_t v = (uint32_t)in[i] | (uint32_t)in[i + 1] << 8 | (uint32_t)in[i + 2] << 16;
+            return (v * 2654435761u) >> (32 - hashBits);
+        };
+        auto insert = [&](size_t i) {
+            uint32_t h = hashAt(i);
+            prev[i % windowSize] = head[h];
+            head[h] = (int)i + 1;
+        };
+
+        size_t i = 0;
+        while (i < n) {
+            int bestLength = 0, bestDistance = 0;
+            if (i + minMatch <= n) {
+                const int limit = (int)(n - i < (size_t)maxMatch ? n - i : (size_t)maxMatch);
+                int candidate = head[hashAt(i)];
+                for (int chain = 0; candidate > 0 && chain < maxChain; chain++) {
+                    size_t pos = (size_t)candidate - 1;
+                    if (i - pos > (size_t)windowSize - 1) break;
+                    int length = 0;
+                    while (length < limit && in[pos + length] == in[i + length]) length++;
+                    if (length > bestLength) {
+                        bestLength = length;
+                        bestDistance = (int)(i - pos);
+                        if (length == limit) break;
+                    }
+                    int next = prev[pos % windowSize];
+                    if (next >= candidate) break;   // 槽位已被更新的位置覆盖
+                    candidate = next;
+                }
+            }
+
+            if (bestLength >= minMatch) {
+                PutMatch(bw, bestLength, bestDistance);
+                for (int k = 0; k < bestLength; k++, i++) {
+                    if (i + minMatch <= n) insert(i);
+                }
+            } else {
+                PutSymbol(bw, in[i]);
+                if (i + minMatch <= n) insert(i);
+                i++;
+            }
+        }
+        PutSymbol(bw, 256);   // 块结束
+        bw.Flush();
+
+        uint32_t a = 1, b = 0;
+        for (size_t k = 0; k < n; k++) {
+            a = (a + in[k]) % 65521;
+            b = (b + a) % 65521;
+        }
+        unsigned char adler[4];
+        PutBE32(adler, b << 16 | a);
+        out.insert(out.end(), adler, adler + 4);
+    }
+};
@@ -0,0 +1,236 @@
+// 增量维护的进程表
+// 以 PID 为键保存每一行，每次刷新只更新发生变化的行；进程名和状态字符串统一驻留，行里只存编号。
+// 排序结果持久保存，刷新后只把位置可能变化的行重新插入，变化的行很多时才整体重排
+#pragma once
+#include "system_collector.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 字符串驻留表，同一个字符串只保存一份
+class StringPool {
+public:
+    uint32_t Intern(const std::string& text) {
+        auto it = ids.find(text);
+        if (it != ids.end()) return it->second;
+        uint32_t id = (uint32_t)strings.size();
+        strings.push_back(text);
+        ids.emplace(text, id);
+        return id;
+    }
+
+    const std::string& Get(uint32_t id) const { return strings[id]; }
+
+private:
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> ids;
+};
+
+// 进程表的列，和系统监控页面表格的列顺序一致
+enum ProcessColumn {
+    ProcessColumn_Name,
+    ProcessColumn_Pid,
+    ProcessColumn_Cpu,
+    ProcessColumn_Memory,
+    ProcessColumn_Status,
+    ProcessColumn_COUNT
+};
+
+struct ProcessSortKey {
+    int column = ProcessColumn_Name;
+    bool ascending = true;
+};
+
+struct ProcessRow {
+    uint32_t pid = 0;
+    uint32_t nameId = 0;
+    uint32_t statusId = 0;
+    double cpuUsage = 0.0;
+    size_t memoryUsage = 0;  // MB
+    uint32_t version = 0;    // 行内容每变化一次加一，便于调用方缓存格式化结果
+    uint64_t generation = 0; // 最近一次出现在采样结果中的刷新轮次
+    bool alive = false;
+};
+
+class ProcessTable {
+public:
+    // 用一次完整的采样结果更新表格
+    void Update(const std::vector<ProcessInfo>& processes) {
+        ++generation;
+        touched.clear();
+        size_t seen = 0;
+        size_t seenExisting = 0;  // 本轮出现的旧行数量
+
+        for (const ProcessInfo& info : processes) {
+            auto inserted = rowByPid.emplace(info.pid, 0u);
+            ProcessRow* row;
+            if (inserted.second) {
+                uint32_t index = AllocateRow();
+                inserted.first->second = index;
+                row = &rows[index];
+                row->pid = info.pid;
+                row->nameId = names.Intern(info.name);
+                row->statusId = names.Intern(info.status);
+                row->cpuUsage = info.cpuUsage;
+                row->memoryUsage = info.memoryUsage;
+                row->version++;
+                touched.push_back(index);
+                order.push_back(index);
+            } else {
+                uint32_t index = inserted.first->second;
+                row = &rows[index];
+                unsigned changed = 0;
+                if (names.Get(row->nameId) != info.name) {
+                    row->nameId = names.Intern(info.name);
+                    changed |= 1u << ProcessColumn_Name;
+                }
+                if (names.Get(row->statusId) != info.status) {
+                    row->statusId = names.Intern(info.status);
+                    changed |= 1u << ProcessColumn_Status;
+                }
+                if (row->cpuUsage != info.cpuUsage) {
+                    row->cpuUsage = info.cpuUsage;
+                    changed |= 1u << ProcessColumn_Cpu;
+                }
+                if (row->memoryUsage != info.memoryUsage) {
+                    row->memoryUsage = info.memoryUsage;
+                    changed |= 1u << ProcessColumn_Memory;
+                }
+                if (changed) {
+                    row->version++;
+                    if (changed & sortedColumns) touched.push_back(index);
+                }
+            }
+            if (row->generation != generation) {
+                if (!inserted.second) seenExisting++;
+                row->generation = generation;
+                seen++;
+            }
+        }
+
+        // 只有旧行没有全部出现时才需要扫描退出的进程
+        bool removed = false;
+        if (seenExisting != liveCount) {
+            for (uint32_t index = 0; index < rows.size(); index++) {
+                ProcessRow& row = rows[index];
+                if (row.alive && row.generation != generation) {
+                    rowByPid.erase(row.pid);
+                    row.alive = false;
+                    freeRows.push_back(index);
+                    removed = true;
+                }
+            }
+        }
+        liveCount = seen;
+
+        RepairOrder(removed);
+    }
+
+    // 修改排序规则，会触发一次整体排序
+    void SetSortKeys(const std::vector<ProcessSortKey>& keys) {
+        sortKeys = keys;
+        sortedColumns = 0;
+        for (const ProcessSortKey& key : sortKeys) sortedColumns |= 1u << key.column;
+        SortAll();
+    }
+
+    size_t Size() const { return order.size(); }
+
+    // 按当前排序规则的第 index 行
+    const ProcessRow& SortedRow(size_t index) const { return rows[order[index]]; }
+
+    // 第 index 行在内部行数组中的位置，行号在进程存活期间不变，可以作为调用方缓存的下标
+    uint32_t SortedRowIndex(size_t index) const { return order[index]; }
+    size_t RowCapacity() const { return rows.size(); }
+
+    const std::string& Name(const ProcessRow& row) const { return names.Get(row.nameId); }
+    const std::string& Status(const ProcessRow& row) const { return names.Get(row.statusId); }
+
+private:
+    std::vector<ProcessRow> rows;
+    std::vector<uint32_t> freeRows;
+    std::unordered_map<uint32_t, uint32_t> rowByPid;
+    std::vector<uint32_t> order;    // 排好序的行号
+    std::vector<uint32_t> touched;  // 本轮新增或排序键发生变化的行
+    std::vector<uint8_t> repositioning;
+    StringPool names;
+    std::vector<ProcessSortKey> sortKeys = { ProcessSortKey() };
+    unsigned sortedColumns = 1u << ProcessColumn_Name;
+    uint64_t generation = 0;
+    size_t liveCount = 0;
+
+    uint32_t AllocateRow() {
+        uint32_t index;
+        if (!freeRows.empty()) {
+            index = freeRows.back();
+            freeRows.pop_back();
+        } else {
+            index = (uint32_t)rows.size();
+            rows.emplace_back();
+        }
+        ProcessRow& row = rows[index];
+        uint32_t version = row.version;
+        row = ProcessRow();
+        row.version = version;  // 复用的行号继续递增版本号，避免调用方误用旧的缓存
+        row.alive = true;
+        return index;
+    }
+
+    bool Less(uint32_t a, uint32_t b) const {
+        const ProcessRow& ra = rows[a];
+        const ProcessRow& rb = rows[b];
+        for (const ProcessSortKey& key : sortKeys) {
+            int delta = 0;
+            switch (key.column) {
+                case ProcessColumn_Name: delta = names.Get(ra.nameId).compare(names.Get(rb.nameId)); break;
+                case ProcessColumn_Pid: delta = (ra.pid > rb.pid) - (ra.pid < rb.pid); break;
+                case ProcessColumn_Cpu: delta = (ra.cpuUsage > rb.cpuUsage) - (ra.cpuUsage < rb.cpuUsage); break;
+                case ProcessColumn_Memory: delta = (ra.memoryUsage > rb.memoryUsage) - (ra.memoryUsage < rb.memoryUsage); break;
+                case ProcessColumn_Status: delta = names.Get(ra.statusId).compare(names.Get(rb.statusId)); break;
+            }
+            if (delta != 0)
+                return key.ascending ? delta < 0 : delta > 0;
+        }
+        // PID 唯一，保证是严格全序，二分插入时位置确定
+        return ra.pid < rb.pid;
+    }
+
+    void SortAll() {
+        std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) { return Less(a, b); });
+    }
+
+    void RepairOrder(bool removed) {
+        if (touched.empty()) {
+            if (removed) RemoveFromOrder();
+            return;
+        }
+
+        // 变化的行太多时，局部修复不如整体排序
+        if (touched.size() * 8 > order.size()) {
+            if (removed) RemoveFromOrder();
+            SortAll();
+            return;
+        }
+
+        // 先把需要重新定位的行（包括刚加在末尾的新行）和退出的行一起移除，再逐个二分插入
+        repositioning.resize(rows.size(), 0);
+        for (uint32_t index : touched) repositioning[index] = 1;
+        order.erase(std::remove_if(order.begin(), order.end(), [this](uint32_t index) {
+            return !rows[index].alive || repositioning[index] != 0;
+        }), order.end());
+        for (uint32_t index : touched) {
+            repositioning[index] = 0;
+            auto position = std::upper_bound(order.begin(), order.end(), index,
+                [this](uint32_t a, uint32_t b) { return Less(a, b); });
+            order.insert(position, index);
+        }
+    }
+
+    void RemoveFromOrder() {
+        order.erase(std::remove_if(order.begin(), order.end(), [this](uint32_t index) {
+            return !rows[index].alive;
+        }), order.end());
+    }
+};
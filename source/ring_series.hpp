@@ -0,0 +1,152 @@
+// 固定容量的环形时间序列
+// 写入是 O(1) 的覆盖写，读取通过 View 直接访问底层存储，不做任何复制。
+// 支持一个写线程和若干读线程：写端写完一个元素后才用 release 发布计数，
+// 读端用 acquire 读计数得到一段已发布的区间。存储区比容量多出 GUARD 个槽位，
+// 因此只要读端在写端再写入 GUARD 个样本之前用完 View，读写就不会落在同一个槽位上。
+// 读端落后太多时，读到的元素可能正被覆盖：像 seqlock 一样，读完之后调用 View::Valid() 重新检查计数，
+// 返回 false 时丢弃读到的结果，重新取 View
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+
+template <typename T>
+class RingSeries {
+public:
+    static const size_t GUARD = 64;
+
+    // 某一时刻序列内容的只读视图，逻辑下标 0 是最旧的元素
+    // 物理上最多分成两段连续内存，可以通过 FirstPart()/SecondPart() 直接批量处理
+    class View {
+    public:
+        View() = default;
+        View(const T* data, size_t storageSize, size_t first, size_t length,
+             const std::atomic<uint64_t>* written = nullptr, uint64_t oldest = 0)
+            : data(data), storageSize(storageSize), first(first), length(length), written(written), oldest(oldest) {}
+
+        size_t size() const { return length; }
+        bool empty() const { return length == 0; }
+
+        T operator[](size_t index) const {
+            size_t position = first + index;
+            if (position >= storageSize) position -= storageSize;
+            return data[position];
+        }
+
+        T back() const { return (*this)[length - 1]; }
+
+        // 只保留最新的 count 个元素
+        View Last(size_t count) const {
+            if (count >= length) return *this;
+            size_t position = first + (length - count);
+            if (position >= storageSize) position -= storageSize;
+            return View(data, storageSize, position, count, written, oldest + (length - count));
+        }
+
+        // 在读完元素之后调用：写端还没有开始覆盖视图中最旧的元素时返回 true，
+        // 此前通过这个视图读到的内容都是完整的；返回 false 时读到的内容可能被撕裂，需要丢弃
+        bool Valid() const {
+            if (!written) return true;
+            std::atomic_thread_fence(std::memory_order_acquire);   // 之前的读取不会被重排到重新读计数之后
+            // 写端正在写逻辑位置 now（还没有发布），它和 oldest 落在同一个槽位时视图失效
+            uint64_t now = written->load(std::memory_order_relaxed);
+            return now - oldest < storageSize;
+        }
+
+        const T* FirstPart(size_t* count) const {
+            *count = (first + length <= storageSize) ? length : storageSize - first;
+            return data + first;
+        }
+
+        const T* SecondPart(size_t* count) const {
+            size_t firstCount;
+            FirstPart(&firstCount);
+            *count = length - firstCount;
+            return data;
+        }
+
+        class iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = T;
+
+            iterator(const View* view, size_t index) : view(view), index(index) {}
+            T operator*() const { return (*view)[index]; }
+            T operator[](difference_type n) const { return (*view)[index + n]; }
+            iterator& operator++() { ++index; return *this; }
+            iterator operator++(int) { iterator old = *this; ++index; return old; }
+            iterator& operator--() { --index; return *this; }
+            iterator operator--(int) { iterator old = *this; --index; return old; }
+            iterator& operator+=(difference_type n) { index += n; return *this; }
+            iterator& operator-=(difference_type n) { index -= n; return *this; }
+            iterator operator+(difference_type n) const { return iterator(view, index + n); }
+            iterator operator-(difference_type n) const { return iterator(view, index - n); }
+            difference_type operator-(const iterator& other) const { return (difference_type)index - (difference_type)other.index; }
+            bool operator==(const iterator& other) const { return index == other.index; }
+            bool operator!=(const iterator& other) const { return index != other.index; }
+            bool operator<(const iterator& other) const { return index < other.index; }
+
+        private:
+            const View* view;
+            size_t index;
+        };
+
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, length); }
+
+        // 供 ImGui::PlotLines/PlotHistogram 的 values_getter 使用，data 指向 View
+        static float Getter(void* data, int index) {
+            return (float)(*(const View*)data)[(size_t)index];
+        }
+
+    private:
+        const T* data = nullptr;
+        size_t storageSize = 0;
+        size_t first = 0;
+        size_t length = 0;
+        const std::atomic<uint64_t>* written = nullptr;
+        uint64_t oldest = 0;    // 第 0 个元素的逻辑位置（累计写入序号）
+    };
+
+    explicit RingSeries(size_t capacity)
+        : capacity(capacity), storageSize(capacity + GUARD), storage(new T[capacity + GUARD]()) {}
+
+    RingSeries(const RingSeries&) = delete;
+    RingSeries& operator=(const RingSeries&) = delete;
+
+    // 写端：追加一个样本，超过容量时覆盖最旧的样本
+    void Push(T value) {
+        uint64_t count = written.load(std::memory_order_relaxed);
+        storage[count % storageSize] = value;
+        written.store(count + 1, std::memory_order_release);
+    }
+
+    size_t Capacity() const { return capacity; }
+
+    // 当前保存的样本数
+    size_t Size() const {
+        uint64_t count = written.load(std::memory_order_acquire);
+        return count < capacity ? (size_t)count : capacity;
+    }
+
+    // 累计写入过的样本数
+    uint64_t TotalCount() const { return written.load(std::memory_order_acquire); }
+
+    // 读端：取当前已发布内容的视图
+    View GetView() const {
+        uint64_t count = written.load(std::memory_order_acquire);
+        size_t length = count < capacity ? (size_t)count : capacity;
+        return View(storage.get(), storageSize, (size_t)((count - length) % storageSize), length, &written, count - length);
+    }
+
+private:
+    const size_t capacity;
+    const size_t storageSize;
+    std::unique_ptr<T[]> storage;
+    std::atomic<uint64_t> written{0};
+};
@@ -0,0 +1,967 @@
+// 采样录制与回放
+// 录制文件按块保存，每块最多 FRAMES_PER_BLOCK 帧，块内按列存放：同一个字段在所有帧里的值连续存放，
+// 每个值只记录与上一帧的差（时间记录差的差），差为 0 的连续值用游程编码，所以大多数不变的字段几乎不占空间。
+// 进程列表按 PID 排序后只记录相对上一帧退出和新增的 PID，名字和状态用块内的字符串表编号表示。
+// 每块都可以独立解码，文件末尾是块索引，回放时 mmap 整个文件，按时间二分查找到块，再在块内顺序解码。
+//
+// 浮点数按固定精度量化：百分比 0.01%，温度 0.01°C，运行时间 1ms，空间 1MB，磁盘速度 0.001MB/s，网络速度 1B/s。
+// 整数按小端序直接写入（Windows/x86/ARM 都是小端）。
+//
+// 文件结构：
+//   文件头    "LCPMREC1" + u32 版本 + u32 保留
+//   块        BlockHeader + 字符串表 + 各列数据
+//   ...
+//   块索引    IndexEntry × 块数
+//   文件尾    Trailer，录制异常中断时没有索引和文件尾，打开时扫描块头重建索引
+#pragma once
+#include "system_collector.hpp"
+#include "system_sampler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// 录制文件中的列，顺序即块内的存放顺序
+enum RecordingColumn {
+    RecordingColumn_Time,               // ms，第一帧为绝对值，第二帧为差，之后为差的差
+    RecordingColumn_System,             // SystemInfo 的标量字段，每帧 SYSTEM_FIELD_COUNT 个
+    RecordingColumn_CoreCount,
+    RecordingColumn_Core,
+    RecordingColumn_ProcessRemovedCount,
+    RecordingColumn_ProcessRemovedPid,  // 帧内按 PID 递增，记录与前一个的差
+    RecordingColumn_ProcessAddedCount,
+    RecordingColumn_ProcessAddedPid,
+    RecordingColumn_ProcessName,        // 0 表示与上一帧相同，否则为字符串编号 + 1
+    RecordingColumn_ProcessStatus,
+    RecordingColumn_ProcessCpu,
+    RecordingColumn_ProcessMemory,
+    RecordingColumn_NetworkCount,
+    RecordingColumn_NetworkName,
+    RecordingColumn_NetworkValue,       // 每个适配器 NETWORK_FIELD_COUNT 个
+    RecordingColumn_DiskCount,
+    RecordingColumn_DiskName,
+    RecordingColumn_DiskValue,          // 每个磁盘 DISK_FIELD_COUNT 个
+    RecordingColumn_COUNT
+};
+
+// 按列写入的整数序列：zigzag 变长整数，连续的 0 写成 0 + (个数 - 1)
+class ColumnWriter {
+public:
+    void Put(int64_t value) {
+        if (value == 0) {
+            zeroRun++;
+            return;
+        }
+        FlushZeros();
+        PutVarint(bytes, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+    }
+
+    // 块结束时调用，把缓冲的游程写出
+    const std::vector<uint8_t>& Finish() {
+        FlushZeros();
+        return bytes;
+    }
+
+    void Clear() {
+        bytes.clear();
+        zeroRun = 0;
+    }
+
+    static void PutVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((uint8_t)value);
+    }
+
+private:
+    std::vector<uint8_t> bytes;
+    uint64_t zeroRun = 0;
+
+    void FlushZeros() {
+        if (zeroRun == 0) return;
+        bytes.push_back(0);
+        PutVarint(bytes, zeroRun - 1);
+        zeroRun = 0;
+    }
+};
+
+// 读取 ColumnWriter 写出的数据，越界时 ok 置为 false 并返回 0
+class ColumnReader {
+public:
+    ColumnReader() = default;
+    ColumnReader(const uint8_t* begin, const uint8_t* end) : p(begin), end(end) {}
+
+    int64_t Get() {
+        if (zeroRun > 0) {
+            zeroRun--;
+            return 0;
+        }
+        uint64_t value = GetVarint(p, end, ok);
+        if (value == 0) {
+            zeroRun = GetVarint(p, end, ok);
+            return 0;
+        }
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+
+    bool ok = true;
+
+    static uint64_t GetVarint(const uint8_t*& p, const uint8_t* end, bool& ok) {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p >= end) {
+                ok = false;
+                return 0;
+            }
+            uint8_t byte = *p++;
+            value |= (uint64_t)(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) return value;
+        }
+        ok = false;
+        return 0;
+    }
+
+private:
+    const uint8_t* p = nullptr;
+    const uint8_t* end = nullptr;
+    uint64_t zeroRun = 0;
+};
+
+// 录制文件的公共定义
+struct RecordingFormat {
+    static const uint32_t VERSION = 1;
+    static const uint32_t FRAMES_PER_BLOCK = 256;
+    static const uint32_t BLOCK_MAGIC = 0x314b4c42;  // "BLK1"
+    static const int SYSTEM_FIELD_COUNT = 9;
+    static const int NETWORK_FIELD_COUNT = 4;
+    static const int DISK_FIELD_COUNT = 5;
+    static const int MAX_FIELD_COUNT = 5;
+
+    static const char* FileMagic() { return "LCPMREC1"; }
+    static const char* IndexMagic() { return "LCPMIDX1"; }
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    struct BlockHeader {
+        uint32_t magic;
+        uint32_t payloadSize;
+        uint32_t frameCount;
+        uint32_t reserved;
+        int64_t firstTime;  // ms，Unix 时间
+        int64_t lastTime;
+    };
+
+    struct IndexEntry {
+        int64_t firstTime;
+        int64_t lastTime;
+        uint64_t offset;      // BlockHeader 在文件中的位置
+        uint64_t firstFrame;  // 块内第一帧在整个录制中的序号
+    };
+
+    struct Trailer {
+        uint64_t indexOffset;
+        uint64_t blockCount;
+        uint64_t frameCount;
+        char magic[8];
+    };
+
+    // 按 PID 排序后的进程，编码和解码共用
+    struct Process {
+        uint32_t pid;
+        uint32_t nameId;
+        uint32_t statusId;
+        int64_t cpu;
+        int64_t memory;
+    };
+
+    // 网络适配器或磁盘，按出现顺序与上一帧同一位置的行比较
+    struct Row {
+        uint32_t nameId;
+        int64_t values[MAX_FIELD_COUNT];
+    };
+
+    static int64_t Fixed(double value, double scale) { return (int64_t)std::llround(value * scale); }
+
+    static void SystemToFields(const SystemInfo& info, int64_t* fields) {
+        fields[0] = Fixed(info.cpuUsage, 100.0);
+        fields[1] = Fixed(info.memoryUsage, 100.0);
+        fields[2] = Fixed(info.diskUsage, 100.0);
+        fields[3] = Fixed(info.systemUptime, 3600.0 * 1000.0);
+        fields[4] = Fixed(info.cpuTemperature, 100.0);
+        fields[5] = (int64_t)info.networkReceived;
+        fields[6] = (int64_t)info.networkSent;
+        fields[7] = Fixed(info.diskReadSpeed, 1000.0);
+        fields[8] = Fixed(info.diskWriteSpeed, 1000.0);
+    }
+
+    static void FieldsToSystem(const int64_t* fields, SystemInfo& info) {
+        info.cpuUsage = fields[0] / 100.0;
+        info.memoryUsage = fields[1] / 100.0;
+        info.diskUsage = fields[2] / 100.0;
+        info.systemUptime = fields[3] / (3600.0 * 1000.0);
+        info.cpuTemperature = fields[4] / 100.0;
+        info.networkReceived = (uint64_t)fields[5];
+        info.networkSent = (uint64_t)fields[6];
+        info.diskReadSpeed = fields[7] / 1000.0;
+        info.diskWriteSpeed = fields[8] / 1000.0;
+    }
+
+    static void NetworkToRow(const NetworkInfo& info, Row& row) {
+        row.values[0] = (int64_t)info.bytesReceived;
+        row.values[1] = (int64_t)info.bytesSent;
+        row.values[2] = Fixed(info.downloadSpeed, 1.0);
+        row.values[3] = Fixed(info.uploadSpeed, 1.0);
+    }
+
+    static void RowToNetwork(const Row& row, NetworkInfo& info) {
+        info.bytesReceived = (uint64_t)row.values[0];
+        info.bytesSent = (uint64_t)row.values[1];
+        info.downloadSpeed = (double)row.values[2];
+        info.uploadSpeed = (double)row.values[3];
+    }
+
+    static void DiskToRow(const DiskInfo& info, Row& row) {
+        row.values[0] = Fixed(info.totalSpace, 1024.0);
+        row.values[1] = Fixed(info.usedSpace, 1024.0);
+        row.values[2] = Fixed(info.freeSpace, 1024.0);
+        row.values[3] = Fixed(info.readSpeed, 1000.0);
+        row.values[4] = Fixed(info.writeSpeed, 1000.0);
+    }
+
+    static void RowToDisk(const Row& row, DiskInfo& info) {
+        info.totalSpace = row.values[0] / 1024.0;
+        info.usedSpace = row.values[1] / 1024.0;
+        info.freeSpace = row.values[2] / 1024.0;
+        info.readSpeed = row.values[3] / 1000.0;
+        info.writeSpeed = row.values[4] / 1000.0;
+    }
+};
+
+// 录制器：每次 Append() 把一帧追加到当前块的各列中，块满时写入文件
+// 写满的块立即 fflush，进程崩溃最多丢失当前块；Close() 写出剩余的块和索引。
+// 任何一次写入失败（磁盘满、I/O 错误）都立即停止录制并关闭文件，不再写索引：
+// 文件里只剩完整写入的块，回放时按块头重建索引，Error() 返回失败原因
+class SnapshotRecorder {
+public:
+    SnapshotRecorder() = default;
+    ~SnapshotRecorder() { Close(); }
+
+    SnapshotRecorder(const SnapshotRecorder&) = delete;
+    SnapshotRecorder& operator=(const SnapshotRecorder&) = delete;
+
+    bool Open(const std::string& path) {
+        Close();
+        file = fopen(path.c_str(), "wb");
+        if (!file) return false;
+        RecordingFormat::FileHeader header;
+        memcpy(header.magic, RecordingFormat::FileMagic(), 8);
+        header.version = RecordingFormat::VERSION;
+        header.reserved = 0;
+        error.clear();
+        offset = 0;
+        frameCount = 0;
+        index.clear();
+        ResetBlock();
+        return Write(&header, sizeof(header)) && Flush();
+    }
+
+    bool IsOpen() const { return file != nullptr; }
+
+    // 最近一次写入失败的原因，没有失败时为空
+    const std::string& Error() const { return error; }
+
+    uint64_t FrameCount() const { return frameCount; }
+
+    // time 为 Unix 时间（秒），需要单调不减。写入失败时返回 false，录制随之停止
+    bool Append(const SystemSnapshot& snapshot, double time) {
+        if (!file) return false;
+        int64_t timeMs = (int64_t)std::llround(time * 1000.0);
+        if (blockFrames == 0) blockFirstTime = timeMs;
+        blockLastTime = timeMs;
+
+        // 时间：差的差，固定间隔采样时基本都是 0
+        int64_t delta = blockFrames == 0 ? 0 : timeMs - lastTime;
+        columns[RecordingColumn_Time].Put(blockFrames == 0 ? timeMs : blockFrames == 1 ? delta : delta - lastDelta);
+        lastDelta = delta;
+        lastTime = timeMs;
+
+        int64_t fields[RecordingFormat::SYSTEM_FIELD_COUNT];
+        RecordingFormat::SystemToFields(snapshot.system, fields);
+        for (int i = 0; i < RecordingFormat::SYSTEM_FIELD_COUNT; i++) {
+            columns[RecordingColumn_System].Put(fields[i] - systemFields[i]);
+            systemFields[i] = fields[i];
+        }
+
+        const std::vector<double>& cores = snapshot.system.coreUsage;
+        columns[RecordingColumn_CoreCount].Put((int64_t)cores.size() - (int64_t)coreValues.size());
+        coreValues.resize(cores.size(), 0);
+        for (size_t i = 0; i < cores.size(); i++) {
+            int64_t value = RecordingFormat::Fixed(cores[i], 100.0);
+            columns[RecordingColumn_Core].Put(value - coreValues[i]);
+            coreValues[i] = value;
+        }
+
+        EncodeProcesses(snapshot.processes);
+
+        rows.resize(snapshot.networks.size());
+        for (size_t i = 0; i < snapshot.networks.size(); i++) {
+            rows[i].nameId = Intern(snapshot.networks[i].adapterName);
+            RecordingFormat::NetworkToRow(snapshot.networks[i], rows[i]);
+        }
+        EncodeRows(rows, networkRows, RecordingColumn_NetworkCount, RecordingFormat::NETWORK_FIELD_COUNT);
+
+        rows.resize(snapshot.disks.size());
+        for (size_t i = 0; i < snapshot.disks.size(); i++) {
+            rows[i].nameId = Intern(snapshot.disks[i].driveLetter);
+            RecordingFormat::DiskToRow(snapshot.disks[i], rows[i]);
+        }
+        EncodeRows(rows, diskRows, RecordingColumn_DiskCount, RecordingFormat::DISK_FIELD_COUNT);
+
+        frameCount++;
+        if (++blockFrames == RecordingFormat::FRAMES_PER_BLOCK) return WriteBlock();
+        return true;
+    }
+
+    // 写出剩余的块和索引，写入失败时返回 false
+    bool Close() {
+        if (!file) return error.empty();
+        if (blockFrames > 0 && !WriteBlock()) return false;
+
+        RecordingFormat::Trailer trailer;
+        trailer.indexOffset = offset;
+        trailer.blockCount = index.size();
+        trailer.frameCount = frameCount;
+        memcpy(trailer.magic, RecordingFormat::IndexMagic(), 8);
+        if (!Write(index.data(), index.size() * sizeof(RecordingFormat::IndexEntry)) || !Write(&trailer, sizeof(trailer)))
+            return false;
+        FILE* closing = file;
+        file = nullptr;
+        if (fclose(closing) != 0) {
+            error = strerror(errno);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    FILE* file = nullptr;
+    std::string error;
+    uint64_t offset = 0;
+    uint64_t frameCount = 0;
+    std::vector<RecordingFormat::IndexEntry> index;
+
+    // 当前块的状态，每块开始时清空，保证每块可以独立解码
+    ColumnWriter columns[RecordingColumn_COUNT];
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> stringIds;
+    uint32_t blockFrames = 0;
+    int64_t blockFirstTime = 0;
+    int64_t blockLastTime = 0;
+    int64_t lastTime = 0;
+    int64_t lastDelta = 0;
+    int64_t systemFields[RecordingFormat::SYSTEM_FIELD_COUNT];
+    std::vector<int64_t> coreValues;
+    std::vector<RecordingFormat::Process> processes;
+    std::vector<RecordingFormat::Process> previousProcesses;
+    std::vector<RecordingFormat::Row> rows;
+    std::vector<RecordingFormat::Row> networkRows;
+    std::vector<RecordingFormat::Row> diskRows;
+    std::vector<uint8_t> payload;
+
+    void ResetBlock() {
+        for (ColumnWriter& column : columns) column.Clear();
+        strings.clear();
+        stringIds.clear();
+        blockFrames = 0;
+        lastTime = lastDelta = 0;
+        memset(systemFields, 0, sizeof(systemFields));
+        coreValues.clear();
+        previousProcesses.clear();
+        networkRows.clear();
+        diskRows.clear();
+    }
+
+    uint32_t Intern(const std::string& text) {
+        auto it = stringIds.find(text);
+        if (it != stringIds.end()) return it->second;
+        uint32_t id = (uint32_t)strings.size();
+        strings.push_back(text);
+        stringIds.emplace(text, id);
+        return id;
+    }
+
+    void EncodeProcesses(const std::vector<ProcessInfo>& infos) {
+        processes.resize(infos.size());
+        for (size_t i = 0; i < infos.size(); i++) {
+            RecordingFormat::Process& process = processes[i];
+            process.pid = infos[i].pid;
+            process.nameId = Intern(infos[i].name);
+            process.statusId = Intern(infos[i].status);
+            process.cpu = RecordingFormat::Fixed(infos[i].cpuUsage, 100.0);
+            process.memory = (int64_t)infos[i].memoryUsage;
+        }
+        std::sort(processes.begin(), processes.end(),
+            [](const RecordingFormat::Process& a, const RecordingFormat::Process& b) { return a.pid < b.pid; });
+
+        // 与上一帧比较，分别写出退出和新增的 PID
+        ColumnWriter& removedPids = columns[RecordingColumn_ProcessRemovedPid];
+        ColumnWriter& addedPids = columns[RecordingColumn_ProcessAddedPid];
+        int64_t removedCount = 0, addedCount = 0;
+        uint32_t lastRemoved = 0, lastAdded = 0;
+        size_t i = 0, j = 0;
+        while (i < previousProcesses.size() || j < processes.size()) {
+            if (j == processes.size() || (i < previousProcesses.size() && previousProcesses[i].pid < processes[j].pid)) {
+                removedPids.Put((int64_t)previousProcesses[i].pid - lastRemoved);
+                lastRemoved = previousProcesses[i++].pid;
+                removedCount++;
+            } else if (i == previousProcesses.size() || processes[j].pid < previousProcesses[i].pid) {
+                addedPids.Put((int64_t)processes[j].pid - lastAdded);
+                lastAdded = processes[j++].pid;
+                addedCount++;
+            } else {
+                i++;
+                j++;
+            }
+        }
+        columns[RecordingColumn_ProcessRemovedCount].Put(removedCount);
+        columns[RecordingColumn_ProcessAddedCount].Put(addedCount);
+
+        // 按 PID 顺序写出各字段，已有的进程记录与上一帧的差
+        i = 0;
+        for (const RecordingFormat::Process& process : processes) {
+            while (i < previousProcesses.size() && previousProcesses[i].pid < process.pid) i++;
+            const RecordingFormat::Process* previous =
+                (i < previousProcesses.size() && previousProcesses[i].pid == process.pid) ? &previousProcesses[i] : nullptr;
+            columns[RecordingColumn_ProcessName].Put(previous && previous->nameId == process.nameId ? 0 : process.nameId + 1);
+            columns[RecordingColumn_ProcessStatus].Put(previous && previous->statusId == process.statusId ? 0 : process.statusId + 1);
+            columns[RecordingColumn_ProcessCpu].Put(process.cpu - (previous ? previous->cpu : 0));
+            columns[RecordingColumn_ProcessMemory].Put(process.memory - (previous ? previous->memory : 0));
+        }
+        previousProcesses.swap(processes);
+    }
+
+    // countColumn 之后依次是名字列和数值列
+    void EncodeRows(const std::vector<RecordingFormat::Row>& current, std::vector<RecordingFormat::Row>& previous,
+                    int countColumn, int fieldCount) {
+        columns[countColumn].Put((int64_t)current.size() - (int64_t)previous.size());
+        for (size_t i = 0; i < current.size(); i++) {
+            bool same = i < previous.size() && previous[i].nameId == current[i].nameId;
+            columns[countColumn + 1].Put(same ? 0 : current[i].nameId + 1);
+            for (int k = 0; k < fieldCount; k++)
+                columns[countColumn + 2].Put(current[i].values[k] - (same ? previous[i].values[k] : 0));
+        }
+        previous = current;
+    }
+
+    bool WriteBlock() {
+        payload.clear();
+        ColumnWriter::PutVarint(payload, strings.size());
+        for (const std::string& text : strings) {
+            ColumnWriter::PutVarint(payload, text.size());
+            payload.insert(payload.end(), text.begin(), text.end());
+        }
+        for (ColumnWriter& column : columns) {
+            const std::vector<uint8_t>& bytes = column.Finish();
+            ColumnWriter::PutVarint(payload, bytes.size());
+            payload.insert(payload.end(), bytes.begin(), bytes.end());
+        }
+
+        RecordingFormat::BlockHeader header;
+        header.magic = RecordingFormat::BLOCK_MAGIC;
+        header.payloadSize = (uint32_t)payload.size();
+        header.frameCount = blockFrames;
+        header.reserved = 0;
+        header.firstTime = blockFirstTime;
+        header.lastTime = blockLastTime;
+
+        RecordingFormat::IndexEntry entry;
+        entry.firstTime = blockFirstTime;
+        entry.lastTime = blockLastTime;
+        entry.offset = offset;
+        entry.firstFrame = frameCount - blockFrames;
+        index.push_back(entry);
+
+        if (!Write(&header, sizeof(header)) || !Write(payload.data(), payload.size()) || !Flush()) return false;
+        ResetBlock();
+        return true;
+    }
+
+    // 写入 size 字节并累加 offset；写不完整时记录错误、关闭文件，之后的写入都直接返回 false
+    bool Write(const void* data, size_t size) {
+        if (!file) return false;
+        errno = 0;
+        if (size > 0 && fwrite(data, 1, size, file) != size) return Stop();
+        offset += size;
+        return true;
+    }
+
+    bool Flush() {
+        if (!file) return false;
+        errno = 0;
+        return fflush(file) == 0 || Stop();
+    }
+
+    bool Stop() {
+        error = errno != 0 ? strerror(errno) : "写入失败";
+        fclose(file);
+        file = nullptr;
+        return false;
+    }
+};
+
+// 只读映射整个文件
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path) {
+        Close();
+#ifdef _WIN32
+        fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (fileHandle == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+            Close();
+            return false;
+        }
+        mapping = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mapping) {
+            Close();
+            return false;
+        }
+        data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        size = (size_t)fileSize.QuadPart;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* address = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) return false;
+        data = (const uint8_t*)address;
+        size = (size_t)st.st_size;
+#endif
+        return data != nullptr;
+    }
+
+    void Close() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+        mapping = NULL;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (data) munmap((void*)data, size);
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+    const uint8_t* Data() const { return data; }
+    size_t Size() const { return size; }
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE mapping = NULL;
+#endif
+};
+
+// 回放一个录制文件：SeekTime() 按时间定位，Next() 依次解码每一帧
+class SnapshotPlayer {
+public:
+    bool Open(const std::string& path) {
+        index.clear();
+        frameCount = 0;
+        blockIndex = SIZE_MAX;
+        if (!file.Open(path)) return false;
+
+        const uint8_t* data = file.Data();
+        size_t size = file.Size();
+        if (size < sizeof(RecordingFormat::FileHeader) || memcmp(data, RecordingFormat::FileMagic(), 8) != 0) {
+            file.Close();
+            return false;
+        }
+
+        if (!ReadIndex()) RebuildIndex();
+        if (index.empty()) return true;
+        LoadBlock(0);
+        return true;
+    }
+
+    bool IsOpen() const { return file.Data() != nullptr; }
+    uint64_t FrameCount() const { return frameCount; }
+    double StartTime() const { return index.empty() ? 0.0 : index.front().firstTime / 1000.0; }
+    double EndTime() const { return index.empty() ? 0.0 : index.back().lastTime / 1000.0; }
+
+    // 定位到第一个时间不早于 time 的帧：块索引二分查找，块内最多顺序解码 FRAMES_PER_BLOCK 帧
+    bool SeekTime(double time) {
+        if (index.empty()) return false;
+        int64_t timeMs = (int64_t)std::llround(time * 1000.0);
+        auto it = std::lower_bound(index.begin(), index.end(), timeMs,
+            [](const RecordingFormat::IndexEntry& entry, int64_t t) { return entry.lastTime < t; });
+        if (it == index.end()) it = index.end() - 1;
+        if (!LoadBlock((size_t)(it - index.begin()))) return false;
+
+        // 找到目标帧的前一帧为止，下一次 Next() 返回的就是目标帧
+        while (frameInBlock < blockFrames && PeekTime() < timeMs) {
+            if (!DecodeFrame()) return false;
+        }
+        return true;
+    }
+
+    // 解码下一帧，录制结束时返回 false
+    bool Next(SystemSnapshot& snapshot, double& time) {
+        if (index.empty()) return false;
+        if (frameInBlock == blockFrames) {
+            if (blockIndex + 1 >= index.size() || !LoadBlock(blockIndex + 1)) return false;
+        }
+        if (!DecodeFrame()) return false;
+        Output(snapshot);
+        snapshot.sequence = index[blockIndex].firstFrame + frameInBlock;
+        time = currentTime / 1000.0;
+        return true;
+    }
+
+private:
+    MappedFile file;
+    std::vector<RecordingFormat::IndexEntry> index;
+    uint64_t frameCount = 0;
+
+    // 当前块的解码状态
+    size_t blockIndex = SIZE_MAX;
+    uint32_t blockFrames = 0;
+    uint32_t frameInBlock = 0;
+    std::vector<std::string> strings;
+    ColumnReader columns[RecordingColumn_COUNT];
+    int64_t currentTime = 0;
+    int64_t lastDelta = 0;
+    int64_t nextTime = 0;  // 预读的下一帧时间
+    int64_t systemFields[RecordingFormat::SYSTEM_FIELD_COUNT];
+    std::vector<int64_t> coreValues;
+    std::vector<RecordingFormat::Process> processes;
+    std::vector<RecordingFormat::Process> nextProcesses;
+    std::vector<uint32_t> removedPids;
+    std::vector<uint32_t> addedPids;
+    std::vector<RecordingFormat::Row> networkRows;
+    std::vector<RecordingFormat::Row> diskRows;
+
+    bool ReadIndex() {
+        const uint8_t* data = file.Data();
+        size_t size = file.Size();
+        if (size < sizeof(RecordingFormat::FileHeader) + sizeof(RecordingFormat::Trailer)) return false;
+
+        RecordingFormat::Trailer trailer;
+        memcpy(&trailer, data + size - sizeof(trailer), sizeof(trailer));
+        if (memcmp(trailer.magic, RecordingFormat::IndexMagic(), 8) != 0) return false;
+        size_t indexBytes = (size_t)trailer.blockCount * sizeof(RecordingFormat::IndexEntry);
+        if (trailer.indexOffset > size - sizeof(trailer) || indexBytes != size - sizeof(trailer) - trailer.indexOffset)
+            return false;
+
+        index.resize((size_t)trailer.blockCount);
+        if (indexBytes > 0) memcpy(index.data(), data + trailer.indexOffset, indexBytes);
+        // 索引里的偏移也来自文件，块头必须落在文件内，否则按块头重建索引
+        for (const RecordingFormat::IndexEntry& entry : index) {
+            if (entry.offset > size - sizeof(RecordingFormat::BlockHeader)) {
+                index.clear();
+                return false;
+            }
+        }
+        frameCount = trailer.frameCount;
+        return true;
+    }
+
+    // 录制没有正常结束时，顺序扫描块头重建索引，最后一个不完整的块丢弃
+    void RebuildIndex() {
+        const uint8_t* data = file.Data();
+        size_t size = file.Size();
+        size_t offset = sizeof(RecordingFormat::FileHeader);
+        index.clear();
+        frameCount = 0;
+        while (offset + sizeof(RecordingFormat::BlockHeader) <= size) {
+            RecordingFormat::BlockHeader header;
+            memcpy(&header, data + offset, sizeof(header));
+            if (header.magic != RecordingFormat::BLOCK_MAGIC || header.payloadSize > size - offset - sizeof(header)) break;
+            RecordingFormat::IndexEntry entry;
+            entry.firstTime = header.firstTime;
+            entry.lastTime = header.lastTime;
+            entry.offset = offset;
+            entry.firstFrame = frameCount;
+            index.push_back(entry);
+            frameCount += header.frameCount;
+            offset += sizeof(header) + header.payloadSize;
+        }
+    }
+
+    bool LoadBlock(size_t block) {
+        const uint8_t* data = file.Data();
+        size_t size = file.Size();
+        const RecordingFormat::IndexEntry& entry = index[block];
+        if (entry.offset > size - sizeof(RecordingFormat::BlockHeader)) return Fail();
+        RecordingFormat::BlockHeader header;
+        memcpy(&header, data + entry.offset, sizeof(header));
+        // 和 RebuildIndex 一样检查块头，损坏的文件不会读到映射区之外
+        if (header.magic != RecordingFormat::BLOCK_MAGIC || header.payloadSize > size - entry.offset - sizeof(header))
+            return Fail();
+        const uint8_t* p = data + entry.offset + sizeof(header);
+        const uint8_t* end = p + header.payloadSize;
+
+        bool ok = true;
+        uint64_t stringCount = ColumnReader::GetVarint(p, end, ok);
+        strings.resize(ok ? (size_t)std::min<uint64_t>(stringCount, header.payloadSize) : 0);
+        for (std::string& text : strings) {
+            uint64_t length = ColumnReader::GetVarint(p, end, ok);
+            if (!ok || length > (uint64_t)(end - p)) return Fail();
+            text.assign((const char*)p, (size_t)length);
+            p += length;
+        }
+        for (ColumnReader& column : columns) {
+            uint64_t length = ColumnReader::GetVarint(p, end, ok);
+            if (!ok || length > (uint64_t)(end - p)) return Fail();
+            column = ColumnReader(p, p + length);
+            p += length;
+        }
+
+        blockIndex = block;
+        blockFrames = header.frameCount;
+        frameInBlock = 0;
+        currentTime = lastDelta = 0;
+        memset(systemFields, 0, sizeof(systemFields));
+        coreValues.clear();
+        processes.clear();
+        networkRows.clear();
+        diskRows.clear();
+        nextTime = blockFrames > 0 ? columns[RecordingColumn_Time].Get() : 0;
+        return true;
+    }
+
+    bool Fail() {
+        blockFrames = frameInBlock = 0;
+        return false;
+    }
+
+    int64_t PeekTime() const { return nextTime; }
+
+    // 把下一帧解码到内部状态
+    bool DecodeFrame() {
+        if (frameInBlock >= blockFrames) return false;
+        currentTime = nextTime;
+
+        for (int i = 0; i < RecordingFormat::SYSTEM_FIELD_COUNT; i++)
+            systemFields[i] += columns[RecordingColumn_System].Get();
+
+        int64_t coreCount = (int64_t)coreValues.size() + columns[RecordingColumn_CoreCount].Get();
+        if (coreCount < 0 || coreCount > 65536) return Fail();
+        coreValues.resize((size_t)coreCount, 0);
+        for (int64_t& value : coreValues) value += columns[RecordingColumn_Core].Get();
+
+        if (!DecodeProcesses()) return Fail();
+        if (!DecodeRows(networkRows, RecordingColumn_NetworkCount, RecordingFormat::NETWORK_FIELD_COUNT)) return Fail();
+        if (!DecodeRows(diskRows, RecordingColumn_DiskCount, RecordingFormat::DISK_FIELD_COUNT)) return Fail();
+
+        for (const ColumnReader& column : columns) {
+            if (!column.ok) return Fail();
+        }
+
+        // 预读下一帧的时间，SeekTime() 据此判断是否已经到达目标
+        frameInBlock++;
+        if (frameInBlock < blockFrames) {
+            int64_t value = columns[RecordingColumn_Time].Get();
+            lastDelta = frameInBlock == 1 ? value : lastDelta + value;
+            nextTime = currentTime + lastDelta;
+        }
+        return true;
+    }
+
+    bool DecodeProcesses() {
+        int64_t removedCount = columns[RecordingColumn_ProcessRemovedCount].Get();
+        int64_t addedCount = columns[RecordingColumn_ProcessAddedCount].Get();
+        if (removedCount < 0 || addedCount < 0 || (size_t)removedCount > processes.size() || addedCount > (1 << 22)) return false;
+
+        removedPids.resize((size_t)removedCount);
+        uint32_t last = 0;
+        for (uint32_t& pid : removedPids) last = pid = last + (uint32_t)columns[RecordingColumn_ProcessRemovedPid].Get();
+        addedPids.resize((size_t)addedCount);
+        last = 0;
+        for (uint32_t& pid : addedPids) last = pid = last + (uint32_t)columns[RecordingColumn_ProcessAddedPid].Get();
+
+        // 上一帧的进程去掉退出的，再按 PID 顺序合并新增的
+        nextProcesses.clear();
+        size_t r = 0, a = 0;
+        for (const RecordingFormat::Process& process : processes) {
+            if (r < removedPids.size() && removedPids[r] == process.pid) {
+                r++;
+                continue;
+            }
+            while (a < addedPids.size() && addedPids[a] < process.pid) AddProcess(addedPids[a++]);
+            nextProcesses.push_back(process);
+        }
+        while (a < addedPids.size()) AddProcess(addedPids[a++]);
+        if (r != removedPids.size()) return false;
+
+        // 新增的进程 nameId 为 UINT32_MAX，名字列一定不为 0
+        for (RecordingFormat::Process& process : nextProcesses) {
+            bool isNew = process.nameId == UINT32_MAX;
+            int64_t name = columns[RecordingColumn_ProcessName].Get();
+            int64_t status = columns[RecordingColumn_ProcessStatus].Get();
+            if (name != 0) process.nameId = (uint32_t)(name - 1);
+            if (status != 0) process.statusId = (uint32_t)(status - 1);
+            if (process.nameId >= strings.size() || process.statusId >= strings.size()) return false;
+            process.cpu = (isNew ? 0 : process.cpu) + columns[RecordingColumn_ProcessCpu].Get();
+            process.memory = (isNew ? 0 : process.memory) + columns[RecordingColumn_ProcessMemory].Get();
+        }
+        processes.swap(nextProcesses);
+        return true;
+    }
+
+    void AddProcess(uint32_t pid) {
+        RecordingFormat::Process process;
+        process.pid = pid;
+        process.nameId = UINT32_MAX;
+        process.statusId = UINT32_MAX;
+        process.cpu = 0;
+        process.memory = 0;
+        nextProcesses.push_back(process);
+    }
+
+    bool DecodeRows(std::vector<RecordingFormat::Row>& rows, int countColumn, int fieldCount) {
+        int64_t count = (int64_t)rows.size() + columns[countColumn].Get();
+        if (count < 0 || count > 65536) return false;
+        size_t previousCount = rows.size();
+        rows.resize((size_t)count);
+        for (size_t i = 0; i < rows.size(); i++) {
+            RecordingFormat::Row& row = rows[i];
+            int64_t name = columns[countColumn + 1].Get();
+            bool same = name == 0 && i < previousCount;
+            if (name == 0 && !same) return false;
+            if (!same) row.nameId = (uint32_t)(name - 1);
+            if (row.nameId >= strings.size()) return false;
+            for (int k = 0; k < fieldCount; k++)
+                row.values[k] = (same ? row.values[k] : 0) + columns[countColumn + 2].Get();
+        }
+        return true;
+    }
+
+    void Output(SystemSnapshot& snapshot) const {
+        RecordingFormat::FieldsToSystem(systemFields, snapshot.system);
+        snapshot.system.coreUsage.resize(coreValues.size());
+        for (size_t i = 0; i < coreValues.size(); i++) snapshot.system.coreUsage[i] = coreValues[i] / 100.0;
+
+        snapshot.processes.resize(processes.size());
+        for (size_t i = 0; i < processes.size(); i++) {
+            ProcessInfo& info = snapshot.processes[i];
+            info.pid = processes[i].pid;
+            info.name = strings[processes[i].nameId];
+            info.status = strings[processes[i].statusId];
+            info.cpuUsage = processes[i].cpu / 100.0;
+            info.memoryUsage = (size_t)processes[i].memory;
+        }
+
+        snapshot.networks.resize(networkRows.size());
+        for (size_t i = 0; i < networkRows.size(); i++) {
+            snapshot.networks[i].adapterName = strings[networkRows[i].nameId];
+            RecordingFormat::RowToNetwork(networkRows[i], snapshot.networks[i]);
+        }
+
+        snapshot.disks.resize(diskRows.size());
+        for (size_t i = 0; i < diskRows.size(); i++) {
+            snapshot.disks[i].driveLetter = strings[diskRows[i].nameId];
+            RecordingFormat::RowToDisk(diskRows[i], snapshot.disks[i]);
+        }
+
+        snapshot.threadPid = SystemSnapshot::NO_PROCESS;
+        snapshot.threads.clear();
+    }
+};
+
+// 把录制文件当作采集器使用，交给 SystemMonitor 之后界面的用法和实时数据完全一样
+// 每次 CollectSystemInfo() 前进一帧，其余 Collect* 返回同一帧的内容，播放到结尾后从头循环
+class ReplayCollector : public SystemCollector {
+public:
+    bool Open(const std::string& path) {
+        if (!player.Open(path) || player.FrameCount() == 0) return false;
+        startTime = player.StartTime();
+        endTime = player.EndTime();
+        return true;
+    }
+
+    double StartTime() const { return startTime; }
+    double EndTime() const { return endTime; }
+
+    // 当前回放到的时间，可以在任何线程读取
+    double CurrentTime() const { return currentTime.load(); }
+
+    // 跳转到 time，在下一次采样时生效；可以在任何线程调用
+    void Seek(double time) {
+        seekTime.store(time);
+        seekPending.store(true);
+    }
+
+    void CollectSystemInfo(SystemInfo& info) override {
+        if (seekPending.exchange(false)) player.SeekTime(seekTime.load());
+        double time = 0.0;
+        if (!player.Next(frame, time)) {
+            player.SeekTime(startTime);
+            player.Next(frame, time);
+        }
+        currentTime.store(time);
+        info = frame.system;
+    }
+
+    void CollectProcessList(std::vector<ProcessInfo>& processes) override {
+        processes = frame.processes;
+    }
+
+    // 录制文件中没有线程数据
+    void CollectThreadList(uint32_t, std::vector<ThreadInfo>& threads) override {
+        threads.clear();
+    }
+
+    void CollectNetworkInfo(std::vector<NetworkInfo>& networks) override {
+        networks = frame.networks;
+    }
+
+    void CollectDiskInfo(std::vector<DiskInfo>& disks) override {
+        disks = frame.disks;
+    }
+
+private:
+    SnapshotPlayer player;
+    SystemSnapshot frame;
+    double startTime = 0.0;
+    double endTime = 0.0;
+    std::atomic<double> currentTime{0.0};
+    std::atomic<double> seekTime{0.0};
+    std::atomic<bool> seekPending{false};
+};
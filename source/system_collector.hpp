@@ -0,0 +1,67 @@
+// 系统数据采集接口
+// SystemMonitor 只负责历史数据和格式化，具体的数据来源由平台相关的采集器提供
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct SystemInfo {
+    double cpuUsage = 0.0;
+    double memoryUsage = 0.0;
+    double diskUsage = 0.0;
+    uint64_t networkReceived = 0;
+    uint64_t networkSent = 0;
+    double diskReadSpeed = 0.0;
+    double diskWriteSpeed = 0.0;
+    double systemUptime = 0.0;
+    double cpuTemperature = 0.0;
+    std::vector<double> coreUsage;  // 每个逻辑核心的使用率 %，下标为核心编号
+};
+
+struct ProcessInfo {
+    std::string name;
+    double cpuUsage = 0.0;   // 占整机 CPU 的百分比，已经除以核心数
+    size_t memoryUsage = 0;  // MB
+    std::string status;
+    uint32_t pid = 0;
+};
+
+struct ThreadInfo {
+    std::string name;
+    double cpuUsage = 0.0;   // 占整机 CPU 的百分比，和 ProcessInfo 一致
+    std::string status;
+    uint32_t tid = 0;
+};
+
+struct NetworkInfo {
+    std::string adapterName;
+    uint64_t bytesReceived = 0;
+    uint64_t bytesSent = 0;
+    double uploadSpeed = 0.0;    // bytes per second
+    double downloadSpeed = 0.0;  // bytes per second
+};
+
+struct DiskInfo {
+    std::string driveLetter;     // Windows 下为盘符，Linux 下为挂载点
+    double totalSpace = 0.0;     // GB
+    double usedSpace = 0.0;      // GB
+    double freeSpace = 0.0;      // GB
+    double readSpeed = 0.0;      // MB/s
+    double writeSpeed = 0.0;     // MB/s
+};
+
+// 采集器接口，每个平台实现一个后端
+// 所有 Collect* 函数都以输出参数的形式填充结果，调用方可以复用同一个 vector 避免重复分配
+class SystemCollector {
+public:
+    virtual ~SystemCollector() = default;
+
+    // 填充 CPU/内存/磁盘使用率、运行时间、温度等瞬时数据（不包括历史数据）
+    virtual void CollectSystemInfo(SystemInfo& info) = 0;
+    virtual void CollectProcessList(std::vector<ProcessInfo>& processes) = 0;
+    // 单个进程的线程列表，只有用户查看某个进程时才会调用
+    virtual void CollectThreadList(uint32_t pid, std::vector<ThreadInfo>& threads) = 0;
+    virtual void CollectNetworkInfo(std::vector<NetworkInfo>& networks) = 0;
+    virtual void CollectDiskInfo(std::vector<DiskInfo>& disks) = 0;
+};
@@ -0,0 +1,514 @@
+// Linux 采集器：/proc + sysfs
+// 所有 /proc 文件只打开一次，之后每次采样都用 pread 从偏移 0 重新读取到复用的缓冲区中，
+// 解析时直接扫描字符，不经过 iostream，一次完整采样只需要几十微秒
+#pragma once
+#include "system_collector.hpp"
+#include "cpu_accounting.hpp"
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/resource.h>
+#include <sys/statvfs.h>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// 持久打开的 /proc 或 sysfs 文件
+class ProcFile {
+public:
+    ProcFile() = default;
+    explicit ProcFile(const char* path) { Open(path); }
+    ~ProcFile() { Close(); }
+
+    ProcFile(const ProcFile&) = delete;
+    ProcFile& operator=(const ProcFile&) = delete;
+    ProcFile(ProcFile&& other) noexcept : fd(other.fd) { other.fd = -1; }
+    ProcFile& operator=(ProcFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+            fd = other.fd;
+            other.fd = -1;
+        }
+        return *this;
+    }
+
+    bool Open(const char* path) {
+        Close();
+        fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        return fd >= 0;
+    }
+
+    void Close() {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    bool IsOpen() const { return fd >= 0; }
+
+    // 把整个文件读入 buffer 并以 '\0' 结尾，缓冲区不够时自动扩容
+    // 返回内容长度，失败返回 -1（例如进程已经退出）
+    ssize_t Read(std::vector<char>& buffer) const {
+        if (fd < 0) return -1;
+        if (buffer.size() < 4096) buffer.resize(4096);
+        size_t total = 0;
+        for (;;) {
+            ssize_t n = ::pread(fd, buffer.data() + total, buffer.size() - total - 1, (off_t)total);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return -1;
+            }
+            if (n == 0) break;
+            total += (size_t)n;
+            if (total + 1 >= buffer.size()) buffer.resize(buffer.size() * 2);
+        }
+        buffer[total] = '\0';
+        return (ssize_t)total;
+    }
+
+private:
+    int fd = -1;
+};
+
+class LinuxCollector : public SystemCollector {
+public:
+    LinuxCollector()
+        : statFile("/proc/stat"),
+          meminfoFile("/proc/meminfo"),
+          uptimeFile("/proc/uptime"),
+          netDevFile("/proc/net/dev"),
+          diskstatsFile("/proc/diskstats"),
+          mountsFile("/proc/self/mounts"),
+          thermalFile("/sys/class/thermal/thermal_zone0/temp") {
+        clockTicks = sysconf(_SC_CLK_TCK);
+        pageSize = sysconf(_SC_PAGESIZE);
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        coreCount = cores > 0 ? (unsigned)cores : 1;
+        procDir = opendir("/proc");
+
+        // 每个进程缓存一个 /proc/[pid]/stat 句柄，数量有固定上限，超出部分退化为每次采样临时打开。
+        // 只读取当前软限制，不修改进程级的资源限制（由应用自己决定），上限也不超过软限制的一半
+        rlimit limit;
+        if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY &&
+            (size_t)limit.rlim_cur / 2 < maxCachedPidFiles)
+            maxCachedPidFiles = (size_t)limit.rlim_cur / 2;
+
+        auto now = std::chrono::steady_clock::now();
+        lastNetworkTime = lastDiskTime = now;
+    }
+
+    ~LinuxCollector() override {
+        if (procDir) closedir(procDir);
+    }
+
+    void CollectSystemInfo(SystemInfo& info) override {
+        // CPU使用率：/proc/stat 第一行 "cpu user nice system idle iowait irq softirq steal ..."，
+        // 之后每个在线核心一行 "cpuN ..."
+        info.coreUsage.clear();
+        if (statFile.Read(buffer) > 0) {
+            const char* p = buffer.data() + 3;
+            uint64_t total, idle;
+            ParseCpuLine(p, total, idle);
+            if (lastCpuTotal != 0 && total > lastCpuTotal) {
+                info.cpuUsage = CoreAccounting::Usage(lastCpuTotal, lastCpuIdle, total, idle);
+            }
+            lastCpuTotal = total;
+            lastCpuIdle = idle;
+
+            unsigned online = 0;
+            p = SkipLine(p);
+            while (strncmp(p, "cpu", 3) == 0 && p[3] >= '0' && p[3] <= '9') {
+                p += 3;
+                size_t core = (size_t)ParseU64(p);
+                ParseCpuLine(p, total, idle);
+                if (core >= info.coreUsage.size()) info.coreUsage.resize(core + 1, 0.0);
+                info.coreUsage[core] = coreCpu.Update(core, total, idle);
+                online++;
+                p = SkipLine(p);
+            }
+            if (online > 0) coreCount = online;
+        }
+
+        // 内存使用率
+        if (meminfoFile.Read(buffer) > 0) {
+            uint64_t memTotal = FindValue(buffer.data(), "MemTotal:");
+            uint64_t memAvailable = FindValue(buffer.data(), "MemAvailable:");
+            if (memTotal > 0)
+                info.memoryUsage = (1.0 - (double)memAvailable / memTotal) * 100.0;
+        }
+
+        // 磁盘使用率
+        struct statvfs fs;
+        if (statvfs("/", &fs) == 0 && fs.f_blocks > 0) {
+            info.diskUsage = (1.0 - (double)fs.f_bfree / fs.f_blocks) * 100.0;
+        }
+
+        // 系统运行时间
+        if (uptimeFile.Read(buffer) > 0) {
+            info.systemUptime = strtod(buffer.data(), nullptr) / 3600.0; // Convert to hours
+        }
+
+        // CPU温度，单位为千分之一摄氏度
+        if (thermalFile.Read(buffer) > 0) {
+            const char* p = buffer.data();
+            info.cpuTemperature = ParseU64(p) / 1000.0;
+        }
+    }
+
+    // 复用 processes 中已有的元素（包括其中字符串的内存），稳定运行时不会产生新的分配
+    void CollectProcessList(std::vector<ProcessInfo>& processes) override {
+        if (!procDir) {
+            processes.clear();
+            return;
+        }
+        size_t count = 0;
+        processCpu.BeginSample(MonotonicNanoseconds(), coreCount);
+
+        rewinddir(procDir);
+        while (dirent* entry = readdir(procDir)) {
+            if (entry->d_name[0] < '0' || entry->d_name[0] > '9') continue;
+            uint32_t pid = (uint32_t)strtoul(entry->d_name, nullptr, 10);
+
+            char path[32];
+            snprintf(path, sizeof(path), "/proc/%u/stat", pid);
+
+            bool isNew = false;
+            auto& cpuEntry = processCpu.Touch(pid, &isNew);
+            PidEntry& pidEntry = cpuEntry.data;
+            if (isNew && cachedPidFiles < maxCachedPidFiles && pidEntry.file.Open(path))
+                ++cachedPidFiles;
+
+            ssize_t length = pidEntry.file.IsOpen() ? pidEntry.file.Read(buffer) : ProcFile(path).Read(buffer);
+            if (length <= 0) {
+                // 进程在枚举和读取之间退出了
+                processCpu.Expire(pid);
+                continue;
+            }
+
+            ProcStat stat;
+            if (!ParseProcStat(buffer.data(), stat)) continue;
+
+            if (count == processes.size()) processes.emplace_back();
+            ProcessInfo& info = processes[count++];
+            info.pid = pid;
+            info.name.assign(stat.nameBegin, stat.nameEnd);
+            info.cpuUsage = processCpu.Account(cpuEntry, stat.cpuTicks * NanosecondsPerTick());
+            info.memoryUsage = (size_t)(stat.rss * pageSize / 1024 / 1024); // Convert to MB
+            info.status = StateName(stat.state);
+        }
+        processes.resize(count);
+
+        // 清理本轮没有出现的进程
+        processCpu.EndSample([this](uint32_t, PidEntry& pidEntry) {
+            if (pidEntry.file.IsOpen()) --cachedPidFiles;
+        });
+    }
+
+    // /proc/[pid]/task/[tid]/stat 和进程的 stat 格式相同，只对正在查看的一个进程读取，不缓存句柄
+    void CollectThreadList(uint32_t pid, std::vector<ThreadInfo>& threads) override {
+        size_t count = 0;
+        threadCpu.BeginSample(MonotonicNanoseconds(), coreCount);
+
+        char path[64];
+        snprintf(path, sizeof(path), "/proc/%u/task", pid);
+        if (DIR* taskDir = opendir(path)) {
+            while (dirent* entry = readdir(taskDir)) {
+                if (entry->d_name[0] < '0' || entry->d_name[0] > '9') continue;
+                uint32_t tid = (uint32_t)strtoul(entry->d_name, nullptr, 10);
+
+                snprintf(path, sizeof(path), "/proc/%u/task/%u/stat", pid, tid);
+                ProcStat stat;
+                if (ProcFile(path).Read(buffer) <= 0 || !ParseProcStat(buffer.data(), stat)) continue;
+
+                if (count == threads.size()) threads.emplace_back();
+                ThreadInfo& info = threads[count++];
+                info.tid = tid;
+                info.name.assign(stat.nameBegin, stat.nameEnd);
+                info.cpuUsage = threadCpu.Update(tid, stat.cpuTicks * NanosecondsPerTick());
+                info.status = StateName(stat.state);
+            }
+            closedir(taskDir);
+        }
+        threads.resize(count);
+        threadCpu.EndSample();
+    }
+
+    void CollectNetworkInfo(std::vector<NetworkInfo>& networkInfos) override {
+        networkInfos.clear();
+        if (netDevFile.Read(buffer) <= 0) return;
+
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - lastNetworkTime).count();
+        lastNetworkTime = now;
+
+        // 前两行是表头
+        const char* p = SkipLine(SkipLine(buffer.data()));
+        while (*p) {
+            while (*p == ' ') ++p;
+            const char* colon = strchr(p, ':');
+            if (!colon) break;
+
+            NetworkInfo info;
+            info.adapterName.assign(p, colon);
+            p = colon + 1;
+            info.bytesReceived = ParseU64(p);
+            SkipFields(p, 7);
+            info.bytesSent = ParseU64(p);
+            p = SkipLine(p);
+
+            if (info.adapterName == "lo") continue;
+
+            // 计算速度（与上次获取的差值）
+            auto last = lastNetworkBytes.find(info.adapterName);
+            if (last != lastNetworkBytes.end()) {
+                if (seconds > 0 && info.bytesReceived >= last->second.first && info.bytesSent >= last->second.second) {
+                    info.downloadSpeed = (info.bytesReceived - last->second.first) / seconds;
+                    info.uploadSpeed = (info.bytesSent - last->second.second) / seconds;
+                }
+                last->second = {info.bytesReceived, info.bytesSent};
+            } else {
+                lastNetworkBytes.emplace(info.adapterName, std::make_pair(info.bytesReceived, info.bytesSent));
+            }
+
+            networkInfos.push_back(std::move(info));
+        }
+    }
+
+    void CollectDiskInfo(std::vector<DiskInfo>& diskInfos) override {
+        diskInfos.clear();
+
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - lastDiskTime).count();
+        lastDiskTime = now;
+
+        // /proc/diskstats: "major minor name reads merged sectors_read ms writes merged sectors_written ..."
+        diskStats.clear();
+        if (diskstatsFile.Read(buffer) > 0) {
+            const char* p = buffer.data();
+            while (*p) {
+                SkipFields(p, 2);
+                while (*p == ' ') ++p;
+                const char* nameBegin = p;
+                while (*p && *p != ' ') ++p;
+                DiskStat stat;
+                stat.name.assign(nameBegin, p);
+                SkipFields(p, 2);
+                stat.sectorsRead = ParseU64(p);
+                SkipFields(p, 3);
+                stat.sectorsWritten = ParseU64(p);
+                p = SkipLine(p);
+                diskStats.push_back(std::move(stat));
+            }
+        }
+
+        // /proc/self/mounts: "device mountpoint fstype options 0 0"，只统计真实块设备
+        if (mountsFile.Read(buffer) <= 0) return;
+        seenDevices.clear();
+        const char* p = buffer.data();
+        while (*p) {
+            const char* line = p;
+            p = SkipLine(p);
+            if (strncmp(line, "/dev/", 5) != 0) continue;
+
+            const char* deviceEnd = strchr(line, ' ');
+            if (!deviceEnd || deviceEnd >= p) continue;
+            std::string device(line, deviceEnd);
+            bool duplicated = false;
+            for (const std::string& seen : seenDevices) {
+                if (seen == device) { duplicated = true; break; }
+            }
+            if (duplicated) continue;
+            seenDevices.push_back(device);
+
+            DiskInfo info;
+            info.driveLetter = UnescapeMountPath(deviceEnd + 1);
+
+            struct statvfs fs;
+            if (statvfs(info.driveLetter.c_str(), &fs) != 0 || fs.f_blocks == 0) continue;
+            info.totalSpace = (double)fs.f_blocks * fs.f_frsize / (1024.0 * 1024.0 * 1024.0);
+            info.freeSpace = (double)fs.f_bfree * fs.f_frsize / (1024.0 * 1024.0 * 1024.0);
+            info.usedSpace = info.totalSpace - info.freeSpace;
+
+            // diskstats 中的扇区固定为 512 字节
+            const std::string& kernelName = KernelDeviceName(device);
+            for (const DiskStat& stat : diskStats) {
+                if (stat.name != kernelName) continue;
+                auto last = lastDiskSectors.find(kernelName);
+                if (last != lastDiskSectors.end()) {
+                    if (seconds > 0 && stat.sectorsRead >= last->second.first && stat.sectorsWritten >= last->second.second) {
+                        info.readSpeed = (stat.sectorsRead - last->second.first) * 512.0 / (1024.0 * 1024.0) / seconds;
+                        info.writeSpeed = (stat.sectorsWritten - last->second.second) * 512.0 / (1024.0 * 1024.0) / seconds;
+                    }
+                    last->second = {stat.sectorsRead, stat.sectorsWritten};
+                } else {
+                    lastDiskSectors.emplace(kernelName, std::make_pair(stat.sectorsRead, stat.sectorsWritten));
+                }
+                break;
+            }
+
+            diskInfos.push_back(std::move(info));
+        }
+    }
+
+private:
+    // 进程的 stat 句柄，跟随 processCpu 中的条目一起淘汰
+    struct PidEntry {
+        ProcFile file;
+    };
+
+    // /proc/[pid]/stat 中用到的字段
+    struct ProcStat {
+        const char* nameBegin = nullptr;
+        const char* nameEnd = nullptr;
+        char state = '?';
+        uint64_t cpuTicks = 0;  // utime + stime
+        uint64_t rss = 0;       // 页
+    };
+
+    struct DiskStat {
+        std::string name;
+        uint64_t sectorsRead = 0;
+        uint64_t sectorsWritten = 0;
+    };
+
+    ProcFile statFile;
+    ProcFile meminfoFile;
+    ProcFile uptimeFile;
+    ProcFile netDevFile;
+    ProcFile diskstatsFile;
+    ProcFile mountsFile;
+    ProcFile thermalFile;
+    DIR* procDir = nullptr;
+    std::vector<char> buffer;
+
+    long clockTicks = 100;
+    long pageSize = 4096;
+    unsigned coreCount = 1;
+    uint64_t lastCpuTotal = 0;
+    uint64_t lastCpuIdle = 0;
+    CoreAccounting coreCpu;
+
+    CpuAccounting<PidEntry> processCpu;
+    CpuAccounting<> threadCpu;
+    static constexpr size_t MAX_CACHED_PID_FILES = 1024;   // 缓存的 /proc/[pid]/stat 句柄数量上限
+    size_t cachedPidFiles = 0;
+    size_t maxCachedPidFiles = MAX_CACHED_PID_FILES;
+
+    std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> lastNetworkBytes;
+    std::chrono::steady_clock::time_point lastNetworkTime;
+
+    std::vector<DiskStat> diskStats;
+    std::vector<std::string> seenDevices;
+    std::unordered_map<std::string, std::string> kernelDeviceNames;
+    std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> lastDiskSectors;
+    std::chrono::steady_clock::time_point lastDiskTime;
+
+    uint64_t NanosecondsPerTick() const {
+        return 1000000000ull / (uint64_t)clockTicks;
+    }
+
+    static uint64_t MonotonicNanoseconds() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // "user nice system idle iowait irq softirq steal"，idle 包含 iowait
+    static void ParseCpuLine(const char*& p, uint64_t& total, uint64_t& idle) {
+        uint64_t fields[8];
+        total = 0;
+        for (uint64_t& field : fields) {
+            field = ParseU64(p);
+            total += field;
+        }
+        idle = fields[3] + fields[4];
+    }
+
+    // "pid (comm) state ppid ..."，comm 本身可能包含空格和括号，以最后一个 ')' 为准
+    static bool ParseProcStat(const char* text, ProcStat& stat) {
+        stat.nameBegin = strchr(text, '(');
+        stat.nameEnd = strrchr(text, ')');
+        if (!stat.nameBegin || !stat.nameEnd || stat.nameEnd < stat.nameBegin) return false;
+        stat.nameBegin++;
+
+        const char* p = stat.nameEnd + 2;
+        stat.state = *p++;
+        SkipFields(p, 10);                 // ppid .. cmajflt
+        uint64_t utime = ParseU64(p);
+        uint64_t stime = ParseU64(p);
+        SkipFields(p, 8);                  // cutime .. vsize
+        stat.rss = ParseU64(p);
+        stat.cpuTicks = utime + stime;
+        return true;
+    }
+
+    // /dev/mapper/xxx、/dev/disk/by-uuid/xxx 等都是符号链接，解析到 /dev/dm-0 这样的内核设备名，结果缓存起来
+    const std::string& KernelDeviceName(const std::string& device) {
+        auto it = kernelDeviceNames.find(device);
+        if (it != kernelDeviceNames.end()) return it->second;
+
+        char resolved[PATH_MAX];
+        const char* path = realpath(device.c_str(), resolved) ? resolved : device.c_str();
+        const char* slash = strrchr(path, '/');
+        return kernelDeviceNames.emplace(device, slash ? slash + 1 : path).first->second;
+    }
+
+    static const char* StateName(char state) {
+        switch (state) {
+            case 'R': return "运行中";
+            case 'S': return "睡眠";
+            case 'D': return "磁盘等待";
+            case 'Z': return "僵尸";
+            case 'T': case 't': return "已停止";
+            case 'I': return "空闲";
+            default: return "未知";
+        }
+    }
+
+    // mounts 中的空格、制表符等用 \040 形式的八进制转义
+    static std::string UnescapeMountPath(const char* p) {
+        std::string path;
+        while (*p && *p != ' ' && *p != '\n') {
+            if (p[0] == '\\' && p[1] >= '0' && p[1] <= '7' && p[2] >= '0' && p[2] <= '7' && p[3] >= '0' && p[3] <= '7') {
+                path.push_back((char)((p[1] - '0') * 64 + (p[2] - '0') * 8 + (p[3] - '0')));
+                p += 4;
+            } else {
+                path.push_back(*p++);
+            }
+        }
+        return path;
+    }
+
+    static uint64_t ParseU64(const char*& p) {
+        while (*p == ' ' || *p == '\t') ++p;
+        uint64_t value = 0;
+        while (*p >= '0' && *p <= '9') value = value * 10 + (uint64_t)(*p++ - '0');
+        return value;
+    }
+
+    static void SkipFields(const char*& p, int count) {
+        for (int i = 0; i < count; i++) {
+            while (*p == ' ' || *p == '\t') ++p;
+            while (*p && *p != ' ' && *p != '\t' && *p != '\n') ++p;
+        }
+    }
+
+    static const char* SkipLine(const char* p) {
+        while (*p && *p != '\n') ++p;
+        return *p ? p + 1 : p;
+    }
+
+    static uint64_t FindValue(const char* text, const char* key) {
+        const char* p = strstr(text, key);
+        if (!p) return 0;
+        p += strlen(key);
+        return ParseU64(p);
+    }
+};
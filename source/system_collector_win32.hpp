@@ -0,0 +1,265 @@
+// Windows 采集器：PDH + Toolhelp32 + IP Helper
+#pragma once
+#include "system_collector.hpp"
+#include "cpu_accounting.hpp"
+#include <windows.h>
+#include <pdh.h>
+#include <psapi.h>
+#include <tlhelp32.h>
+#include <iphlpapi.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+
+#pragma comment(lib, "iphlpapi.lib")
+
+class Win32Collector : public SystemCollector {
+public:
+    Win32Collector() {
+        PdhOpenQueryA(NULL, 0, &cpuQuery);
+        PdhAddCounterA(cpuQuery, "\\Processor(_Total)\\% Processor Time", 0, &cpuCounter);
+        PdhAddCounterA(cpuQuery, "\\Processor(*)\\% Processor Time", 0, &coreCounter);
+        PdhCollectQueryData(cpuQuery);
+
+        coreCount = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+        if (coreCount == 0) coreCount = 1;
+    }
+
+    ~Win32Collector() override {
+        if (cpuQuery) {
+            PdhCloseQuery(cpuQuery);
+        }
+    }
+
+    void CollectSystemInfo(SystemInfo& info) override {
+        // CPU使用率
+        PDH_FMT_COUNTERVALUE counterVal;
+        PdhCollectQueryData(cpuQuery);
+        PdhGetFormattedCounterValue(cpuCounter, PDH_FMT_DOUBLE, NULL, &counterVal);
+        info.cpuUsage = counterVal.doubleValue;
+
+        // 每个核心的使用率，实例名为核心编号，另有一个 "_Total"
+        info.coreUsage.clear();
+        DWORD bufferSize = 0, itemCount = 0;
+        if (PdhGetFormattedCounterArrayA(coreCounter, PDH_FMT_DOUBLE, &bufferSize, &itemCount, NULL) == PDH_MORE_DATA) {
+            coreItems.resize(bufferSize / sizeof(PDH_FMT_COUNTERVALUE_ITEM_A) + 1);
+            if (PdhGetFormattedCounterArrayA(coreCounter, PDH_FMT_DOUBLE, &bufferSize, &itemCount, coreItems.data()) == ERROR_SUCCESS) {
+                for (DWORD i = 0; i < itemCount; i++) {
+                    const char* name = coreItems[i].szName;
+                    if (name[0] < '0' || name[0] > '9') continue;
+                    size_t core = (size_t)atoi(name);
+                    if (core >= info.coreUsage.size()) info.coreUsage.resize(core + 1, 0.0);
+                    info.coreUsage[core] = coreItems[i].FmtValue.doubleValue;
+                }
+            }
+        }
+
+        // 内存使用率
+        MEMORYSTATUSEX memInfo;
+        memInfo.dwLength = sizeof(MEMORYSTATUSEX);
+        GlobalMemoryStatusEx(&memInfo);
+        info.memoryUsage = memInfo.dwMemoryLoad;
+
+        // 磁盘使用率
+        ULARGE_INTEGER freeBytesAvailable, totalBytes, totalFreeBytes;
+        GetDiskFreeSpaceExA("C:\\", &freeBytesAvailable, &totalBytes, &totalFreeBytes);
+        info.diskUsage = (1.0 - (double)totalFreeBytes.QuadPart / totalBytes.QuadPart) * 100.0;
+
+        // 系统运行时间
+        info.systemUptime = GetTickCount64() / 1000.0 / 3600.0; // Convert to hours
+
+        // CPU温度 (需要WMI查询，这里用模拟数据)
+        info.cpuTemperature = 45.0 + (rand() % 20);
+    }
+
+    // 复用 processes 中已有的元素（包括其中字符串的内存），稳定运行时不会产生新的分配
+    void CollectProcessList(std::vector<ProcessInfo>& processes) override {
+        size_t count = 0;
+        processCpu.BeginSample(MonotonicNanoseconds(), coreCount);
+        HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+        if (snapshot != INVALID_HANDLE_VALUE) {
+            PROCESSENTRY32W processEntry = { sizeof(PROCESSENTRY32W) };
+
+            if (Process32FirstW(snapshot, &processEntry)) {
+                do {
+                    if (count == processes.size()) processes.emplace_back();
+                    ProcessInfo& info = processes[count++];
+                    WideToUtf8(processEntry.szExeFile, info.name);
+                    info.pid = processEntry.th32ProcessID;
+                    info.memoryUsage = 0;
+                    info.cpuUsage = 0.0;
+
+                    // 同一个句柄取内存和 CPU 时间
+                    HANDLE processHandle = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, info.pid);
+                    if (processHandle != NULL) {
+                        PROCESS_MEMORY_COUNTERS pmc;
+                        if (GetProcessMemoryInfo(processHandle, &pmc, sizeof(pmc))) {
+                            info.memoryUsage = pmc.WorkingSetSize / 1024 / 1024; // Convert to MB
+                        }
+                        FILETIME createTime, exitTime, kernelTime, userTime;
+                        if (GetProcessTimes(processHandle, &createTime, &exitTime, &kernelTime, &userTime)) {
+                            info.cpuUsage = processCpu.Update(info.pid, CpuNanoseconds(kernelTime, userTime));
+                        }
+                        CloseHandle(processHandle);
+                    }
+
+                    info.status = "运行中";
+                } while (Process32NextW(snapshot, &processEntry));
+            }
+            CloseHandle(snapshot);
+        }
+        processes.resize(count);
+        processCpu.EndSample();
+    }
+
+    // 线程快照包含系统中所有线程，按所属进程过滤
+    void CollectThreadList(uint32_t pid, std::vector<ThreadInfo>& threads) override {
+        size_t count = 0;
+        threadCpu.BeginSample(MonotonicNanoseconds(), coreCount);
+        HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+        if (snapshot != INVALID_HANDLE_VALUE) {
+            THREADENTRY32 threadEntry = { sizeof(THREADENTRY32) };
+
+            if (Thread32First(snapshot, &threadEntry)) {
+                do {
+                    if (threadEntry.th32OwnerProcessID != pid) continue;
+                    if (count == threads.size()) threads.emplace_back();
+                    ThreadInfo& info = threads[count++];
+                    info.tid = threadEntry.th32ThreadID;
+                    info.name.clear();
+                    info.cpuUsage = 0.0;
+                    info.status = "运行中";
+
+                    HANDLE threadHandle = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, info.tid);
+                    if (threadHandle != NULL) {
+                        FILETIME createTime, exitTime, kernelTime, userTime;
+                        if (GetThreadTimes(threadHandle, &createTime, &exitTime, &kernelTime, &userTime)) {
+                            info.cpuUsage = threadCpu.Update(info.tid, CpuNanoseconds(kernelTime, userTime));
+                        }
+                        CloseHandle(threadHandle);
+                    }
+                } while (Thread32Next(snapshot, &threadEntry));
+            }
+            CloseHandle(snapshot);
+        }
+        threads.resize(count);
+        threadCpu.EndSample();
+    }
+
+    void CollectNetworkInfo(std::vector<NetworkInfo>& networkInfos) override {
+        networkInfos.clear();
+
+        // 获取网络适配器信息
+        ULONG size = 0;
+        GetAdaptersInfo(NULL, &size);
+        std::vector<IP_ADAPTER_INFO> adapters(size / sizeof(IP_ADAPTER_INFO) + 1);
+
+        if (GetAdaptersInfo(&adapters[0], &size) == ERROR_SUCCESS) {
+            auto now = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(now - lastNetworkTime).count();
+            lastNetworkTime = now;
+
+            PIP_ADAPTER_INFO pAdapter = &adapters[0];
+            while (pAdapter) {
+                NetworkInfo info;
+                info.adapterName = pAdapter->Description;
+
+                // 获取网络流量
+                MIB_IFROW ifRow;
+                ifRow.dwIndex = pAdapter->Index;
+                if (GetIfEntry(&ifRow) == NO_ERROR) {
+                    info.bytesReceived = ifRow.dwInOctets;
+                    info.bytesSent = ifRow.dwOutOctets;
+
+                    // 计算速度（与上次获取的差值）
+                    auto last = lastNetworkBytes.find(pAdapter->Index);
+                    if (last != lastNetworkBytes.end() && seconds > 0) {
+                        info.downloadSpeed = (info.bytesReceived - last->second.first) / seconds;
+                        info.uploadSpeed = (info.bytesSent - last->second.second) / seconds;
+                    }
+
+                    lastNetworkBytes[pAdapter->Index] = {info.bytesReceived, info.bytesSent};
+                }
+
+                networkInfos.push_back(info);
+                pAdapter = pAdapter->Next;
+            }
+        }
+    }
+
+    void CollectDiskInfo(std::vector<DiskInfo>& diskInfos) override {
+        diskInfos.clear();
+        DWORD drives = GetLogicalDrives();
+        char driveLetter = 'A';
+
+        while (drives) {
+            if (drives & 1) {
+                std::string root = std::string(1, driveLetter) + ":\\";
+                ULARGE_INTEGER freeBytesAvailable, totalBytes, totalFreeBytes;
+
+                if (GetDiskFreeSpaceExA(root.c_str(), &freeBytesAvailable,
+                    &totalBytes, &totalFreeBytes)) {
+                    DiskInfo info;
+                    info.driveLetter = root;
+                    info.totalSpace = totalBytes.QuadPart / (1024.0 * 1024.0 * 1024.0);
+                    info.freeSpace = totalFreeBytes.QuadPart / (1024.0 * 1024.0 * 1024.0);
+                    info.usedSpace = info.totalSpace - info.freeSpace;
+
+                    // 获取磁盘读写速度（模拟数据）
+                    auto& speeds = diskSpeeds[driveLetter];
+
+                    // 模拟随机波动的读写速度
+                    speeds.first += (rand() % 100 - 50) / 10.0;
+                    speeds.second += (rand() % 100 - 50) / 10.0;
+
+                    info.readSpeed = std::max(0.0, speeds.first);
+                    info.writeSpeed = std::max(0.0, speeds.second);
+
+                    diskInfos.push_back(info);
+                }
+            }
+            drives >>= 1;
+            driveLetter++;
+        }
+    }
+
+private:
+    PDH_HQUERY cpuQuery = NULL;
+    PDH_HCOUNTER cpuCounter = NULL;
+    PDH_HCOUNTER coreCounter = NULL;
+    std::vector<PDH_FMT_COUNTERVALUE_ITEM_A> coreItems;
+    unsigned coreCount = 1;
+    CpuAccounting<> processCpu;
+    CpuAccounting<> threadCpu;
+    std::map<DWORD, std::pair<ULONG64, ULONG64>> lastNetworkBytes;
+    std::chrono::steady_clock::time_point lastNetworkTime = std::chrono::steady_clock::now();
+    std::map<char, std::pair<double, double>> diskSpeeds;
+
+    // FILETIME 的单位是 100ns
+    static uint64_t CpuNanoseconds(const FILETIME& kernelTime, const FILETIME& userTime) {
+        ULARGE_INTEGER kernel, user;
+        kernel.LowPart = kernelTime.dwLowDateTime;
+        kernel.HighPart = kernelTime.dwHighDateTime;
+        user.LowPart = userTime.dwLowDateTime;
+        user.HighPart = userTime.dwHighDateTime;
+        return (kernel.QuadPart + user.QuadPart) * 100;
+    }
+
+    static uint64_t MonotonicNanoseconds() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // 转换到 result 中，result 原有的容量足够时不会重新分配
+    void WideToUtf8(const wchar_t* str, std::string& result) {
+        int size = WideCharToMultiByte(CP_UTF8, 0, str, -1, nullptr, 0, nullptr, nullptr);
+        if (size <= 0) {
+            result.clear();
+            return;
+        }
+        result.resize(size);
+        WideCharToMultiByte(CP_UTF8, 0, str, -1, &result[0], size, nullptr, nullptr);
+        result.resize(size - 1);  // 去掉结尾的 '\0'
+    }
+};
@@ -0,0 +1,171 @@
+// 后台采样线程
+// 采样线程按照设定的刷新频率调用 SystemMonitor，结果通过三缓冲发布；
+// 渲染线程每帧只做一次原子操作取最新快照，不会被任何系统调用阻塞
+#pragma once
+#include "system_monitor.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 单写单读的无锁三缓冲
+// 写端在后缓冲区填好数据后与中间缓冲区交换，读端需要时再把中间缓冲区换到前台，
+// 双方都不会等待对方，读端持有的前缓冲区在下一次 Update() 之前保持不变
+template <typename T>
+class TripleBuffer {
+public:
+    // 写端：当前可写的缓冲区，里面是两次发布之前的旧数据，可以直接复用其内存
+    T& WriteBuffer() { return buffers[backIndex]; }
+
+    // 写端：发布写好的缓冲区
+    void Publish() {
+        uint8_t previous = middle.exchange((uint8_t)(backIndex | FRESH_BIT), std::memory_order_acq_rel);
+        backIndex = previous & INDEX_MASK;
+    }
+
+    // 读端：有新数据时切换到最新的缓冲区，返回是否发生了切换
+    bool Update() {
+        if ((middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0)
+            return false;
+        uint8_t previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    // 读端：当前的前缓冲区
+    const T& ReadBuffer() const { return buffers[frontIndex]; }
+
+private:
+    static const uint8_t FRESH_BIT = 0x4;
+    static const uint8_t INDEX_MASK = 0x3;
+
+    T buffers[3];
+    alignas(64) std::atomic<uint8_t> middle{1};
+    alignas(64) uint8_t backIndex = 0;   // 只被写端访问
+    alignas(64) uint8_t frontIndex = 2;  // 只被读端访问
+};
+
+// 一次完整采样的结果，发布后不再修改
+struct SystemSnapshot {
+    static const uint32_t NO_PROCESS = UINT32_MAX;
+
+    SystemInfo system;
+    std::vector<ProcessInfo> processes;
+    std::vector<NetworkInfo> networks;
+    std::vector<DiskInfo> disks;
+    uint32_t threadPid = NO_PROCESS;  // threads 所属的进程
+    std::vector<ThreadInfo> threads;
+    uint64_t sequence = 0;  // 0 表示还没有任何采样
+    std::chrono::steady_clock::time_point timestamp;
+};
+
+// 完成一次采样，填充 snapshot 中除 sequence 之外的所有字段，复用其中已分配的内存
+// threadPid 为需要采集线程列表的进程，NO_PROCESS 表示不采集
+inline void CollectSnapshot(SystemMonitor& monitor, SystemSnapshot& snapshot, uint32_t threadPid) {
+    monitor.GetSystemInfo(snapshot.system);
+    monitor.GetProcessList(snapshot.processes);
+    snapshot.threadPid = threadPid;
+    if (threadPid != SystemSnapshot::NO_PROCESS)
+        monitor.GetThreadList(threadPid, snapshot.threads);
+    else
+        snapshot.threads.clear();
+    monitor.GetNetworkInfo(snapshot.networks);
+    monitor.GetDiskInfo(snapshot.disks);
+    snapshot.timestamp = std::chrono::steady_clock::now();
+}
+
+class SystemSampler {
+public:
+    explicit SystemSampler(SystemMonitor& monitor) : monitor(monitor) {}
+
+    ~SystemSampler() {
+        Stop();
+    }
+
+    SystemSampler(const SystemSampler&) = delete;
+    SystemSampler& operator=(const SystemSampler&) = delete;
+
+    void Start(float intervalSeconds) {
+        if (running.load()) return;
+        SetInterval(intervalSeconds);
+        running.store(true);
+        worker = std::thread(&SystemSampler::Run, this);
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running.store(false);
+        }
+        wakeup.notify_one();
+        if (worker.joinable())
+            worker.join();
+    }
+
+    // 修改采样间隔（秒），立即生效，不会阻塞调用线程
+    void SetInterval(float seconds) {
+        if (seconds < 0.05f) seconds = 0.05f;
+        intervalMs.store((int64_t)(seconds * 1000.0f));
+        wakeup.notify_one();
+    }
+
+    // 每次发布新快照后在采样线程里调用，用来唤醒按需渲染的主循环（见 frame_scheduler.hpp）
+    // 必须在 Start() 之前设置；回调里不要做耗时的事
+    void SetPublishCallback(std::function<void()> callback) {
+        onPublish = std::move(callback);
+    }
+
+    // 指定需要采集线程列表的进程，NO_PROCESS 表示不采集
+    void SetThreadFocus(uint32_t pid) {
+        threadPid.store(pid);
+    }
+
+    // 渲染线程每帧调用一次：切换到最新快照，updated 返回本次是否拿到了新数据
+    // 返回的引用在下一次调用 Acquire() 之前一直有效；只允许一个线程调用
+    const SystemSnapshot& Acquire(bool* updated = nullptr) {
+        bool changed = snapshots.Update();
+        if (updated) *updated = changed;
+        return snapshots.ReadBuffer();
+    }
+
+private:
+    SystemMonitor& monitor;
+    TripleBuffer<SystemSnapshot> snapshots;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::atomic<bool> running{false};
+    std::atomic<int64_t> intervalMs{1000};
+    std::atomic<uint32_t> threadPid{SystemSnapshot::NO_PROCESS};
+    uint64_t sequence = 0;
+    std::function<void()> onPublish;
+
+    void Run() {
+        auto next = std::chrono::steady_clock::now();
+        while (running.load()) {
+            SystemSnapshot& snapshot = snapshots.WriteBuffer();
+            CollectSnapshot(monitor, snapshot, threadPid.load());
+            snapshot.sequence = ++sequence;
+            snapshots.Publish();
+            if (onPublish) onPublish();
+
+            // 按固定节奏采样；如果采样本身耗时超过间隔，就从现在开始重新计时
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                auto interval = std::chrono::milliseconds(intervalMs.load());
+                auto deadline = next + interval;
+                auto now = std::chrono::steady_clock::now();
+                if (!running.load() || now >= deadline) {
+                    next = (now - deadline > interval) ? now : deadline;
+                    break;
+                }
+                // SetInterval() 会唤醒这里，用新的间隔重新计算截止时间
+                wakeup.wait_until(lock, deadline);
+            }
+        }
+    }
+};
@@ -2,6 +2,9 @@
 #pragma once
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/mmap_file_sink.h>
+#include <spdlog/sinks/binary_file_sink.h>
+#include <spdlog/sinks/compressed_rotating_file_sink.h>
 #include <iostream>
 void spdlog_example(){
     spdlog::info("Welcome to spdlog!");
@@ -30,6 +33,13 @@ void spdlog_example(){
     try 
     {
         auto logger = spdlog::basic_logger_mt("basic_logger", "logs/basic-log.txt");
+        // 大量日志时用内存映射文件，绕过 stdio 缓冲
+        auto mmap_logger = spdlog::mmap_logger_mt("mmap_logger", "logs/mmap-log.txt");
+        // 只记录参数、不在调用线程格式化，用 app --decode-log logs/binary-log.bin 还原成文本
+        auto binary_logger = spdlog::binary_logger_mt("binary_logger", "logs/binary-log.bin");
+        SPDLOG_LOGGER_BINARY(binary_logger, spdlog::level::info, "Binary record with args: {} {:.2f} {}", 42, 3.14, "text");
+        // 每个文件 5MB，轮转后在后台线程压缩成 .lz4，最多保留 10 个、总共不超过 20MB
+        auto rotating_logger = spdlog::compressed_rotating_logger_mt("rotating_logger", "logs/rotating-log.txt", 5 * 1024 * 1024, 10, 20 * 1024 * 1024);
     }
     catch (const spdlog::spdlog_ex &ex)
     {
@@ -0,0 +1,191 @@
+// 多分辨率时间序列
+// 原始样本之外再维护 10 秒、1 分钟、1 小时三级降采样，每个桶保存 min/max/avg，
+// 每次写入只更新各级正在累积的桶，桶结束时追加到对应级别的环形序列中。
+// 绘图时按时间范围和像素宽度挑选合适的级别，显示一周数据的开销和显示 100 个点一样
+#pragma once
+#include "ring_series.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+struct SeriesBucket {
+    double time = 0.0;  // 桶的起始时间（Unix 时间，秒）；原始样本为采样时间
+    float min = 0.0f;
+    float max = 0.0f;
+    float avg = 0.0f;
+};
+
+enum class SeriesAggregate {
+    Min,
+    Max,
+    Avg
+};
+
+class TieredSeries {
+public:
+    static const int TIER_COUNT = 4;
+
+    // 各级桶的时长，第 0 级为原始样本
+    static double TierSeconds(int tier) {
+        static const double seconds[TIER_COUNT] = { 0.0, 10.0, 60.0, 3600.0 };
+        return seconds[tier];
+    }
+
+    // 默认保留：10 秒级 1 天，1 分钟级 1 周，1 小时级 90 天
+    explicit TieredSeries(size_t rawCapacity,
+                          size_t tenSecondCapacity = 8640,
+                          size_t minuteCapacity = 10080,
+                          size_t hourCapacity = 2160)
+        : raw(rawCapacity), tenSeconds(tenSecondCapacity), minutes(minuteCapacity), hours(hourCapacity) {}
+
+    TieredSeries(const TieredSeries&) = delete;
+    TieredSeries& operator=(const TieredSeries&) = delete;
+
+    // 写端：追加一个样本，time 需要单调不减
+    void Push(double time, float value) {
+        SeriesBucket sample;
+        sample.time = time;
+        sample.min = sample.max = sample.avg = value;
+        raw.Push(sample);
+
+        for (int i = 0; i < TIER_COUNT - 1; i++) {
+            Accumulator& acc = accumulators[i];
+            double seconds = TierSeconds(i + 1);
+            int64_t index = (int64_t)std::floor(time / seconds);
+            if (acc.count > 0 && index != acc.index) {
+                SeriesBucket bucket;
+                bucket.time = acc.index * seconds;
+                bucket.min = acc.min;
+                bucket.max = acc.max;
+                bucket.avg = (float)(acc.sum / acc.count);
+                MutableTier(i + 1).Push(bucket);
+                acc.count = 0;
+            }
+            if (acc.count == 0) {
+                acc.index = index;
+                acc.min = acc.max = value;
+                acc.sum = 0.0;
+            } else {
+                acc.min = std::min(acc.min, value);
+                acc.max = std::max(acc.max, value);
+            }
+            acc.sum += value;
+            acc.count++;
+        }
+    }
+
+    const RingSeries<SeriesBucket>& Tier(int tier) const {
+        switch (tier) {
+            case 0: return raw;
+            case 1: return tenSeconds;
+            case 2: return minutes;
+            default: return hours;
+        }
+    }
+
+    const RingSeries<SeriesBucket>& Raw() const { return raw; }
+
+    // 一段可以直接交给 ImGui::PlotLines 的序列
+    struct Selection {
+        RingSeries<SeriesBucket>::View view;
+        int tier = 0;
+        SeriesAggregate aggregate = SeriesAggregate::Avg;
+
+        // 供 ImGui::PlotLines/PlotHistogram 的 values_getter 使用，data 指向 Selection
+        static float Getter(void* data, int index) {
+            const Selection* self = (const Selection*)data;
+            SeriesBucket bucket = self->view[(size_t)index];
+            switch (self->aggregate) {
+                case SeriesAggregate::Min: return bucket.min;
+                case SeriesAggregate::Max: return bucket.max;
+                default: return bucket.avg;
+            }
+        }
+    };
+
+    // 读端：选出覆盖最近 rangeSeconds 秒、点数不超过 maxPoints 的最细级别
+    // 如果某一级的点数合适但保留的时间不够长，而更粗的级别保留得更久，就继续往粗的级别找。
+    // 挑选时读到的样本被写端覆盖了（见 RingSeries::View::Valid）就重新挑选。
+    // 返回的视图不复制数据：调用方需要在写端再写入 RingSeries::GUARD 个样本之前读完，
+    // 读完后可以用 selection.view.Valid() 检查
+    Selection Select(double rangeSeconds, size_t maxPoints, SeriesAggregate aggregate = SeriesAggregate::Avg) const {
+        Selection selection;
+        while (!TrySelect(rangeSeconds, maxPoints, aggregate, selection)) {}
+        return selection;
+    }
+
+private:
+    struct Accumulator {
+        int64_t index = 0;
+        float min = 0.0f;
+        float max = 0.0f;
+        double sum = 0.0;
+        uint32_t count = 0;
+    };
+
+    RingSeries<SeriesBucket> raw;
+    RingSeries<SeriesBucket> tenSeconds;
+    RingSeries<SeriesBucket> minutes;
+    RingSeries<SeriesBucket> hours;
+    Accumulator accumulators[TIER_COUNT - 1];
+
+    RingSeries<SeriesBucket>& MutableTier(int tier) {
+        switch (tier) {
+            case 0: return raw;
+            case 1: return tenSeconds;
+            case 2: return minutes;
+            default: return hours;
+        }
+    }
+
+    // Select 的一次尝试，挑选过程中读过的视图有任何一个失效时返回 false
+    bool TrySelect(double rangeSeconds, size_t maxPoints, SeriesAggregate aggregate, Selection& selection) const {
+        selection = Selection();
+        selection.aggregate = aggregate;
+
+        RingSeries<SeriesBucket>::View rawView = raw.GetView();
+        if (rawView.empty() || maxPoints == 0) {
+            selection.view = rawView;
+            return true;
+        }
+        double start = rawView.back().time - rangeSeconds;
+
+        RingSeries<SeriesBucket>::View views[TIER_COUNT];
+        size_t counts[TIER_COUNT];
+        double oldest[TIER_COUNT];
+        for (int i = 0; i < TIER_COUNT; i++) {
+            views[i] = (i == 0) ? rawView : Tier(i).GetView();
+            auto first = std::lower_bound(views[i].begin(), views[i].end(), start,
+                [](const SeriesBucket& bucket, double time) { return bucket.time < time; });
+            counts[i] = (size_t)(views[i].end() - first);
+            oldest[i] = views[i].empty() ? INFINITY : views[i][0].time;
+        }
+        for (int i = 0; i < TIER_COUNT; i++) {
+            if (!views[i].Valid()) return false;
+        }
+
+        int coarsest = 0;
+        for (int i = 0; i < TIER_COUNT; i++) {
+            if (counts[i] > 0) coarsest = i;
+        }
+
+        for (int i = 0; i <= coarsest; i++) {
+            if (counts[i] == 0 || counts[i] > maxPoints) continue;
+            bool longerElsewhere = false;
+            for (int j = i + 1; j <= coarsest; j++) {
+                if (oldest[j] < oldest[i]) longerElsewhere = true;
+            }
+            if (oldest[i] <= start || !longerElsewhere) {
+                selection.view = views[i].Last(counts[i]);
+                selection.tier = i;
+                return true;
+            }
+        }
+
+        // 范围超过了最粗一级能在 maxPoints 内表示的长度，只显示最近的部分
+        selection.view = views[coarsest].Last(std::min(counts[coarsest], maxPoints));
+        selection.tier = coarsest;
+        return true;
+    }
+};